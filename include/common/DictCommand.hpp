@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace lynx {
 	constexpr const char* const QUIT_COMMAND      = "QUIT";
 	constexpr const char* const INSERT_COMMAND    = "INSERT";
@@ -31,4 +33,27 @@ namespace lynx {
 	constexpr const char* const DELETE_COMMAND    = "DELETE";
 	constexpr const char* const GET_BY_ID_COMMAND = "GET_BY_ID";
 	constexpr const char* const GET_ALL_COMMAND   = "GET_ALL";
+	constexpr const char* const PING_COMMAND      = "PING";
+
+	/* Available only with binary frames, reply is split into chunks (DictFrame.hpp) */
+	constexpr const char* const GET_ALL_STREAM_COMMAND = "GET_ALL_STREAM";
+
+	/* Switches connection from line protocol to binary frames (DictFrame.hpp) */
+	constexpr const char* const PROTOCOL_V2_COMMAND = "PROTOCOL_V2";
+
+	enum class DictProtocol : uint8_t {
+		TEXT = 1,
+		BINARY = 2
+	};
+
+	enum class DictOpcode : uint8_t {
+		QUIT = 1,
+		INSERT = 2,
+		UPDATE = 3,
+		DELETE = 4,
+		GET_BY_ID = 5,
+		GET_ALL = 6,
+		PING = 7,
+		GET_ALL_STREAM = 8
+	};
 }
@@ -0,0 +1,68 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	enum class ReactorMode : uint8_t {
+		SHARED = 1,  /* one io_context run by all threads */
+		SHARDED = 2  /* own io_context per thread, nothing is handed over between threads */
+	};
+
+	struct ReactorOptions final {
+		uint32_t threadCount = std::thread::hardware_concurrency();
+		ReactorMode mode = ReactorMode::SHARED;
+		bool pinThreads = false;
+	};
+
+	class ReactorPool final {
+	public:
+		explicit ReactorPool(const ReactorOptions& options);
+		~ReactorPool();
+
+		[[nodiscard]] auto getOptions() const -> const ReactorOptions&;
+		[[nodiscard]] auto getContextCount() const -> uint32_t;
+		[[nodiscard]] auto getContext(uint32_t index) -> net::io_context&;
+
+		/* Runs contexts on pool threads and calling thread until stop() */
+		void run();
+		void stop();
+
+	private:
+		void runContext(uint32_t threadIndex);
+
+		ReactorOptions mOptions;
+		std::vector<std::unique_ptr<net::io_context>> mContexts;
+		std::vector<std::thread> mThreads;
+	};
+}
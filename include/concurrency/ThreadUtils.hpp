@@ -37,5 +37,7 @@ namespace lynx {
 
 	boost::system::result<int> getPriority();
 
+	boost::system::result<void> setAffinity(uint32_t cpu);
+
 	boost::system::result<void> raiseSignal(std::thread::native_handle_type threadId, int signalNumber);
 }
@@ -48,9 +48,16 @@ namespace lynx {
 		auto insert(const Word& word) -> boost::system::result<void>;
 		auto update(const Word& word) -> boost::system::result<void>;
 		auto remove(uint64_t id) -> boost::system::result<void>;
+		/* Whole batch is one transaction of two statements prepared once, ids given to inserted words come in their order */
+		auto insert(const std::vector<Word>& words) -> boost::system::result<std::vector<uint64_t>>;
+		/* Whole batch is one transaction, every statement updates many rows joined with derived table of batch */
+		auto update(const std::vector<Word>& words) -> boost::system::result<void>;
 
 		auto getById(uint64_t id) -> boost::system::result<Word>;
 		auto getAll() -> boost::system::result<std::vector<Word>>;
+		/* Keyset page ordered by id, next page starts after id of last returned word and empty page means end,
+		 * row which fails to load fails whole page, so skipped row can't end walk early */
+		auto getPage(uint64_t afterId, std::size_t limit) -> boost::system::result<std::vector<Word>>;
 
 		[[nodiscard]] auto getLastWordId() const -> uint64_t;
 		[[nodiscard]] auto getLastWordImageId() const -> uint64_t;
@@ -60,10 +67,16 @@ namespace lynx {
 	private:
 		void createTables();
 		auto load(const db::row& row) -> boost::system::result<Word, std::string>;
+		/* Statement text depends on row count, so it is closed after use instead of piling up on server */
+		auto executeBatch(const std::string& query, const std::vector<db::field_view>& parameters, db::results& result)
+			-> boost::system::error_code;
+		void rollback();
 
 		std::string mHost;
 		net::io_context mContext;
 		std::unique_ptr<db::tcp_ssl_connection> mConnection;
+		/* page is read many times in a row, so its statement is prepared once per connection */
+		db::statement mPageStatement;
 
 		uint64_t mLastWordId;
 		uint64_t mLastWordImageId;
@@ -31,6 +31,7 @@
 
 #include "common/Config.hpp"
 #include "common/Word.hpp"
+#include "common/WordStatus.hpp"
 
 namespace lynx {
 
@@ -44,6 +45,11 @@ namespace lynx {
 
 	    auto serializeWordsToText(const std::vector<Word>& words) -> boost::system::result<std::string>;
 	    auto deserializeWordsFromText(const std::string& input) -> boost::system::result<std::vector<Word>>;
+	    /* Every element of array is converted on its own, so one malformed word fails only its own item */
+	    auto deserializeWordBatchFromText(const std::string& input) -> boost::system::result<std::vector<boost::system::result<Word>>>;
+
+	    auto serializeStatusesToText(const std::vector<WordStatus>& statuses) -> boost::system::result<std::string>;
+	    auto deserializeStatusesFromText(const std::string& input) -> boost::system::result<std::vector<WordStatus>>;
 
 	    auto serializeToFile(const std::string& fileName, const Word& word) -> boost::system::result<void>;
 		auto deserializeFromFile(const std::string& fileName) -> boost::system::result<Word>;
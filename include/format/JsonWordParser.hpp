@@ -0,0 +1,123 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/json/basic_parser.hpp>
+#include <boost/system/result.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/Config.hpp"
+#include "common/Word.hpp"
+
+namespace lynx {
+
+	/* Tuple form of template reflection has no keys, so such bodies are read whole by JsonParser */
+	constexpr bool JSON_WORD_STREAMING = !LYNX_USE_TEMPLATE_REFLECTION;
+
+	/* Callbacks of boost::json::basic_parser which fill words directly, nothing of document is kept as json value */
+	class JsonWordHandler final {
+	public:
+		static constexpr std::size_t max_object_size = std::size_t(-1);
+		static constexpr std::size_t max_array_size = std::size_t(-1);
+		static constexpr std::size_t max_key_size = std::size_t(-1);
+		static constexpr std::size_t max_string_size = std::size_t(-1);
+
+		bool on_document_begin(boost::system::error_code& errorCode);
+		bool on_document_end(boost::system::error_code& errorCode);
+		bool on_object_begin(boost::system::error_code& errorCode);
+		bool on_object_end(std::size_t size, boost::system::error_code& errorCode);
+		bool on_array_begin(boost::system::error_code& errorCode);
+		bool on_array_end(std::size_t size, boost::system::error_code& errorCode);
+		bool on_key_part(boost::json::string_view part, std::size_t size, boost::system::error_code& errorCode);
+		bool on_key(boost::json::string_view part, std::size_t size, boost::system::error_code& errorCode);
+		bool on_string_part(boost::json::string_view part, std::size_t size, boost::system::error_code& errorCode);
+		bool on_string(boost::json::string_view part, std::size_t size, boost::system::error_code& errorCode);
+		bool on_number_part(boost::json::string_view part, boost::system::error_code& errorCode);
+		bool on_int64(int64_t value, boost::json::string_view text, boost::system::error_code& errorCode);
+		bool on_uint64(uint64_t value, boost::json::string_view text, boost::system::error_code& errorCode);
+		bool on_double(double value, boost::json::string_view text, boost::system::error_code& errorCode);
+		bool on_bool(bool value, boost::system::error_code& errorCode);
+		bool on_null(boost::system::error_code& errorCode);
+		bool on_comment_part(boost::json::string_view part, boost::system::error_code& errorCode);
+		bool on_comment(boost::json::string_view part, boost::system::error_code& errorCode);
+
+		[[nodiscard]] bool isBatch() const;
+		auto releaseWords() -> std::vector<boost::system::result<Word>>;
+
+	private:
+		enum class Field {
+			NONE, UNKNOWN,
+			ID, NAME, INDEX, TYPE, IMAGE,
+			IMAGE_ID, URL, WIDTH, HEIGHT
+		};
+
+		void startWord();
+		void finishWord();
+		void failField();
+		void assignInteger(int64_t value);
+		void assignUnsigned(uint64_t value);
+		/* Value which isn't object in root array is its own failed item */
+		[[nodiscard]] bool isBatchElement() const;
+		[[nodiscard]] bool isRootValue() const;
+
+	private:
+		std::vector<boost::system::result<Word>> mWords;
+		Word mWord{};
+		std::string mKey;
+		std::string mUrl;
+
+		Field mField = Field::NONE;
+		uint32_t mFoundFields = 0;
+		uint32_t mDepth = 0;
+		uint32_t mSkipDepth = 0;
+		bool mBatch = false;
+		bool mInImage = false;
+		bool mWordFailed = false;
+	};
+
+	/*
+	 * Builds words while json text arrives in pieces, so request body is neither kept as string
+	 * nor converted to json DOM. Reads object form written by customised and macro reflection
+	 * serializers, root is one word or array of words.
+	 */
+	class JsonWordParser final {
+	public:
+		JsonWordParser();
+		~JsonWordParser();
+
+		/* More text follows, so piece may end in the middle of any token */
+		auto write(std::string_view input) -> boost::system::error_code;
+		auto finish() -> boost::system::error_code;
+
+		[[nodiscard]] bool isBatch() const;
+		auto releaseWords() -> std::vector<boost::system::result<Word>>;
+
+	private:
+		boost::json::basic_parser<JsonWordHandler> mParser;
+	};
+}
@@ -24,11 +24,14 @@
 
 #pragma once
 
+#include <span>
 #include <vector>
 #include <boost/system/result.hpp>
 
 #include "common/Word.hpp"
+#include "common/WordStatus.hpp"
 #include "proto/RemoteWord.pb.h"
+#include "proto/RemoteDictService.pb.h"
 
 namespace lynx {
 
@@ -44,7 +47,16 @@ namespace lynx {
 	    auto deserializeFromText(const std::string& text) -> boost::system::result<Word>;
 
 	    auto serializeToBuffer(const Word& word) -> boost::system::result<std::vector<std::byte>>;
-	    auto deserializeFromBuffer(const std::vector<std::byte>& buffer) -> boost::system::result<Word>;
+	    auto deserializeFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<Word>;
+
+	    auto serializeWordsToBuffer(const std::vector<Word>& words) -> boost::system::result<std::vector<std::byte>>;
+	    auto deserializeWordsFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<std::vector<Word>>;
+
+	    auto serializeStatusesToBuffer(const std::vector<WordStatus>& statuses) -> boost::system::result<std::vector<std::byte>>;
+	    auto deserializeStatusesFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<std::vector<WordStatus>>;
+
+	    auto serializeIdToBuffer(uint64_t id) -> boost::system::result<std::vector<std::byte>>;
+	    auto deserializeIdFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<uint64_t>;
         
 	    auto convert(const Word& word) -> pb::RemoteWord;
 	    auto convert(const pb::RemoteWord& word) -> Word;
@@ -27,6 +27,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/system/result.hpp>
 
+#include <string_view>
 #include <vector>
 
 #include "common/Word.hpp"
@@ -41,10 +42,10 @@ namespace lynx {
 		~XmlParser() = default;
 
 		auto serializeToText(const Word& word) -> boost::system::result<std::string>;
-		auto deserializeFromText(const std::string& text) -> boost::system::result<Word>;
+		auto deserializeFromText(std::string_view text) -> boost::system::result<Word>;
 
 		auto serializeWordsToText(const std::vector<Word>& words) -> boost::system::result<std::string>;
-		auto deserializeWordsFromText(const std::string& text) -> boost::system::result<std::vector<Word>>;
+		auto deserializeWordsFromText(std::string_view text) -> boost::system::result<std::vector<Word>>;
 
 		auto serializeToFile(const std::string& fileName, const Word& word) -> boost::system::result<void>;
 		auto deserializeFromFile(const std::string& fileName) -> boost::system::result<Word>;
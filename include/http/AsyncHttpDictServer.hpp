@@ -0,0 +1,93 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "concurrency/ReactorPool.hpp"
+#include "db/SyncDictDao.hpp"
+#include "http/HttpDictDumper.hpp"
+#include "http/HttpDictRequestHandler.hpp"
+#include "net/SessionLimits.hpp"
+
+namespace beast = boost::beast;
+namespace net = boost::asio;
+namespace http = beast::http;
+
+namespace lynx {
+
+	/*
+	 * Http server whose sessions are coroutines on strands of fixed reactor pool, so idle
+	 * keep-alive connection costs a socket and a buffer instead of a thread.
+	 */
+	class AsyncHttpDictServer final {
+	public:
+		AsyncHttpDictServer(const std::string& host, uint16_t port, const ReactorOptions& options = {},
+							const SessionLimits& limits = {}, const CompressionOptions& compression = {}, const DumpOptions& dump = {});
+		~AsyncHttpDictServer();
+
+		[[nodiscard]] bool isStarted() const;
+
+		void start();
+		void stop();
+
+	private:
+		auto openAcceptor(net::ip::tcp::acceptor& acceptor) -> boost::system::error_code;
+		auto acceptClients(net::ip::tcp::acceptor& acceptor) -> net::awaitable<void>;
+		auto processSession(net::ip::tcp::socket socket) -> net::awaitable<void>;
+		/* Route is matched once on header, so body type and handler are chosen by same table */
+		auto routeRequest(http::request<JsonWordBody>&& request, const HttpRouteMatch& match)
+			-> std::unique_ptr<http::message_generator>;
+		auto routeRequest(http::request<http::string_body>&& request, const HttpRouteMatch& match)
+			-> std::unique_ptr<http::message_generator>;
+		auto streamWords(beast::tcp_stream& stream, const http::request<http::string_body>& request)
+			-> net::awaitable<boost::system::error_code>;
+		/* Socket is waited for writability between sendfile calls, so reactor thread never blocks on slow peer */
+		auto sendDump(beast::tcp_stream& stream, const http::request<http::string_body>& request)
+			-> net::awaitable<boost::system::error_code>;
+
+	private:
+		uint16_t mPort;
+		SessionLimits mLimits;
+
+		ReactorPool mReactors;
+		/* stop may come while start still opens acceptors, so both hold this mutex */
+		std::mutex mAcceptorsMutex;
+		std::vector<net::ip::tcp::acceptor> mAcceptors;
+
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		HttpDictRequestHandler mHandler;
+		HttpDictDumper mDumper;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,74 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/system/result.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace lynx {
+
+	enum class ContentCoding {
+		IDENTITY,
+		GZIP,
+		DEFLATE /* zlib stream of RFC 1950, which is what http calls deflate */
+	};
+
+	/* Small bodies grow by coding header and cost more cpu than they save, so they stay raw */
+	struct CompressionOptions final {
+		bool enabled = true;
+		std::size_t minSize = 1024; /* body of known size below it goes out raw */
+		int level = 6;              /* zlib level from 1 (fastest) to 9 (smallest) */
+	};
+
+	/* Picks coding of Accept-Encoding with highest q-value, gzip wins a tie and q=0 forbids coding */
+	auto negotiateCoding(std::string_view acceptEncoding) -> ContentCoding;
+	auto parseCoding(std::string_view contentEncoding) -> ContentCoding;
+	auto toString(ContentCoding coding) -> const char*;
+
+	auto compress(std::string_view input, ContentCoding coding, int level) -> boost::system::result<std::string>;
+	/* Output above maxSize fails with message_size, so small compressed body can't expand without end */
+	auto decompress(std::string_view input, ContentCoding coding, std::size_t maxSize) -> boost::system::result<std::string>;
+
+	/*
+	 * Compresses body which is produced piece by piece. Zlib keeps window and buffer of its own,
+	 * so output of one piece may be empty and rest of it comes with next pieces or with finish.
+	 */
+	class HttpCompressor final {
+	public:
+		HttpCompressor(ContentCoding coding, int level);
+		~HttpCompressor() = default;
+
+		auto compress(std::string_view input) -> std::string;
+		auto finish() -> std::string;
+
+	private:
+		std::string mOutput;
+		boost::iostreams::filtering_ostream mStream;
+	};
+}
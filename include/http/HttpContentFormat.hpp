@@ -0,0 +1,47 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace lynx {
+
+	/* Media type of word bodies, browsers keep json and internal services ask for compact protobuf */
+	enum class ContentFormat {
+		JSON,
+		PROTOBUF
+	};
+
+	/* Protobuf is sent only when Accept names it with q-value not below json, wildcards mean json */
+	auto negotiateFormat(std::string_view accept) -> ContentFormat;
+	/* Media type which is neither json nor protobuf gives no format, so reader decides whether to reject body */
+	auto parseFormat(std::string_view contentType) -> std::optional<ContentFormat>;
+	auto toMime(ContentFormat format) -> const char*;
+
+	/* q-value of Accept or Accept-Encoding element is kept in thousandths, so "0.5" is 500 and missing one is 1000 */
+	auto parseQuality(std::string_view parameters) -> uint32_t;
+}
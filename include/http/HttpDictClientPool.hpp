@@ -0,0 +1,112 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "http/SyncHttpDictClient.hpp"
+
+namespace lynx {
+
+	struct HttpDictClientPoolOptions final {
+		uint32_t clientCount = std::thread::hardware_concurrency();
+		uint32_t pipelineDepth = 16; /* requests in flight on one connection, 1 turns pipelining off */
+		ContentFormat format = ContentFormat::JSON; /* body format of every client */
+	};
+
+	/*
+	 * Keeps keep-alive SyncHttpDictClient connections and hands each of them to one caller
+	 * at a time, like DictClientPool does for dictionary protocol. Connection closed by server
+	 * while idle is reconnected before it is leased, so callers don't pay for connect per call.
+	 */
+	class HttpDictClientPool final {
+	public:
+		class Lease final {
+		public:
+			Lease(Lease&& other) noexcept;
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+			~Lease();
+
+			auto operator*() -> SyncHttpDictClient&;
+			auto operator->() -> SyncHttpDictClient*;
+
+		private:
+			friend class HttpDictClientPool;
+			Lease(HttpDictClientPool& pool, uint32_t index);
+
+			HttpDictClientPool* mPool;
+			uint32_t mIndex;
+		};
+
+	public:
+		HttpDictClientPool(const std::string& host, uint16_t port, const HttpDictClientPoolOptions& options = {});
+		~HttpDictClientPool();
+
+		[[nodiscard]] bool isStarted() const;
+
+		/* Both skip slots which are leased at the moment, client of such slot is connected by its lease */
+		void start();
+		/* Client leased during stop isn't stopped, it is closed when pool is destroyed */
+		void stop();
+
+		/* Blocks while all clients are leased, before start client of leased slot is connected on demand */
+		[[nodiscard]] auto acquire() -> Lease;
+
+		void performPost(const Word& word);
+		void performPut(const Word& word);
+		void performDelete(uint64_t id);
+		[[nodiscard]] auto performPost(const std::vector<Word>& words) -> std::vector<WordStatus>;
+		[[nodiscard]] auto performPut(const std::vector<Word>& words) -> std::vector<WordStatus>;
+
+		[[nodiscard]] auto performGet(uint64_t id) -> Word;
+		[[nodiscard]] auto performGet() -> std::vector<Word>;
+		/* Ids are sent in pipelined batches of pipeline depth over one leased connection */
+		[[nodiscard]] auto performGet(const std::vector<uint64_t>& ids) -> std::vector<Word>;
+
+	private:
+		struct Slot {
+			std::unique_ptr<SyncHttpDictClient> client;
+			std::atomic_flag leased;
+		};
+
+		void prepareClient(Slot& slot);
+		void reconnectClient(Slot& slot);
+		void release(uint32_t index);
+
+	private:
+		std::string mHost;
+		uint16_t mPort;
+		HttpDictClientPoolOptions mOptions;
+
+		std::unique_ptr<Slot[]> mSlots;
+		std::atomic_uint32_t mNextIndex;
+		std::atomic_uint32_t mReleaseCount;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,99 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/system/result.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "db/SyncDictDao.hpp"
+#include "format/JsonParser.hpp"
+#include "format/ProtobufParser.hpp"
+#include "http/HttpContentFormat.hpp"
+
+namespace lynx {
+
+	/* Json dump has one word object per line, protobuf dump has varint length before every RemoteWord */
+	struct DumpOptions final {
+		std::string path;                                            /* empty path turns dump off */
+		std::chrono::seconds interval = std::chrono::minutes(10);    /* pause between two dumps */
+		std::size_t pageSize = 1024;                                 /* words read under one dao lock */
+		ContentFormat format = ContentFormat::JSON;
+	};
+
+	/* Part of dump answered to Range header, whole file when header is absent, malformed or has several ranges */
+	struct ByteRange final {
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		bool partial = false;
+		bool satisfiable = true;
+	};
+
+	auto parseByteRange(std::string_view range, uint64_t fileSize) -> ByteRange;
+
+	/*
+	 * Writes whole dictionary to file in background, so bulk export is served from disk and
+	 * neither dao nor parser is touched by download. New dump is written next to old one and
+	 * renamed over it, so opened file always has one complete dump.
+	 */
+	class HttpDictDumper final {
+	public:
+		HttpDictDumper(SyncDictDao& dictDao, std::mutex& dictDaoMutex, const DumpOptions& options);
+		~HttpDictDumper();
+
+		[[nodiscard]] bool isStarted() const;
+
+		void start();
+		void stop();
+
+		/* Returns count of dumped words, dao is locked for one page only */
+		auto writeDump() -> boost::system::result<std::size_t>;
+
+	private:
+		void runDumps();
+		auto writeWords(std::ofstream& stream, const std::vector<Word>& words) -> boost::system::result<void>;
+
+	private:
+		SyncDictDao& mDictDao;
+		std::mutex& mDictDaoMutex;
+		DumpOptions mOptions;
+
+		JsonParser mParser;
+		ProtobufParser mProtobufParser;
+
+		std::thread mThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,145 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/beast/http.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "db/SyncDictDao.hpp"
+#include "format/JsonParser.hpp"
+#include "format/ProtobufParser.hpp"
+#include "http/HttpCompression.hpp"
+#include "http/HttpContentFormat.hpp"
+#include "http/HttpDictDumper.hpp"
+#include "http/HttpRouteTable.hpp"
+#include "http/JsonWordBody.hpp"
+#include "util/LruCache.hpp"
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+
+namespace lynx {
+
+	static constexpr std::size_t WORD_CACHE_CAPACITY = 4096;
+	static constexpr std::size_t WORD_PAGE_LIMIT = 100;
+	static constexpr std::size_t WORD_PAGE_MAX_LIMIT = 1000;
+	static constexpr std::size_t WORD_STREAM_PAGE_SIZE = 256;
+
+	/* Serialized body of one word and strong etag computed from its bytes */
+	struct CachedWord final {
+		std::string body;
+		std::string etag;
+		ContentFormat format = ContentFormat::JSON;
+	};
+
+	/* Cursor of chunked get all response, every piece read by it continues one json array */
+	struct WordStreamCursor final {
+		uint64_t afterId = 0;
+		bool started = false;
+		bool finished = false;
+		ContentFormat format = ContentFormat::JSON;
+		std::unique_ptr<HttpCompressor> compressor;
+	};
+
+	/* Opened dump with its header, body part from offset is sent by sendfile after header */
+	struct DumpFile final {
+		http::response<http::file_body> response;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+	};
+
+	/*
+	 * Builds responses of dictionary routes, so sync and async http servers share them. Parser keeps
+	 * no state, dao is locked for every call and word cache has its own lock, so one handler serves
+	 * all sessions of a server.
+	 */
+	class HttpDictRequestHandler final {
+	public:
+		HttpDictRequestHandler(SyncDictDao& dictDao, std::mutex& dictDaoMutex, const CompressionOptions& compression = {},
+							   const DumpOptions& dump = {}, std::size_t wordCacheCapacity = WORD_CACHE_CAPACITY);
+		~HttpDictRequestHandler() = default;
+
+		auto handlePostRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator>;
+		auto handlePutRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator>;
+		/* Batch body is json array of words, reply lists status of every word in its order */
+		auto handlePostBatchRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator>;
+		auto handlePutBatchRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator>;
+		/* Word id is parsed by route table, so handler gets it as number */
+		auto handleDeleteRequest(http::request<http::string_body>&& request, uint64_t wordId) -> std::unique_ptr<http::message_generator>;
+		auto handleGetByIdRequest(http::request<http::string_body>&& request, uint64_t wordId) -> std::unique_ptr<http::message_generator>;
+		/* Serves /get?after=<id>&limit=<n>, Link header points to next page while page is full */
+		auto handleGetPageRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
+
+		/* Next piece of whole dictionary, dao is locked for one page only, so streaming doesn't stall other sessions */
+		auto readWordStream(WordStreamCursor& cursor) -> boost::system::result<std::string>;
+		/* Whole stream is compressed when client accepts it, size of stream isn't known to apply threshold */
+		auto prepareStreamResponse(const http::request<http::string_body>& request, WordStreamCursor& cursor)
+			-> http::response<http::buffer_body>;
+		/* Returns null when dump is opened for range of request, reply of missing dump or unsatisfiable range otherwise */
+		auto handleDumpRequest(const http::request<http::string_body>& request, DumpFile& dump)
+			-> std::unique_ptr<http::message_generator>;
+
+		auto prepareResponse(const std::string& body, http::status status, uint32_t version, bool keepAlive,
+							 ContentFormat contentFormat = ContentFormat::JSON) -> http::response<http::string_body>;
+		/* Body which streaming parser can't read, protobuf or json tuple form, is parsed at once into words of same request */
+		auto decodeWordRequest(http::request<http::string_body>&& request, bool batch) -> http::request<JsonWordBody>;
+
+	private:
+		[[nodiscard]] bool checkTarget(boost::core::string_view target) const;
+		/* Applies valid words in one dao call, which returns id of every applied word */
+		auto handleBatchRequest(http::request<JsonWordBody>&& request, const char* operation,
+								const std::function<boost::system::result<std::vector<uint64_t>>(const std::vector<Word>&)>& applyWords)
+			-> std::unique_ptr<http::message_generator>;
+		/* Single word route accepts only body with one valid word object */
+		auto takeRequestWord(JsonWordBody::value_type& body) -> boost::system::result<Word>;
+		auto prepareCachedResponse(const CachedWord& word, const http::request<http::string_body>& request)
+			-> http::response<http::string_body>;
+		void invalidateWord(uint64_t wordId);
+		/* Each format has own cache, so etag always names one representation of word */
+		auto wordCache(ContentFormat contentFormat) -> LruCache<uint64_t, std::shared_ptr<const CachedWord>>&;
+		auto serializeWord(const Word& word, ContentFormat contentFormat) -> boost::system::result<std::string>;
+		void compressResponse(http::response<http::string_body>& response, const http::request<http::string_body>& request);
+		/* Appends words joined by comma without brackets, so pages can be concatenated, and moves afterId to last word */
+		auto loadWordPage(uint64_t& afterId, std::size_t limit, ContentFormat contentFormat, std::string& body)
+			-> boost::system::result<std::size_t>;
+
+	private:
+		SyncDictDao& mDictDao;
+		std::mutex& mDictDaoMutex;
+
+		JsonParser mParser;
+		ProtobufParser mProtobufParser;
+		CompressionOptions mCompression;
+		DumpOptions mDump;
+
+		/* Dao mutex is held while filling and invalidating, so stale body can't be stored after update */
+		LruCache<uint64_t, std::shared_ptr<const CachedWord>> mWordCache;
+		LruCache<uint64_t, std::shared_ptr<const CachedWord>> mProtobufWordCache;
+		std::mutex mWordCacheMutex;
+	};
+}
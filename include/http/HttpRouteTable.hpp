@@ -0,0 +1,121 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/beast/http/verb.hpp>
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+
+namespace http = boost::beast::http;
+
+namespace lynx {
+
+	enum class HttpRoute : uint8_t {
+		UNKNOWN,
+		POST_WORD,
+		PUT_WORD,
+		POST_WORDS,
+		PUT_WORDS,
+		DELETE_WORD,
+		GET_WORD,
+		GET_PAGE,
+		GET_ALL,
+		GET_DUMP
+	};
+
+	/* Numeric last segment of target is written as {id}, target with query ends with ? */
+	struct HttpRouteEntry final {
+		http::verb method;
+		std::string_view pattern;
+		HttpRoute route;
+	};
+
+	struct HttpRouteMatch final {
+		HttpRoute route = HttpRoute::UNKNOWN;
+		uint64_t wordId = 0;
+	};
+
+	inline constexpr std::array HTTP_ROUTES = {
+		HttpRouteEntry{ http::verb::post, "/post", HttpRoute::POST_WORD },
+		HttpRouteEntry{ http::verb::put, "/put", HttpRoute::PUT_WORD },
+		HttpRouteEntry{ http::verb::post, "/post/batch", HttpRoute::POST_WORDS },
+		HttpRouteEntry{ http::verb::put, "/put/batch", HttpRoute::PUT_WORDS },
+		HttpRouteEntry{ http::verb::delete_, "/delete/{id}", HttpRoute::DELETE_WORD },
+		HttpRouteEntry{ http::verb::get, "/get/{id}", HttpRoute::GET_WORD },
+		HttpRouteEntry{ http::verb::get, "/get?", HttpRoute::GET_PAGE },
+		HttpRouteEntry{ http::verb::get, "/get", HttpRoute::GET_ALL },
+		HttpRouteEntry{ http::verb::get, "/dump", HttpRoute::GET_DUMP }
+	};
+
+	inline constexpr std::size_t HTTP_ROUTE_BUCKET_COUNT = 32;
+	inline constexpr uint8_t HTTP_ROUTE_EMPTY_BUCKET = 0xFF;
+
+	/* FNV-1a of method and pattern parts, parts are hashed as one string */
+	constexpr auto hashRoute(http::verb method, std::initializer_list<std::string_view> parts) -> uint32_t {
+		uint32_t hash = 2166136261u;
+
+		hash = (hash ^ static_cast<uint32_t>(method)) * 16777619u;
+
+		for (std::string_view part : parts) {
+			for (char symbol : part) {
+				hash = (hash ^ static_cast<uint8_t>(symbol)) * 16777619u;
+			}
+		}
+
+		return hash;
+	}
+
+	/* Every route owns its bucket, collision stops compilation, so lookup checks exactly one entry */
+	constexpr auto makeRouteBuckets() -> std::array<uint8_t, HTTP_ROUTE_BUCKET_COUNT> {
+		std::array<uint8_t, HTTP_ROUTE_BUCKET_COUNT> buckets{};
+		buckets.fill(HTTP_ROUTE_EMPTY_BUCKET);
+
+		for (std::size_t i = 0; i < HTTP_ROUTES.size(); ++i) {
+			const uint32_t bucket = hashRoute(HTTP_ROUTES[i].method, { HTTP_ROUTES[i].pattern }) % HTTP_ROUTE_BUCKET_COUNT;
+
+			if (buckets[bucket] != HTTP_ROUTE_EMPTY_BUCKET) {
+				throw std::logic_error("Routes collide in one bucket, change HTTP_ROUTE_BUCKET_COUNT");
+			}
+
+			buckets[bucket] = static_cast<uint8_t>(i);
+		}
+
+		return buckets;
+	}
+
+	inline constexpr std::array<uint8_t, HTTP_ROUTE_BUCKET_COUNT> HTTP_ROUTE_BUCKETS = makeRouteBuckets();
+
+	constexpr bool isWordRoute(HttpRoute route) {
+		return route == HttpRoute::POST_WORD || route == HttpRoute::PUT_WORD ||
+			   route == HttpRoute::POST_WORDS || route == HttpRoute::PUT_WORDS;
+	}
+
+	/* Query of route without ? pattern is ignored, so /get/{id}?x matches word by id */
+	auto matchRoute(http::verb method, std::string_view target) -> HttpRouteMatch;
+}
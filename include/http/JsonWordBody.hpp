@@ -0,0 +1,95 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+
+#include <vector>
+
+#include "format/JsonWordParser.hpp"
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+
+namespace lynx {
+
+	/*
+	 * Request body which keeps only parsed words: every buffer read from socket goes straight to
+	 * streaming json parser, so neither body string nor json DOM is built. Json error doesn't fail
+	 * http parser, rest of body is discarded to keep connection framing and handler replies 400.
+	 */
+	struct JsonWordBody final {
+		struct value_type final {
+			std::vector<boost::system::result<Word>> words;
+			bool batch = false;
+			boost::system::error_code error;
+		};
+
+		class reader final {
+		public:
+			template<bool isRequest, class Fields>
+			reader(http::header<isRequest, Fields>&, value_type& body)
+				: mBody(body) {}
+
+			void init(const boost::optional<std::uint64_t>&, boost::system::error_code& errorCode) {
+				mBody = value_type{};
+				errorCode = {};
+			}
+
+			template<class ConstBufferSequence>
+			auto put(const ConstBufferSequence& buffers, boost::system::error_code& errorCode) -> std::size_t {
+				std::size_t size = 0;
+				errorCode = {};
+
+				for (const auto buffer : beast::buffers_range_ref(buffers)) {
+					size += buffer.size();
+
+					if (!mBody.error) {
+						mBody.error = mParser.write(std::string_view(static_cast<const char*>(buffer.data()), buffer.size()));
+					}
+				}
+
+				return size;
+			}
+
+			void finish(boost::system::error_code& errorCode) {
+				errorCode = {};
+
+				if (!mBody.error) {
+					mBody.error = mParser.finish();
+				}
+
+				mBody.batch = mParser.isBatch();
+				mBody.words = mParser.releaseWords();
+			}
+
+		private:
+			value_type& mBody;
+			JsonWordParser mParser;
+		};
+	};
+}
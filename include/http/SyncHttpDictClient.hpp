@@ -24,11 +24,14 @@
 
 #pragma once
 
+#include <boost/asio/generic/stream_protocol.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 
 #include "format/JsonParser.hpp"
+#include "format/ProtobufParser.hpp"
+#include "http/HttpContentFormat.hpp"
 
 namespace beast = boost::beast;
 namespace net = boost::asio;
@@ -36,9 +39,12 @@ namespace http = beast::http;
 
 namespace lynx {
 
+	/* One keep-alive connection, it isn't thread safe, so concurrent callers share HttpDictClientPool */
 	class SyncHttpDictClient final {
 	public:
 		SyncHttpDictClient(const std::string& host, uint16_t port);
+		/* Connects to server on same host over unix domain socket */
+		explicit SyncHttpDictClient(const std::string& socketPath);
 		~SyncHttpDictClient();
 
 		[[nodiscard]] bool isStarted() const;
@@ -46,25 +52,58 @@ namespace lynx {
 		void start();
 		void stop();
 
+		/* Protobuf makes bodies of both directions compact and cheap to parse, json stays default */
+		void setFormat(ContentFormat format);
+
+		/* Server closes idle keep-alive connection, so it is noticed before next request is lost on it */
+		[[nodiscard]] bool checkConnection();
+
 		void performPost(const Word& word);
 		void performPut(const Word& word);
 		void performDelete(uint64_t id);
+		/* Whole batch is applied in one db transaction, status of every word comes in its order */
+		[[nodiscard]] auto performPost(const std::vector<Word>& words) -> std::vector<WordStatus>;
+		[[nodiscard]] auto performPut(const std::vector<Word>& words) -> std::vector<WordStatus>;
 
 		[[nodiscard]] auto performGet(uint64_t id) -> Word;
 		[[nodiscard]] auto performGet() -> std::vector<Word>;
+		/* Page of words with ids greater than afterId, id of its last word continues to next page */
+		[[nodiscard]] auto performGet(uint64_t afterId, std::size_t limit) -> std::vector<Word>;
+		/* Pipelines one request per id on this connection, word which can't be got stays default in its place */
+		[[nodiscard]] auto performGet(const std::vector<uint64_t>& ids) -> std::vector<Word>;
 
 	private:
+		auto performGetWords(const std::string& target) -> std::vector<Word>;
+		auto performBatch(http::verb method, const std::string& target, const std::vector<Word>& words) -> std::vector<WordStatus>;
+		/* Failed exchange marks client stopped, so owner of it knows to reconnect */
+		auto writeRequest(const http::request<http::string_body>& request) -> boost::system::error_code;
+		/* Bytes read past response stay in buffer of client, since they start next pipelined response */
+		auto readResponse(http::response_parser<http::dynamic_body>& parser) -> boost::system::error_code;
+		/* Body is decoded by Content-Encoding, since every request offers gzip and deflate, decoded size is capped like raw one.
+		 * Format is taken from Content-Type of response, not from one asked for, and body of other media type fails */
+		auto decodeBody(const http::response<http::dynamic_body>& response, std::size_t bodyLimit, ContentFormat& format)
+			-> boost::system::result<std::string>;
 		auto prepareRequest(http::verb method, const std::string& target = "", const std::string& body = "")
 			-> http::request<http::string_body>;
 
+		auto serializeWord(const Word& word) -> boost::system::result<std::string>;
+		auto serializeWords(const std::vector<Word>& words) -> boost::system::result<std::string>;
+		auto deserializeWord(const std::string& body, ContentFormat format) -> boost::system::result<Word>;
+		auto deserializeWords(const std::string& body, ContentFormat format) -> boost::system::result<std::vector<Word>>;
+		auto deserializeStatuses(const std::string& body, ContentFormat format) -> boost::system::result<std::vector<WordStatus>>;
+
 	private:
 		std::string mHost;
 		uint16_t mPort;
+		std::string mSocketPath;
 
 		net::io_context mContext;
-		beast::tcp_stream mStream;
+		beast::basic_stream<net::generic::stream_protocol> mStream;
+		beast::flat_buffer mBuffer;
 
 		JsonParser mParser;
+		ProtobufParser mProtobufParser;
+		ContentFormat mFormat;
 		bool mStarted;
 	};
 }
@@ -29,8 +29,12 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 
+#include "concurrency/ReactorPool.hpp"
 #include "db/SyncDictDao.hpp"
-#include "format/JsonParser.hpp"
+#include "http/HttpDictDumper.hpp"
+#include "http/HttpDictRequestHandler.hpp"
+#include "net/NetworkUtils.hpp"
+#include "net/SessionLimits.hpp"
 
 namespace beast = boost::beast;
 namespace net = boost::asio;
@@ -38,9 +42,19 @@ namespace http = beast::http;
 
 namespace lynx {
 
+	/*
+	 * Http server with blocking style session per thread. In sharded mode every shard owns io_context,
+	 * accept thread and SO_REUSEPORT acceptor, and sessions it accepts stay on its context and cpu.
+	 * Event loop per core without session threads is AsyncHttpDictServer.
+	 */
 	class SyncHttpDictServer final {
 	public:
-		SyncHttpDictServer(const std::string& host , uint16_t port);
+		/* In sharded mode every thread accepts on its own socket bound to same port */
+		SyncHttpDictServer(const std::string& host , uint16_t port, const ReactorOptions& options = { .threadCount = 1 },
+						   const SessionLimits& limits = {}, const CompressionOptions& compression = {}, const DumpOptions& dump = {});
+		/* Unix domain socket can't be shared by SO_REUSEPORT, so it always has one acceptor */
+		SyncHttpDictServer(const std::string& host, const std::string& socketPath, const SessionLimits& limits = {},
+						   const CompressionOptions& compression = {}, const DumpOptions& dump = {});
 		~SyncHttpDictServer();
 
 		[[nodiscard]] bool isStarted() const;
@@ -50,28 +64,48 @@ namespace lynx {
 
 	private:
 		void startSignalHandler();
-		void processSession(net::ip::tcp::socket& socket);
-
-		auto handlePostRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
-		auto handlePutRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
-		auto handleDeleteRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
-		auto handleGetByIdRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
-		auto handleGetAllRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator>;
-
-		auto prepareResponse(const std::string& body, http::status status, uint32_t version, bool keepAlive)
-			-> http::response<http::string_body>;
-		[[nodiscard]] bool checkTarget(boost::core::string_view target) const;
+		void openAcceptor(stream_acceptor& acceptor);
+		void acceptClients(uint32_t acceptorIndex);
+		void processSession(net::generic::stream_protocol::socket& socket);
+		/* Header is read alone when body type is chosen by route, parser then continues with same buffer */
+		template<class Body>
+		auto readRequest(net::generic::stream_protocol::socket& socket, beast::flat_buffer& buffer,
+						 http::request_parser<Body>& parser, bool headerOnly) -> boost::system::error_code;
+		/* Route is matched once on header, so body type and handler are chosen by same table */
+		auto routeRequest(http::request<JsonWordBody>&& request, const HttpRouteMatch& match)
+			-> std::unique_ptr<http::message_generator>;
+		auto routeRequest(http::request<http::string_body>&& request, const HttpRouteMatch& match)
+			-> std::unique_ptr<http::message_generator>;
+		auto writeResponse(net::generic::stream_protocol::socket& socket, http::message_generator& response)
+			-> boost::system::error_code;
+		/* Whole dictionary goes out as chunked body read page by page, so session memory doesn't grow with it */
+		auto streamWords(net::generic::stream_protocol::socket& socket, const http::request<http::string_body>& request)
+			-> boost::system::error_code;
+		auto writeChunk(net::generic::stream_protocol::socket& socket, http::response_serializer<http::buffer_body>& serializer)
+			-> boost::system::error_code;
+		/* Header goes through serializer, range of dump file is copied to socket by kernel */
+		auto sendDump(net::generic::stream_protocol::socket& socket, const http::request<http::string_body>& request)
+			-> boost::system::error_code;
 
 	private:
 		std::string mHost;
 		uint16_t mPort;
+		std::string mSocketPath;
+		ReactorOptions mOptions;
+		SessionLimits mLimits;
 
 		net::io_context mContext;
-		net::ip::tcp::acceptor mAcceptor;
+		/* shard contexts are only owners of sockets, blocking calls don't need them run */
+		std::vector<std::unique_ptr<net::io_context>> mShardContexts;
+		/* stop may come while start still opens acceptors, so both hold this mutex */
+		std::mutex mAcceptorsMutex;
+		std::vector<stream_acceptor> mAcceptors;
 		net::signal_set mSignals;
 
 		SyncDictDao mDictDao;
-		JsonParser mParser;
+		std::mutex mDictDaoMutex;
+		HttpDictRequestHandler mHandler;
+		HttpDictDumper mDumper;
 		std::atomic_bool mStarted;
 	};
 }
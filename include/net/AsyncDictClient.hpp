@@ -0,0 +1,137 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "format/ProtobufParser.hpp"
+#include "net/DictFrame.hpp"
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	/*
+	 * Client of protocol v2 running on io_context of application. Requests of all callers
+	 * are pipelined over one connection and matched with replies by request id, so one
+	 * thread can keep thousands of lookups in flight. Errors are returned, not logged only.
+	 *
+	 * Every call has awaitable form and completion token form, the latter completes with
+	 * (std::exception_ptr, result) as co_spawn does. Client has to outlive its requests,
+	 * while reader and writer share connection with it and may end after it is destroyed.
+	 */
+	class AsyncDictClient final {
+	public:
+		AsyncDictClient(net::io_context& context, const std::string& host, uint16_t port);
+		~AsyncDictClient();
+
+		[[nodiscard]] bool isStarted() const;
+
+		/* Connects and switches connection to protocol v2 */
+		auto start() -> net::awaitable<boost::system::result<void>>;
+		void stop();
+
+		void quit();
+
+		auto insert(const Word& word) -> net::awaitable<boost::system::result<void>>;
+		auto update(const Word& word) -> net::awaitable<boost::system::result<void>>;
+		auto remove(uint64_t id) -> net::awaitable<boost::system::result<void>>;
+		auto getById(uint64_t id) -> net::awaitable<boost::system::result<Word>>;
+		auto getAll() -> net::awaitable<boost::system::result<std::vector<Word>>>;
+		auto ping() -> net::awaitable<boost::system::result<void>>;
+
+		template<typename CompletionToken>
+		auto start(CompletionToken&& token) {
+			return net::co_spawn(mStrand, performConnect(), std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto insert(const Word& word, CompletionToken&& token) {
+			return net::co_spawn(mStrand, performStatusFrame(DictOpcode::INSERT, mParser.serializeToBuffer(word)),
+								 std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto update(const Word& word, CompletionToken&& token) {
+			return net::co_spawn(mStrand, performStatusFrame(DictOpcode::UPDATE, mParser.serializeToBuffer(word)),
+								 std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto remove(uint64_t id, CompletionToken&& token) {
+			return net::co_spawn(mStrand, performStatusFrame(DictOpcode::DELETE, mParser.serializeIdToBuffer(id)),
+								 std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto getById(uint64_t id, CompletionToken&& token) {
+			return net::co_spawn(mStrand, performGetById(mParser.serializeIdToBuffer(id)), std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto getAll(CompletionToken&& token) {
+			return net::co_spawn(mStrand, performGetAll(), std::forward<CompletionToken>(token));
+		}
+
+		template<typename CompletionToken>
+		auto ping(CompletionToken&& token) {
+			return net::co_spawn(mStrand, performStatusFrame(DictOpcode::PING, std::vector<std::byte>()),
+								 std::forward<CompletionToken>(token));
+		}
+
+	private:
+		struct PendingFrame;
+		struct Connection;
+
+		/* all of them run on strand, so connection state needs no locks */
+		auto performConnect() -> net::awaitable<boost::system::result<void>>;
+		auto performStatusFrame(DictOpcode opcode, boost::system::result<std::vector<std::byte>> payload)
+			-> net::awaitable<boost::system::result<void>>;
+		auto performGetById(boost::system::result<std::vector<std::byte>> payload) -> net::awaitable<boost::system::result<Word>>;
+		auto performGetAll() -> net::awaitable<boost::system::result<std::vector<Word>>>;
+		auto performFrame(DictOpcode opcode, std::vector<std::byte> payload) -> net::awaitable<boost::system::result<DictFrame>>;
+
+		/* Reader and writer hold connection instead of client, so destroyed client can't be touched by them */
+		static auto readFrames(std::shared_ptr<Connection> connection) -> net::awaitable<void>;
+		static auto writeFrames(std::shared_ptr<Connection> connection) -> net::awaitable<void>;
+		static void completeFrames(Connection& connection, boost::system::error_code errorCode);
+
+	private:
+		net::strand<net::io_context::executor_type> mStrand;
+		net::ip::tcp::endpoint mEndpoint;
+		std::shared_ptr<Connection> mConnection;
+
+		ProtobufParser mParser;
+	};
+}
@@ -0,0 +1,77 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "concurrency/ReactorPool.hpp"
+#include "db/SyncDictDao.hpp"
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	struct DictStreamCursor;
+
+	class AsyncDictServer final {
+	public:
+		AsyncDictServer(const std::string& host, uint16_t port, const ReactorOptions& options = {});
+		~AsyncDictServer();
+
+		[[nodiscard]] bool isStarted() const;
+
+		void start();
+		void stop();
+
+	private:
+		auto openAcceptor(net::ip::tcp::acceptor& acceptor) -> boost::system::error_code;
+		auto acceptClients(net::ip::tcp::acceptor& acceptor) -> net::awaitable<void>;
+		auto processSession(net::ip::tcp::socket socket) -> net::awaitable<void>;
+
+		struct FrameSession;
+		auto readFrames(std::shared_ptr<FrameSession> session, std::string remoteBuffer) -> net::awaitable<void>;
+		auto writeFrames(std::shared_ptr<FrameSession> session) -> net::awaitable<void>;
+		/* Reads next chunk of stream on thread pool and queues it on strand, pauses while queue of writer is full */
+		static void streamFrames(std::shared_ptr<FrameSession> session, DictStreamCursor cursor);
+
+	private:
+		uint16_t mPort;
+
+		ReactorPool mReactors;
+		/* stop may come while start still opens acceptors, so both hold this mutex */
+		std::mutex mAcceptorsMutex;
+		std::vector<net::ip::tcp::acceptor> mAcceptors;
+
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		std::atomic_bool mStarted;
+	};
+}
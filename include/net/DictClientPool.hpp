@@ -0,0 +1,111 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "net/SyncDictClient.hpp"
+
+namespace lynx {
+
+	struct DictClientPoolOptions final {
+		uint32_t clientCount = std::thread::hardware_concurrency();
+		DictProtocol protocol = DictProtocol::TEXT;
+		std::chrono::milliseconds healthCheckInterval = std::chrono::seconds(5);
+	};
+
+	/*
+	 * Keeps pre-connected SyncDictClient instances and hands each of them to one caller
+	 * at a time. Free client is claimed by atomic flag without lock, callers wait only
+	 * while every client is leased. Client idle longer than health check interval is
+	 * pinged before reuse, broken client is reconnected.
+	 */
+	class DictClientPool final {
+	public:
+		class Lease final {
+		public:
+			Lease(Lease&& other) noexcept;
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+			~Lease();
+
+			auto operator*() -> SyncDictClient&;
+			auto operator->() -> SyncDictClient*;
+
+		private:
+			friend class DictClientPool;
+			Lease(DictClientPool& pool, uint32_t index);
+
+			DictClientPool* mPool;
+			uint32_t mIndex;
+		};
+
+	public:
+		DictClientPool(const std::string& host, uint64_t port, const DictClientPoolOptions& options = {});
+		~DictClientPool();
+
+		[[nodiscard]] bool isStarted() const;
+
+		/* Both skip slots which are leased at the moment, client of such slot is connected by its lease */
+		void start();
+		/* Client leased during stop isn't stopped, it is closed when pool is destroyed */
+		void stop();
+
+		/* Blocks while all clients are leased, before start client of leased slot is connected on demand */
+		[[nodiscard]] auto acquire() -> Lease;
+
+		void performInsert(const Word& word);
+		void performUpdate(const Word& word);
+		void performDelete(uint64_t id);
+
+		[[nodiscard]] auto performGetById(uint64_t id) -> Word;
+		[[nodiscard]] auto performGetAll() -> std::vector<Word>;
+
+	private:
+		struct Slot {
+			std::unique_ptr<SyncDictClient> client;
+			std::chrono::steady_clock::time_point lastUsed;
+			std::atomic_flag leased;
+		};
+
+		void prepareClient(Slot& slot);
+		void reconnectClient(Slot& slot);
+		void release(uint32_t index);
+
+	private:
+		std::string mHost;
+		uint64_t mPort;
+		DictClientPoolOptions mOptions;
+
+		std::unique_ptr<Slot[]> mSlots;
+		std::atomic_uint32_t mNextIndex;
+		std::atomic_uint32_t mReleaseCount;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,85 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/system/result.hpp>
+
+#include "common/DictCommand.hpp"
+
+namespace lynx {
+
+	/*
+	 * Binary frame of protocol v2:
+	 * | opcode:1 | status:1 | flags:2 | request id:4 | payload size:4 | payload |
+	 * All integers are in network byte order, payload is protobuf message.
+	 */
+	constexpr std::size_t DICT_FRAME_HEADER_SIZE = 12;
+	constexpr uint32_t DICT_FRAME_MAX_PAYLOAD_SIZE = 64 * 1024 * 1024;
+
+	/* Streamed reply is sent as frames with this flag followed by one frame without it */
+	constexpr uint16_t DICT_FRAME_FLAG_MORE = 0x0001;
+	constexpr std::size_t DICT_STREAM_CHUNK_SIZE = 1024;
+	/* Stream reads next chunk only while fewer replies wait for writer, so slow reader holds few chunks in memory */
+	constexpr std::size_t DICT_STREAM_MAX_QUEUED_COUNT = 4;
+	/* Event loop server stops reading requests and stream chunks while this much of output isn't sent */
+	constexpr std::size_t DICT_OUTPUT_HIGH_WATER_MARK = 1024 * 1024;
+
+	/* Replies coalesced into one gather write, two buffers per frame stay far below IOV_MAX */
+	constexpr std::size_t DICT_FRAME_MAX_FLUSH_COUNT = 64;
+
+	enum class DictStatus : uint8_t {
+		SUCCESS = 0,
+		FAILURE = 1
+	};
+
+	struct DictFrameHeader final {
+		DictOpcode opcode;
+		DictStatus status;
+		uint16_t flags;
+		uint32_t requestId;
+		uint32_t payloadSize;
+	};
+
+	struct DictFrame final {
+		DictFrameHeader header;
+		std::vector<std::byte> payload;
+	};
+
+	auto encodeFrameHeader(const DictFrameHeader& header) -> std::array<std::byte, DICT_FRAME_HEADER_SIZE>;
+	auto decodeFrameHeader(std::span<const std::byte> buffer) -> boost::system::result<DictFrameHeader>;
+
+	/* Payload above DICT_FRAME_MAX_PAYLOAD_SIZE gives error frame instead */
+	auto makeFrame(DictOpcode opcode, uint32_t requestId, std::vector<std::byte>&& payload = {}) -> DictFrame;
+	auto makeErrorFrame(DictOpcode opcode, uint32_t requestId, const std::string& message) -> DictFrame;
+
+	/* Copies encoded header and payload to output buffer of event loop server */
+	void appendFrame(std::string& output, const DictFrame& frame);
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "db/SyncDictDao.hpp"
+#include "format/ProtobufParser.hpp"
+#include "format/XmlParser.hpp"
+#include "net/DictFrame.hpp"
+
+namespace lynx {
+
+	/* Position of GET_ALL_STREAM reply, it is finished by frame without DICT_FRAME_FLAG_MORE */
+	struct DictStreamCursor final {
+		DictFrameHeader header;
+		uint64_t afterId = 0;
+		bool finished = false;
+	};
+
+	/*
+	 * Dispatches one message of the line protocol (DictCommand.hpp) or one binary
+	 * frame of protocol v2 (DictFrame.hpp) to the dao and builds the reply. Every
+	 * session owns its own handler, because XmlParser is stateful, while the dao
+	 * is shared between sessions behind a mutex.
+	 */
+	class DictRequestHandler final {
+	public:
+		DictRequestHandler(SyncDictDao& dictDao, std::mutex& dictDaoMutex);
+		~DictRequestHandler() = default;
+
+		/* Appends reply with terminator to connection output buffer, returns false if client sent QUIT */
+		bool processMessage(std::string_view message, std::string& reply);
+
+		/* Returns reply frame or std::nullopt if client sent QUIT, safe to call concurrently */
+		auto processFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> std::optional<DictFrame>;
+
+		/*
+		 * Returns next frame of GET_ALL_STREAM reply read from one keyset page. Dao is locked only while page
+		 * is read, so caller sends frame unlocked and asks for next one once peer keeps up. Safe to call concurrently.
+		 */
+		auto processStreamFrame(DictStreamCursor& cursor) -> DictFrame;
+
+	private:
+		void processInsert(std::string_view message, std::string& reply);
+		void processUpdate(std::string_view message, std::string& reply);
+		void processDelete(std::string_view message, std::string& reply);
+		void processGetById(std::string_view message, std::string& reply);
+		void processGetAll(std::string_view message, std::string& reply);
+
+		auto processInsertFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame;
+		auto processUpdateFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame;
+		auto processDeleteFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame;
+		auto processGetByIdFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame;
+		auto processGetAllFrame(const DictFrameHeader& header) -> DictFrame;
+
+	private:
+		SyncDictDao& mDictDao;
+		std::mutex& mDictDaoMutex;
+
+		XmlParser mParser;
+		ProtobufParser mBinaryParser;
+	};
+}
@@ -24,11 +24,61 @@
 
 #pragma once
 
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/generic/stream_protocol.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/streambuf.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+
 namespace lynx {
 
+	/* Lets several sockets bind same port, kernel balances accepted connections between them */
+	class reuse_port final {
+	public:
+		explicit reuse_port(bool enabled) : mValue(enabled ? 1 : 0) {}
+
+		/* settable socket option requirements of asio */
+		template<class Protocol> int level(const Protocol&) const { return SOL_SOCKET; }
+		template<class Protocol> int name(const Protocol&) const { return SO_REUSEPORT; }
+		template<class Protocol> const void* data(const Protocol&) const { return &mValue; }
+		template<class Protocol> std::size_t size(const Protocol&) const { return sizeof(mValue); }
+
+	private:
+		int mValue;
+	};
+
+	/* Listens on tcp port as well as on unix domain socket, generic protocol has no acceptor of its own */
+	using stream_acceptor = boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol>;
+
+	/* Views received bytes without copy, view is valid until buffer is consumed or grows */
+	std::string_view toStringView(const boost::asio::streambuf& buffer);
+
 	std::string toString(boost::asio::streambuf& buffer);
 
 	std::string toStringFast(boost::asio::streambuf& buffer);
+
+	/* Unix domain socket path, leading '@' names socket in abstract namespace which has no file */
+	boost::asio::local::stream_protocol::endpoint toLocalEndpoint(std::string_view path);
+
+	/* Same path in unix: or unix-abstract: target syntax of gRPC */
+	std::string toLocalAddress(std::string_view path);
+
+	/* Socket file outlives server which bound it, so it is removed before path is bound again */
+	void removeLocalSocket(std::string_view path);
+
+	/* Checks without blocking whether peer has closed connection or it is broken */
+	bool isPeerClosed(int socketFd);
+
+	/* Block until socket is readable or writable, deadline passing is reported as timed_out */
+	boost::system::error_code waitReadable(int socketFd, std::chrono::steady_clock::time_point deadline);
+	boost::system::error_code waitWritable(int socketFd, std::chrono::steady_clock::time_point deadline);
+
+	/* One sendfile call, kernel copies file pages to socket, offset and size move by sent bytes, full socket is would_block */
+	boost::system::error_code sendFile(int socketFd, int fileFd, uint64_t& offset, uint64_t& size);
 }
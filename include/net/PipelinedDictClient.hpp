@@ -0,0 +1,90 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "format/ProtobufParser.hpp"
+#include "net/DictFrame.hpp"
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	/*
+	 * Client of protocol v2 which keeps many requests in flight on one connection.
+	 * Every call writes frame and returns future immediately, replies are read by
+	 * background thread and matched with requests by request id in any order.
+	 */
+	class PipelinedDictClient final {
+	public:
+		PipelinedDictClient(const std::string& host, uint16_t port);
+		~PipelinedDictClient();
+
+		[[nodiscard]] bool isStarted() const;
+
+		void start();
+		void stop();
+
+		void performQuit();
+		[[nodiscard]] auto performInsert(const Word& word) -> std::future<boost::system::result<void>>;
+		[[nodiscard]] auto performUpdate(const Word& word) -> std::future<boost::system::result<void>>;
+		[[nodiscard]] auto performDelete(uint64_t id) -> std::future<boost::system::result<void>>;
+
+		[[nodiscard]] auto performGetById(uint64_t id) -> std::future<boost::system::result<Word>>;
+		[[nodiscard]] auto performGetAll() -> std::future<boost::system::result<std::vector<Word>>>;
+
+	private:
+		using FrameCompletion = std::function<void(boost::system::result<DictFrame>&&)>;
+
+		void performNegotiation();
+		void performFrame(DictOpcode opcode, std::vector<std::byte>&& payload, FrameCompletion&& completion);
+		auto performStatusFrame(DictOpcode opcode, boost::system::result<std::vector<std::byte>>&& payload)
+			-> std::future<boost::system::result<void>>;
+
+		void receiveFrames();
+		void completeFrames(boost::system::error_code errorCode);
+
+	private:
+		net::io_context mContext;
+		net::ip::tcp::socket mSocket;
+		net::ip::tcp::endpoint mEndpoint;
+
+		std::thread mReceiveThread;
+		std::mutex mSendMutex;
+		std::mutex mPendingMutex;
+		std::unordered_map<uint32_t, FrameCompletion> mPendingFrames;
+
+		ProtobufParser mParser;
+		std::atomic_uint32_t mLastRequestId;
+		std::atomic_bool mStarted;
+	};
+}
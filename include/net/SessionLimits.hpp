@@ -0,0 +1,44 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace lynx {
+
+	/*
+	 * Bounds of one client session, so slow or hostile peer can't pin session thread
+	 * or grow its buffers without end. Sockets of limited sessions are nonblocking
+	 * and wait for readiness with poll, blocking asio calls have no timeout.
+	 */
+	struct SessionLimits final {
+		std::chrono::milliseconds idleTimeout = std::chrono::seconds(60);  /* waiting for first byte of next message */
+		std::chrono::milliseconds readTimeout = std::chrono::seconds(10);  /* receiving rest of started message */
+		std::chrono::milliseconds writeTimeout = std::chrono::seconds(10); /* peer taking whole reply */
+		uint32_t maxInFlightCount = 64;                                    /* pipelined messages answered by one flush, 0 is unlimited */
+		std::size_t maxMessageSize = 4 * 1024 * 1024;                      /* line, frame payload or http body, longer line closes session */
+	};
+}
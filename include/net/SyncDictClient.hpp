@@ -24,9 +24,15 @@
 
 #pragma once
 
+#include <boost/asio/generic/stream_protocol.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+#include <functional>
+
+#include "common/DictCommand.hpp"
+#include "format/ProtobufParser.hpp"
 #include "format/XmlParser.hpp"
+#include "net/DictFrame.hpp"
 
 namespace net = boost::asio;
 
@@ -34,7 +40,9 @@ namespace lynx {
 
 	class SyncDictClient final {
 	public:
-		SyncDictClient(const std::string& host, uint64_t port);
+		SyncDictClient(const std::string& host, uint64_t port, DictProtocol protocol = DictProtocol::TEXT);
+		/* Connects to server on same host over unix domain socket */
+		SyncDictClient(const std::string& socketPath, DictProtocol protocol = DictProtocol::TEXT);
 		~SyncDictClient();
 
 		[[nodiscard]] bool isStarted() const;
@@ -49,13 +57,28 @@ namespace lynx {
 
 		[[nodiscard]] auto performGetById(uint64_t id) -> Word;
 		[[nodiscard]] auto performGetAll() -> std::vector<Word>;
+		/* Streams words chunk by chunk over protocol v2, so memory doesn't grow with dictionary size */
+		auto performGetAll(const std::function<void(std::vector<Word>&&)>& consumeWords) -> boost::system::result<void>;
+
+		/* Round trip without touching db, connection is marked stopped if it is broken */
+		[[nodiscard]] bool performPing();
+
+	private:
+		void performNegotiation();
+		auto sendMessage(std::string_view command, std::string_view payload = {}) -> boost::system::error_code;
+		auto sendMessage(std::string_view command, uint64_t id) -> boost::system::error_code;
+		auto performFrame(DictOpcode opcode, std::vector<std::byte>&& payload = {}) -> boost::system::result<DictFrame>;
+		auto receiveFrame(DictOpcode opcode, uint32_t requestId) -> boost::system::result<DictFrame>;
 
 	private:
 		net::io_context mContext;
-		net::ip::tcp::socket mSocket;
-		net::ip::tcp::endpoint mEndpoint;
+		net::generic::stream_protocol::socket mSocket;
+		net::generic::stream_protocol::endpoint mEndpoint;
 
+		DictProtocol mProtocol;
 		XmlParser mParser;
+		ProtobufParser mBinaryParser;
+		uint32_t mLastRequestId;
 		bool mStarted;
 	};
 }
@@ -26,8 +26,12 @@
 
 #include <boost/asio/ip/tcp.hpp>
 
+#include <span>
+
 #include "db/SyncDictDao.hpp"
-#include "format/XmlParser.hpp"
+#include "net/DictRequestHandler.hpp"
+#include "net/NetworkUtils.hpp"
+#include "net/SessionLimits.hpp"
 
 namespace net = boost::asio;
 
@@ -35,7 +39,9 @@ namespace lynx {
 
 	class SyncDictServer final {
 	public:
-		SyncDictServer(const std::string& host, uint64_t port);
+		SyncDictServer(const std::string& host, uint64_t port, const SessionLimits& limits = {});
+		/* Listens on unix domain socket, co-located clients skip tcp stack */
+		SyncDictServer(const std::string& host, const std::string& socketPath, const SessionLimits& limits = {});
 		~SyncDictServer();
 
 		[[nodiscard]] bool isStarted() const;
@@ -45,21 +51,27 @@ namespace lynx {
 
 	private:
 		void processMessages();
+		void processMessage(std::string_view message);
+		bool flushMessages();
+
+		void processNegotiation();
+		void processFrames(std::string& remoteBuffer);
 
-		void processInsert(const std::string& message);
-		void processUpdate(const std::string& message);
-		void processDelete(const std::string& message);
-		void processGetById(const std::string& message);
-		void processGetAll(const std::string& message);
+		auto receiveMessage(std::string& remoteBuffer) -> boost::system::result<std::size_t>;
+		auto receiveAtLeast(std::string& remoteBuffer, std::size_t size, std::chrono::steady_clock::time_point deadline)
+			-> boost::system::error_code;
+		auto sendBuffers(std::span<net::const_buffer> localBuffers) -> boost::system::error_code;
 
 	private:
 		net::io_context mContext;
-		net::ip::tcp::socket mSocket;
-		net::ip::tcp::endpoint mEndpoint;
-		net::ip::tcp::acceptor mAcceptor;
+		net::generic::stream_protocol::socket mSocket;
+		stream_acceptor mAcceptor;
 
 		SyncDictDao dictDao;
-		XmlParser mParser;
+		std::mutex mDictDaoMutex;
+		DictRequestHandler mHandler;
+		SessionLimits mLimits;
+		std::string mLocalBuffer;
 		bool mStarted;
 	};
 }
@@ -0,0 +1,89 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "db/SyncDictDao.hpp"
+#include "net/SessionLimits.hpp"
+
+namespace lynx {
+
+	/*
+	 * Dictionary server on raw edge-triggered epoll without asio. Every thread runs its own
+	 * event loop with own listening socket bound by SO_REUSEPORT, so connection never leaves
+	 * thread which accepted it. Serves line protocol and protocol v2 frames of SyncDictServer.
+	 * Dao is called on loop thread, so slow query delays every connection of that loop.
+	 */
+	class EpollDictServer final {
+	public:
+		EpollDictServer(const std::string& host, uint16_t port, uint32_t threadCount = std::thread::hardware_concurrency(),
+						const SessionLimits& limits = {});
+		~EpollDictServer();
+
+		[[nodiscard]] bool isStarted() const;
+
+		/* Blocks until stop(), first event loop runs on calling thread */
+		void start();
+		void stop();
+
+	private:
+		struct Connection;
+		struct EventLoop;
+
+		auto openLoop() -> boost::system::result<std::unique_ptr<EventLoop>>;
+		void runLoop(EventLoop& loop);
+
+		void acceptClients(EventLoop& loop);
+		void closeClient(EventLoop& loop, int socketFd);
+
+		/* Receives, processes and sends until socket is drained, output above high water mark parks first two */
+		bool serveClient(Connection& connection);
+		bool receiveData(Connection& connection);
+		bool processData(Connection& connection);
+		bool processMessages(Connection& connection);
+		bool processFrames(Connection& connection);
+		void processStream(Connection& connection);
+		bool sendData(Connection& connection);
+
+	private:
+		uint16_t mPort;
+		uint32_t mThreadCount;
+		SessionLimits mLimits;
+
+		/* stop may come while start still opens loops, so both hold this mutex */
+		std::mutex mLoopsMutex;
+		std::vector<std::unique_ptr<EventLoop>> mLoops;
+		std::vector<std::thread> mThreads;
+
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,106 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <span>
+
+#include <boost/system/result.hpp>
+
+#include <linux/io_uring.h>
+
+namespace lynx {
+
+	/*
+	 * Minimal io_uring ring on top of raw syscalls: submission and completion queues mapped
+	 * into process, probe of supported operations and one provided buffer ring for multishot
+	 * receive. Not thread safe, every event loop owns its own ring.
+	 */
+	class IoUring final {
+	public:
+		IoUring();
+		~IoUring();
+
+		IoUring(const IoUring&) = delete;
+		IoUring& operator=(const IoUring&) = delete;
+
+		auto open(uint32_t entryCount) -> boost::system::result<void>;
+		[[nodiscard]] bool isSupported(uint8_t opcode) const;
+
+		/* Registers bufferCount (power of two) buffers of bufferSize bytes as group groupId */
+		auto registerBuffers(uint16_t groupId, uint16_t bufferCount, uint32_t bufferSize) -> boost::system::result<void>;
+		auto getBuffer(uint16_t bufferId, std::size_t size) -> std::span<const char>;
+		void recycleBuffer(uint16_t bufferId);
+
+		/* Returns zeroed entry, full submission queue is flushed to kernel first */
+		auto prepare() -> io_uring_sqe*;
+		/* Submits all prepared entries and waits for waitCount completions in one syscall */
+		auto submit(uint32_t waitCount) -> boost::system::result<uint32_t>;
+
+		template<typename Handler>
+		auto consume(Handler&& handler) -> uint32_t {
+			uint32_t head = *mCqHead;
+			const uint32_t tail = std::atomic_ref(*mCqTail).load(std::memory_order_acquire);
+			const uint32_t count = tail - head;
+
+			for (; head != tail; ++head) {
+				handler(mCqes[head & *mCqMask]);
+			}
+
+			std::atomic_ref(*mCqHead).store(head, std::memory_order_release);
+			return count;
+		}
+
+	private:
+		int mRingFd;
+		uint32_t mEntryCount;
+		std::bitset<256> mSupportedOps;
+
+		void* mRingMemory;
+		std::size_t mRingSize;
+		io_uring_sqe* mSqes;
+		std::size_t mSqesSize;
+
+		uint32_t* mSqHead;
+		uint32_t* mSqTail;
+		uint32_t* mSqMask;
+		uint32_t mSqLocalTail;
+
+		uint32_t* mCqHead;
+		uint32_t* mCqTail;
+		uint32_t* mCqMask;
+		io_uring_cqe* mCqes;
+
+		io_uring_buf_ring* mBufferRing;
+		std::size_t mBufferRingSize;
+		char* mBuffers;
+		std::size_t mBuffersSize;
+		uint16_t mBufferCount;
+		uint32_t mBufferSize;
+		uint16_t mBufferTail;
+	};
+}
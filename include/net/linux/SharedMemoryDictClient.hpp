@@ -0,0 +1,84 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <functional>
+#include <optional>
+
+#include "format/ProtobufParser.hpp"
+#include "net/DictFrame.hpp"
+#include "net/linux/SharedMemoryRing.hpp"
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	/*
+	 * Client of SharedMemoryDictServer. Unix domain socket is used only to receive memfd
+	 * and to notice that server is gone, frames are exchanged through rings in shared memory.
+	 */
+	class SharedMemoryDictClient final {
+	public:
+		explicit SharedMemoryDictClient(const std::string& socketPath);
+		~SharedMemoryDictClient();
+
+		[[nodiscard]] bool isStarted() const;
+
+		void start();
+		void stop();
+
+		void performQuit();
+		void performInsert(const Word& word);
+		void performUpdate(const Word& word);
+		void performDelete(uint64_t id);
+
+		[[nodiscard]] auto performGetById(uint64_t id) -> Word;
+		[[nodiscard]] auto performGetAll() -> std::vector<Word>;
+		auto performGetAll(const std::function<void(std::vector<Word>&&)>& consumeWords) -> boost::system::result<void>;
+
+		[[nodiscard]] bool performPing();
+
+	private:
+		auto receiveRegion() -> boost::system::result<SharedMemoryRegion>;
+		auto performFrame(DictOpcode opcode, std::vector<std::byte>&& payload = {}) -> boost::system::result<DictFrame>;
+		auto receiveFrame(DictOpcode opcode, uint32_t requestId) -> boost::system::result<DictFrame>;
+
+	private:
+		net::io_context mContext;
+		net::local::stream_protocol::socket mSocket;
+		net::local::stream_protocol::endpoint mEndpoint;
+
+		std::optional<SharedMemoryRegion> mRegion;
+		std::optional<SharedMemoryRing> mRequestRing;
+		std::optional<SharedMemoryRing> mResponseRing;
+
+		ProtobufParser mBinaryParser;
+		uint32_t mLastRequestId;
+		bool mStarted;
+	};
+}
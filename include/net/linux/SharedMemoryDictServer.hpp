@@ -0,0 +1,78 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "db/SyncDictDao.hpp"
+#include "net/linux/SharedMemoryRing.hpp"
+
+namespace net = boost::asio;
+
+namespace lynx {
+
+	/*
+	 * Dictionary server for clients on same host. Client connects to unix domain socket and receives
+	 * memfd with request and response rings, afterwards protocol v2 frames go through shared memory
+	 * only. Socket stays open so that each side notices when other one is gone.
+	 */
+	class SharedMemoryDictServer final {
+	public:
+		SharedMemoryDictServer(const std::string& host, const std::string& socketPath,
+							   uint32_t ringCapacity = SHARED_MEMORY_RING_CAPACITY);
+		~SharedMemoryDictServer();
+
+		[[nodiscard]] bool isStarted() const;
+
+		/* Blocks until stop(), every client is served by its own thread */
+		void start();
+		void stop();
+
+	private:
+		void acceptClients();
+		auto openRegion() -> boost::system::result<SharedMemoryRegion>;
+		auto sendRegion(net::local::stream_protocol::socket& socket, const SharedMemoryRegion& region) -> boost::system::error_code;
+
+		void processSession(net::local::stream_protocol::socket socket, SharedMemoryRegion region);
+		bool sendFrame(SharedMemoryRing& ring, const net::local::stream_protocol::socket& socket, const DictFrame& frame);
+
+	private:
+		std::string mSocketPath;
+		uint32_t mRingCapacity;
+
+		net::io_context mContext;
+		net::local::stream_protocol::acceptor mAcceptor;
+		std::vector<std::thread> mSessionThreads;
+
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		std::atomic_bool mStarted;
+	};
+}
@@ -0,0 +1,101 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <boost/system/result.hpp>
+
+#include "net/DictFrame.hpp"
+
+namespace lynx {
+
+	constexpr uint32_t SHARED_MEMORY_RING_CAPACITY = 1024 * 1024;
+
+	/* Memory of memfd mapped into process, peer gets same pages through passed descriptor */
+	class SharedMemoryRegion final {
+	public:
+		static auto create(std::size_t size) -> boost::system::result<SharedMemoryRegion>;
+		static auto attach(int fd) -> boost::system::result<SharedMemoryRegion>;
+
+		SharedMemoryRegion(SharedMemoryRegion&& other) noexcept;
+		SharedMemoryRegion& operator=(SharedMemoryRegion&& other) noexcept;
+		~SharedMemoryRegion();
+
+		[[nodiscard]] auto getFd() const -> int;
+		[[nodiscard]] auto getData() const -> std::byte*;
+		[[nodiscard]] auto getSize() const -> std::size_t;
+
+	private:
+		SharedMemoryRegion(int fd, std::byte* data, std::size_t size);
+
+	private:
+		int mFd;
+		std::byte* mData;
+		std::size_t mSize;
+	};
+
+	/*
+	 * Single producer single consumer ring of protocol v2 frames placed in shared memory.
+	 * Waiting side spins shortly and then sleeps on futex of ring counter, so a busy peer
+	 * is answered without syscalls and an idle one doesn't burn cpu.
+	 */
+	class SharedMemoryRing final {
+	public:
+		/* Capacity is power of two, whole frame with header has to fit into it */
+		static auto getRequiredSize(uint32_t capacity) -> std::size_t;
+		static void initialize(std::byte* memory, uint32_t capacity);
+		/* Inverse of getRequiredSize, zero when size doesn't hold valid ring */
+		static auto getCapacityFor(std::size_t size) -> uint32_t;
+
+		/* Capacity comes from own side, header in shared memory is writable by peer */
+		SharedMemoryRing(std::byte* memory, uint32_t capacity);
+
+		[[nodiscard]] auto getCapacity() const -> uint32_t;
+
+		/* Both block up to timeout, so caller can check whether peer is still alive */
+		auto write(const DictFrame& frame, std::chrono::milliseconds timeout) -> boost::system::result<void>;
+		auto read(std::chrono::milliseconds timeout) -> boost::system::result<DictFrame>;
+
+	private:
+		struct Header;
+
+		template<typename Ready>
+		auto waitUntil(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& waiterCount,
+					   Ready&& ready, std::chrono::milliseconds timeout) -> boost::system::result<void>;
+		void wakeUp(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& waiterCount);
+
+		void copyIn(uint32_t position, std::span<const std::byte> data);
+		void copyOut(uint32_t position, std::span<std::byte> data) const;
+
+	private:
+		Header* mHeader;
+		std::byte* mData;
+		uint32_t mCapacity;
+		uint32_t mMask;
+	};
+}
@@ -0,0 +1,102 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "db/SyncDictDao.hpp"
+#include "net/linux/EpollDictServer.hpp"
+#include "net/linux/IoUring.hpp"
+
+namespace lynx {
+
+	/*
+	 * Dictionary server on io_uring. Every thread owns a ring with own SO_REUSEPORT listener,
+	 * multishot accept and multishot receive into provided buffer ring, so one syscall per loop
+	 * iteration submits all sends and reaps all completions. Kernels without these features
+	 * get EpollDictServer behind the same interface.
+	 */
+	class UringDictServer final {
+	public:
+		UringDictServer(const std::string& host, uint16_t port, uint32_t threadCount = std::thread::hardware_concurrency());
+		~UringDictServer();
+
+		[[nodiscard]] bool isStarted() const;
+		[[nodiscard]] bool isFallback() const;
+
+		/* Blocks until stop(), first event loop runs on calling thread */
+		void start();
+		void stop();
+
+		/* Checks that kernel supports everything server relies on */
+		[[nodiscard]] static bool isSupported();
+
+	private:
+		struct Connection;
+		struct EventLoop;
+
+		auto openLoop() -> boost::system::result<std::unique_ptr<EventLoop>>;
+		void runLoop(EventLoop& loop);
+		void closeLoop(EventLoop& loop);
+
+		void processCompletion(EventLoop& loop, const io_uring_cqe& cqe);
+		void acceptClient(EventLoop& loop, const io_uring_cqe& cqe);
+		void receiveData(EventLoop& loop, const io_uring_cqe& cqe);
+		void sendData(EventLoop& loop, const io_uring_cqe& cqe);
+
+		void prepareAccept(EventLoop& loop);
+		void prepareWakeup(EventLoop& loop);
+		void prepareReceive(EventLoop& loop, Connection& connection);
+		void prepareSend(EventLoop& loop, Connection& connection);
+		/* Ends multishot receive of client whose output is above high water mark, it is rearmed once output drains */
+		void prepareCancel(EventLoop& loop, Connection& connection);
+		void closeClient(Connection& connection);
+		void releaseClient(EventLoop& loop, Connection& connection);
+
+		bool processData(Connection& connection, std::string_view remoteData);
+		auto processMessages(Connection& connection, std::string_view remoteData) -> std::size_t;
+		auto processFrames(Connection& connection, std::string_view remoteData) -> boost::system::result<std::size_t>;
+		void processStream(Connection& connection);
+
+	private:
+		uint16_t mPort;
+		uint32_t mThreadCount;
+
+		/* stop may come while start still opens loops, so both hold this mutex */
+		std::mutex mLoopsMutex;
+		std::vector<std::unique_ptr<EventLoop>> mLoops;
+		std::vector<std::thread> mThreads;
+		std::unique_ptr<EpollDictServer> mFallbackServer;
+
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		std::atomic_bool mStarted;
+	};
+}
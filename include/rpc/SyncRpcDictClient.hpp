@@ -33,6 +33,8 @@ namespace lynx {
 	class SyncRpcDictClient final {
 	public:
 		SyncRpcDictClient(const std::string& host, uint16_t port);
+		/* Connects to server on same host over unix domain socket */
+		explicit SyncRpcDictClient(const std::string& socketPath);
 		~SyncRpcDictClient();
 
 		[[nodiscard]] bool isStarted() const;
@@ -51,6 +53,7 @@ namespace lynx {
 	private:
 		std::string mHost;
 		uint16_t mPort;
+		std::string mSocketPath;
 
 		std::unique_ptr<rpc::RemoteDictService::Stub> mService;
 
@@ -40,6 +40,8 @@ namespace lynx {
 	class SyncRpcDictServer final : public rpc::RemoteDictService::Service {
 	public:
 		SyncRpcDictServer(const std::string& host, uint16_t port);
+		/* Listens on unix domain socket, co-located clients skip tcp stack */
+		SyncRpcDictServer(const std::string& host, const std::string& socketPath);
 		~SyncRpcDictServer();
 
 		[[nodiscard]] bool isStarted() const;
@@ -65,6 +67,7 @@ namespace lynx {
 	private:
 		std::string mHost;
 		uint16_t mPort;
+		std::string mSocketPath;
 
 		std::unique_ptr<grpc::Server> mService;
 
@@ -0,0 +1,100 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace lynx {
+
+	/* Bounded map evicting least recently used entry, caller locks it if it is shared between threads */
+	template<typename Key, typename Value>
+	class LruCache final {
+	public:
+		explicit LruCache(std::size_t capacity)
+			: mCapacity(capacity) {
+			mIndex.reserve(capacity);
+		}
+
+		[[nodiscard]] auto getCapacity() const -> std::size_t { return mCapacity; }
+		[[nodiscard]] auto getSize() const -> std::size_t { return mIndex.size(); }
+
+		/* Found entry becomes most recently used, value is copied so it outlives eviction */
+		auto get(const Key& key) -> std::optional<Value> {
+			auto position = mIndex.find(key);
+
+			if (position == mIndex.end()) {
+				return std::nullopt;
+			}
+
+			mEntries.splice(mEntries.begin(), mEntries, position->second);
+			return position->second->second;
+		}
+
+		void put(const Key& key, Value value) {
+			if (mCapacity == 0) {
+				return;
+			}
+
+			auto position = mIndex.find(key);
+
+			if (position != mIndex.end()) {
+				position->second->second = std::move(value);
+				mEntries.splice(mEntries.begin(), mEntries, position->second);
+				return;
+			}
+
+			if (mIndex.size() == mCapacity) {
+				mIndex.erase(mEntries.back().first);
+				mEntries.pop_back();
+			}
+
+			mEntries.emplace_front(key, std::move(value));
+			mIndex.emplace(key, mEntries.begin());
+		}
+
+		void erase(const Key& key) {
+			auto position = mIndex.find(key);
+
+			if (position != mIndex.end()) {
+				mEntries.erase(position->second);
+				mIndex.erase(position);
+			}
+		}
+
+		void clear() {
+			mIndex.clear();
+			mEntries.clear();
+		}
+
+	private:
+		std::size_t mCapacity;
+		std::list<std::pair<Key, Value>> mEntries;
+		std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> mIndex;
+	};
+}
@@ -25,11 +25,25 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <streambuf>
 
 namespace lynx {
 
     bool contains(const std::string& input, const std::string& substring);
+    /* Strips spaces and tabs, which http allows around header values and their elements */
+    auto trim(std::string_view value) -> std::string_view;
+    bool equalsIgnoreCase(std::string_view left, std::string_view right);
+
+    /* Read only stream buffer over characters owned by someone else, lets istream based parsers read without copy */
+    class StringViewBuffer final : public std::streambuf {
+    public:
+        explicit StringViewBuffer(std::string_view input) {
+            char* begin = const_cast<char*>(input.data());
+            setg(begin, begin, begin + input.size());
+        }
+    };
 
     template<typename... Args>
     std::string format(const char* formatter, Args... arguments) {
@@ -0,0 +1,92 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "concurrency/ReactorPool.hpp"
+#include "concurrency/ThreadUtils.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "ReactorPool";
+
+namespace lynx {
+
+	ReactorPool::ReactorPool(const ReactorOptions& options)
+		: mOptions(options) {
+		mOptions.threadCount = std::max(mOptions.threadCount, 1u);
+
+		if (mOptions.mode == ReactorMode::SHARDED) {
+			for (uint32_t i = 0; i < mOptions.threadCount; ++i) {
+				mContexts.push_back(std::make_unique<net::io_context>(1));
+			}
+		} else {
+			mContexts.push_back(std::make_unique<net::io_context>(static_cast<int>(mOptions.threadCount)));
+		}
+	}
+
+	ReactorPool::~ReactorPool() {
+		stop();
+
+		for (std::thread& thread : mThreads) {
+			if (thread.joinable()) {
+				thread.join();
+			}
+		}
+	}
+
+	auto ReactorPool::getOptions() const -> const ReactorOptions& { return mOptions; }
+
+	auto ReactorPool::getContextCount() const -> uint32_t { return static_cast<uint32_t>(mContexts.size()); }
+
+	auto ReactorPool::getContext(uint32_t index) -> net::io_context& { return *mContexts.at(index % mContexts.size()); }
+
+	void ReactorPool::run() {
+		for (uint32_t i = 1; i < mOptions.threadCount; ++i) {
+			mThreads.emplace_back(&ReactorPool::runContext, this, i);
+		}
+		runContext(0);
+
+		for (std::thread& thread : mThreads) {
+			thread.join();
+		}
+		mThreads.clear();
+	}
+
+	void ReactorPool::stop() {
+		for (auto& context : mContexts) {
+			context->stop();
+		}
+	}
+
+	void ReactorPool::runContext(uint32_t threadIndex) {
+		if (mOptions.pinThreads) {
+			const uint32_t cpu = threadIndex % std::max(std::thread::hardware_concurrency(), 1u);
+			boost::system::result<void> status = setAffinity(cpu);
+
+			if (status.has_error()) {
+				log::error(TAG, "Can't pin thread %u to cpu %u: %s", threadIndex, cpu, status.error().message().c_str());
+			}
+		}
+
+		getContext(threadIndex).run();
+	}
+}
@@ -25,6 +25,8 @@
 #include "concurrency/ThreadUtils.hpp"
 
 #include <csignal>
+#include <pthread.h>
+#include <sched.h>
 
 namespace lynx {
 
@@ -48,6 +50,19 @@ namespace lynx {
 		return {};
 	}
 
+	boost::system::result<void> setAffinity(uint32_t cpu) {
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+
+		int status = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &cpuSet);
+		if (status != 0) {
+			return std::error_code(status, std::system_category());
+		}
+
+		return {};
+	}
+
 	boost::system::result<void> raiseSignal(std::thread::native_handle_type threadId, int signalNumber) {
 		int status = ::pthread_kill(threadId, signalNumber);
 		if (status < 0) {
@@ -27,12 +27,22 @@
 
 #include <boost/url/parse.hpp>
 
+#include <algorithm>
+
 static constexpr const char* const TAG = "SyncDictDao";
 static constexpr const char* const DATABASE_NAME = "dictionary";
 static constexpr const char* const WORD_TABLE_NAME = "word";
 static constexpr const char* const WORD_IMAGE_TABLE_NAME = "word_image";
 static constexpr const char* const USER_NAME = "user";
 static constexpr const char* const PASSWORD = "pass";
+static constexpr std::size_t BATCH_ROW_COUNT = 500;
+static constexpr const char* const SELECT_ALL_WORDS_QUERY = R"xxx(
+	SELECT word.id AS word_id, word.name, word.`index`, word.type,
+		   word_image.id AS word_image_id, word_image.url,
+		   word_image.width, word_image.height
+	FROM word
+	LEFT JOIN word_image ON word.id = word_image.id
+)xxx";
 
 namespace lynx {
 
@@ -49,7 +59,10 @@ namespace lynx {
 		boost::system::error_code errorCode;
 		boost::mysql::diagnostics serverErrorCode;
 
-		mConnection->close(errorCode, serverErrorCode);
+		/* dao which was never started, e.g. of server in fallback mode, has no connection */
+		if (mConnection) {
+			mConnection->close(errorCode, serverErrorCode);
+		}
 
 		if (errorCode) {
 			log::error(TAG, "Connection to db server close with error: %s, %s",
@@ -81,6 +94,7 @@ namespace lynx {
 
 		net::ssl::context sslContext(net::ssl::context::tls_client);
 		mConnection = std::make_unique<db::tcp_ssl_connection>(mContext, sslContext);
+		mPageStatement = db::statement();
 
 		db::handshake_params parameters(USER_NAME, PASSWORD, DATABASE_NAME);
 		mConnection->connect(*endpoints.begin(), parameters, errorCode, serverErrorCode);
@@ -291,6 +305,44 @@ namespace lynx {
 		return {};
 	}
 
+	auto SyncDictDao::executeBatch(const std::string& query, const std::vector<db::field_view>& parameters, db::results& result)
+		-> boost::system::error_code {
+		boost::system::error_code errorCode;
+		db::diagnostics serverErrorCode;
+
+		db::statement statement = mConnection->prepare_statement(query, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't prepare batch statement: %s, %s",
+					   errorCode.message().c_str(), std::string(serverErrorCode.server_message()).c_str());
+			return errorCode;
+		}
+
+		mConnection->execute(statement.bind(parameters.begin(), parameters.end()), result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't execute batch statement: %s, %s",
+					   errorCode.message().c_str(), std::string(serverErrorCode.server_message()).c_str());
+		}
+
+		boost::system::error_code closeErrorCode;
+		mConnection->close_statement(statement, closeErrorCode, serverErrorCode);
+
+		return errorCode;
+	}
+
+	void SyncDictDao::rollback() {
+		boost::system::error_code errorCode;
+		db::diagnostics serverErrorCode;
+		db::results result;
+
+		mConnection->query("ROLLBACK", result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't rollback transaction: %s", errorCode.message().c_str());
+		}
+	}
+
 	auto SyncDictDao::load(const db::row& row) -> boost::system::result<Word, std::string> {
 		Word word;
 
@@ -354,6 +406,156 @@ namespace lynx {
 		return word;
 	}
 
+	auto SyncDictDao::insert(const std::vector<Word>& words) -> boost::system::result<std::vector<uint64_t>> {
+		boost::system::error_code errorCode;
+		db::diagnostics serverErrorCode;
+		db::results result;
+		std::vector<uint64_t> wordIds;
+
+		mConnection->query("START TRANSACTION", result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't start transaction: %s", errorCode.message().c_str());
+			return errorCode;
+		}
+
+		/* concurrent inserts may interleave auto increment values, so every row takes id of its own statement */
+		db::statement wordImageStatement = mConnection->prepare_statement(
+			"INSERT INTO word_image (url, width, height) VALUES (?, ?, ?)", errorCode, serverErrorCode);
+		db::statement wordStatement;
+
+		if (!errorCode) {
+			wordStatement = mConnection->prepare_statement(
+				"INSERT INTO word (id_image, name, `index`, type) VALUES (?, ?, ?, ?)", errorCode, serverErrorCode);
+		}
+
+		wordIds.reserve(words.size());
+
+		for (std::size_t i = 0; i < words.size() && !errorCode; ++i) {
+			const boost::core::string_view url = words[i].image.url.buffer();
+
+			mConnection->execute(wordImageStatement.bind(db::string_view(url.data(), url.size()),
+														 words[i].image.width, words[i].image.height),
+								 result, errorCode, serverErrorCode);
+
+			if (errorCode) {
+				break;
+			}
+
+			const uint64_t wordImageId = result.last_insert_id();
+
+			mConnection->execute(wordStatement.bind(wordImageId, db::string_view(words[i].name), words[i].index,
+													db::string_view(boost::describe::enum_to_string(words[i].type, "NOUN"))),
+								 result, errorCode, serverErrorCode);
+
+			if (errorCode) {
+				break;
+			}
+
+			wordIds.push_back(result.last_insert_id());
+			mLastWordImageId = wordImageId;
+			mLastWordId = wordIds.back();
+		}
+
+		boost::system::error_code closeErrorCode;
+		db::diagnostics closeServerErrorCode;
+
+		for (db::statement* statement : { &wordImageStatement, &wordStatement }) {
+			if (statement->valid()) {
+				mConnection->close_statement(*statement, closeErrorCode, closeServerErrorCode);
+			}
+		}
+
+		if (errorCode) {
+			log::error(TAG, "Can't insert batch of words in table: %s, %s",
+					   errorCode.message().c_str(), std::string(serverErrorCode.server_message()).c_str());
+			rollback();
+			return errorCode;
+		}
+
+		mConnection->query("COMMIT", result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't commit batch of %zu words: %s", words.size(), errorCode.message().c_str());
+			return errorCode;
+		}
+
+		return wordIds;
+	}
+
+	auto SyncDictDao::update(const std::vector<Word>& words) -> boost::system::result<void> {
+		boost::system::error_code errorCode;
+		db::diagnostics serverErrorCode;
+		db::results result;
+
+		mConnection->query("START TRANSACTION", result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't start transaction: %s", errorCode.message().c_str());
+			return errorCode;
+		}
+
+		/* MySQL has no multi-row UPDATE, so rows of batch come as derived table joined by id */
+		for (std::size_t first = 0; first < words.size(); first += BATCH_ROW_COUNT) {
+			const std::size_t last = std::min(first + BATCH_ROW_COUNT, words.size());
+			std::string query = "UPDATE word_image JOIN (";
+			std::vector<db::field_view> parameters;
+			parameters.reserve((last - first) * 5);
+
+			for (std::size_t i = first; i < last; ++i) {
+				const boost::core::string_view url = words[i].image.url.buffer();
+
+				query += (i == first) ? "SELECT ? AS id, ? AS url, ? AS width, ? AS height" : " UNION ALL SELECT ?, ?, ?, ?";
+				parameters.emplace_back(words[i].image.id);
+				parameters.emplace_back(db::string_view(url.data(), url.size()));
+				parameters.emplace_back(words[i].image.width);
+				parameters.emplace_back(words[i].image.height);
+			}
+
+			query += ") AS batch ON word_image.id = batch.id "
+					 "SET word_image.url = batch.url, word_image.width = batch.width, word_image.height = batch.height";
+			errorCode = executeBatch(query, parameters, result);
+
+			if (errorCode) {
+				log::error(TAG, "Can't update batch of word images in table");
+				rollback();
+				return errorCode;
+			}
+
+			query = "UPDATE word JOIN (";
+			parameters.clear();
+
+			for (std::size_t i = first; i < last; ++i) {
+				query += (i == first) ? "SELECT ? AS id, ? AS id_image, ? AS name, ? AS `index`, ? AS type"
+									  : " UNION ALL SELECT ?, ?, ?, ?, ?";
+				parameters.emplace_back(words[i].id);
+				parameters.emplace_back(words[i].image.id);
+				parameters.emplace_back(db::string_view(words[i].name));
+				parameters.emplace_back(words[i].index);
+				parameters.emplace_back(db::string_view(boost::describe::enum_to_string(words[i].type, "NOUN")));
+			}
+
+			query += ") AS batch ON word.id = batch.id "
+					 "SET word.id_image = batch.id_image, word.name = batch.name, word.`index` = batch.`index`, word.type = batch.type";
+			errorCode = executeBatch(query, parameters, result);
+
+			if (errorCode) {
+				log::error(TAG, "Can't update batch of words in table");
+				rollback();
+				return errorCode;
+			}
+		}
+
+		mConnection->query("COMMIT", result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't commit batch of %zu words: %s", words.size(), errorCode.message().c_str());
+			return errorCode;
+		}
+
+		return {};
+	}
+
 	auto SyncDictDao::getById(uint64_t id) -> boost::system::result<Word> {
 		boost::system::error_code errorCode;
 		db::diagnostics serverErrorCode;
@@ -395,14 +597,7 @@ namespace lynx {
 		db::results result;
 		std::vector<Word> words;
 
-		mConnection->query(R"xxx(
-			SELECT word.id AS word_id, word.name, word.`index`, word.type,
-				   word_image.id AS word_image_id, word_image.url,
-				   word_image.width, word_image.height
-			FROM word
-			LEFT JOIN word_image ON word.id = word_image.id
-		)xxx",
-		result, errorCode, serverErrorCode);
+		mConnection->query(SELECT_ALL_WORDS_QUERY, result, errorCode, serverErrorCode);
 
 		if (errorCode) {
 			log::error(TAG, "Can't get all words from table: %s, %s",
@@ -426,5 +621,57 @@ namespace lynx {
 
 		return words;
 	}
-}
 
+	auto SyncDictDao::getPage(uint64_t afterId, std::size_t limit) -> boost::system::result<std::vector<Word>> {
+		boost::system::error_code errorCode;
+		db::diagnostics serverErrorCode;
+		db::results result;
+		std::vector<Word> words;
+
+		/* primary key range scan, so cost of page doesn't grow with its position like OFFSET does */
+		if (!mPageStatement.valid()) {
+			mPageStatement = mConnection->prepare_statement(R"xxx(
+				SELECT word.id AS word_id, word.name, word.`index`, word.type,
+					   word_image.id AS word_image_id, word_image.url,
+					   word_image.width, word_image.height
+				FROM word
+				LEFT JOIN word_image ON word.id = word_image.id
+				WHERE word.id > ?
+				ORDER BY word.id
+				LIMIT ?
+			)xxx", errorCode, serverErrorCode);
+
+			if (errorCode) {
+				log::error(TAG, "Can't prepare page statement: %s, %s",
+						   errorCode.message().c_str(), std::string(serverErrorCode.server_message()).c_str());
+				mPageStatement = db::statement();
+				return errorCode;
+			}
+		}
+
+		mConnection->execute(mPageStatement.bind(afterId, static_cast<uint64_t>(limit)), result, errorCode, serverErrorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't get words after id=%llu from table: %s, %s", static_cast<unsigned long long>(afterId),
+					   errorCode.message().c_str(), std::string(serverErrorCode.server_message()).c_str());
+			return errorCode;
+		}
+
+		const db::rows_view rows = result.rows();
+		words.reserve(rows.size());
+
+		for (db::row_view row : rows) {
+			boost::system::result<Word, std::string> word = load(row);
+
+			if (word.has_error()) {
+				log::error(TAG, "Load words after id=%llu error: %s", static_cast<unsigned long long>(afterId),
+						   word.error().c_str());
+				return std::make_error_code(std::errc::bad_message);
+			}
+
+			words.push_back(std::move(*word));
+		}
+
+		return words;
+	}
+}
@@ -47,17 +47,99 @@ namespace lynx {
 
 	    if (error) return error;
 
-	    return boost::json::value_to<Word>(value);
+	    try {
+	    	return boost::json::value_to<Word>(value);
+	    } catch (...) {
+	    	return std::make_error_code(std::errc::invalid_argument);
+	    }
     }
 
     auto JsonParser::serializeWordsToText(const std::vector<Word>& words) -> boost::system::result<std::string> {
-    	//FIXME: implement in future
-		return {};
+    	try {
+    		return boost::json::serialize(boost::json::value_from(words));
+    	} catch (...) {
+    		return std::make_error_code(std::errc::not_enough_memory);
+    	}
     }
 
     auto JsonParser::deserializeWordsFromText(const std::string& input) -> boost::system::result<std::vector<Word>> {
-    	//FIXME: implement in future
-    	return {};
+    	std::error_code error;
+
+	    boost::json::value value = boost::json::parse(input, error);
+
+	    if (error) return error;
+
+	    if (!value.is_array()) return std::make_error_code(std::errc::invalid_argument);
+
+	    /* reply comes from other side, so malformed element is an error instead of exception */
+	    try {
+	    	return boost::json::value_to<std::vector<Word>>(value);
+	    } catch (...) {
+	    	return std::make_error_code(std::errc::invalid_argument);
+	    }
+    }
+
+    auto JsonParser::deserializeWordBatchFromText(const std::string& input)
+    	-> boost::system::result<std::vector<boost::system::result<Word>>> {
+    	std::error_code error;
+
+	    boost::json::value value = boost::json::parse(input, error);
+
+	    if (error) return error;
+
+	    if (!value.is_array()) return std::make_error_code(std::errc::invalid_argument);
+
+	    std::vector<boost::system::result<Word>> words;
+	    words.reserve(value.as_array().size());
+
+	    for (const boost::json::value& element : value.as_array()) {
+	    	try {
+	    		words.emplace_back(boost::json::value_to<Word>(element));
+	    	} catch (...) {
+	    		words.emplace_back(std::make_error_code(std::errc::invalid_argument));
+	    	}
+	    }
+
+	    return words;
+    }
+
+    auto JsonParser::serializeStatusesToText(const std::vector<WordStatus>& statuses) -> boost::system::result<std::string> {
+    	try {
+    		boost::json::array array;
+    		array.reserve(statuses.size());
+
+    		for (const WordStatus& status : statuses) {
+    			array.push_back({ { "id", status.id }, { "success", status.success }, { "message", status.message } });
+    		}
+
+    		return boost::json::serialize(array);
+    	} catch (...) {
+    		return std::make_error_code(std::errc::not_enough_memory);
+    	}
+    }
+
+    auto JsonParser::deserializeStatusesFromText(const std::string& input) -> boost::system::result<std::vector<WordStatus>> {
+    	std::error_code error;
+
+	    boost::json::value value = boost::json::parse(input, error);
+
+	    if (error) return error;
+
+	    if (!value.is_array()) return std::make_error_code(std::errc::invalid_argument);
+
+	    std::vector<WordStatus> statuses;
+
+	    try {
+	    	for (const boost::json::value& element : value.as_array()) {
+	    		const boost::json::object& object = element.as_object();
+	    		statuses.push_back({ boost::json::value_to<uint64_t>(object.at("id")), object.at("success").as_bool(),
+	    							 boost::json::value_to<std::string>(object.at("message")) });
+	    	}
+	    } catch (...) {
+	    	return std::make_error_code(std::errc::invalid_argument);
+	    }
+
+	    return statuses;
     }
 
     auto JsonParser::serializeToFile(const std::string& fileName, const Word& word) -> boost::system::result<void> {
@@ -0,0 +1,426 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "format/JsonWordParser.hpp"
+
+#include <boost/describe/enumerators.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/url/parse.hpp>
+
+#include <limits>
+
+namespace lynx {
+	namespace {
+		constexpr uint32_t fieldBit(uint32_t field) { return 1u << field; }
+
+		enum FieldBit : uint32_t {
+			ID_BIT = fieldBit(0),
+			NAME_BIT = fieldBit(1),
+			INDEX_BIT = fieldBit(2),
+			TYPE_BIT = fieldBit(3),
+			IMAGE_BIT = fieldBit(4),
+			URL_BIT = fieldBit(5),
+			WIDTH_BIT = fieldBit(6),
+			HEIGHT_BIT = fieldBit(7)
+		};
+
+		/* Image id is absent in macro reflection form, so it isn't required */
+		constexpr uint32_t REQUIRED_FIELDS = ID_BIT | NAME_BIT | INDEX_BIT | TYPE_BIT | IMAGE_BIT |
+											 URL_BIT | WIDTH_BIT | HEIGHT_BIT;
+
+		/* Numbers between enumerators fit underlying type too, yet name no word type */
+		bool isWordType(uint64_t value) {
+			bool found = false;
+
+			boost::mp11::mp_for_each<boost::describe::describe_enumerators<WordType>>([value, &found](auto enumerator) {
+				found = found || static_cast<uint64_t>(enumerator.value) == value;
+			});
+
+			return found;
+		}
+
+		auto invalidArgument() -> boost::system::error_code {
+			return boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+		}
+	}
+
+	bool JsonWordHandler::on_document_begin(boost::system::error_code&) {
+		mWords.clear();
+		mKey.clear();
+		mField = Field::NONE;
+		mDepth = 0;
+		mSkipDepth = 0;
+		mBatch = false;
+		mInImage = false;
+
+		return true;
+	}
+
+	bool JsonWordHandler::on_document_end(boost::system::error_code&) {
+		return true;
+	}
+
+	bool JsonWordHandler::on_object_begin(boost::system::error_code&) {
+		if (mSkipDepth > 0) {
+			++mSkipDepth;
+			return true;
+		}
+
+		if (isRootValue() || isBatchElement()) {
+			startWord();
+		} else if (mField == Field::IMAGE && !mInImage) {
+			mFoundFields |= IMAGE_BIT;
+			mInImage = true;
+		} else {
+			if (mField != Field::UNKNOWN) failField();
+			mSkipDepth = 1;
+			return true;
+		}
+
+		++mDepth;
+		mField = Field::NONE;
+		return true;
+	}
+
+	bool JsonWordHandler::on_object_end(std::size_t, boost::system::error_code&) {
+		if (mSkipDepth > 0) {
+			--mSkipDepth;
+			mField = Field::NONE;
+			return true;
+		}
+
+		--mDepth;
+		mField = Field::NONE;
+
+		if (mInImage) {
+			mInImage = false;
+		} else {
+			finishWord();
+		}
+
+		return true;
+	}
+
+	bool JsonWordHandler::on_array_begin(boost::system::error_code&) {
+		if (mSkipDepth > 0) {
+			++mSkipDepth;
+			return true;
+		}
+
+		if (isRootValue()) {
+			mBatch = true;
+			++mDepth;
+			return true;
+		}
+
+		if (isBatchElement()) {
+			mWords.emplace_back(invalidArgument());
+		} else if (mField != Field::UNKNOWN) {
+			failField();
+		}
+
+		mSkipDepth = 1;
+		return true;
+	}
+
+	bool JsonWordHandler::on_array_end(std::size_t, boost::system::error_code&) {
+		if (mSkipDepth > 0) {
+			--mSkipDepth;
+			mField = Field::NONE;
+		} else {
+			--mDepth;
+		}
+
+		return true;
+	}
+
+	bool JsonWordHandler::on_key_part(boost::json::string_view part, std::size_t, boost::system::error_code&) {
+		if (mSkipDepth == 0) mKey.append(part.data(), part.size());
+
+		return true;
+	}
+
+	bool JsonWordHandler::on_key(boost::json::string_view part, std::size_t, boost::system::error_code&) {
+		if (mSkipDepth > 0) return true;
+
+		mKey.append(part.data(), part.size());
+
+		if (mInImage) {
+			if (mKey == "id") mField = Field::IMAGE_ID;
+			else if (mKey == "url") mField = Field::URL;
+			else if (mKey == "width") mField = Field::WIDTH;
+			else if (mKey == "height") mField = Field::HEIGHT;
+			else mField = Field::UNKNOWN;
+		} else {
+			if (mKey == "id") mField = Field::ID;
+			else if (mKey == "name") mField = Field::NAME;
+			else if (mKey == "index") mField = Field::INDEX;
+			else if (mKey == "type") mField = Field::TYPE;
+			else if (mKey == "image") mField = Field::IMAGE;
+			else mField = Field::UNKNOWN;
+		}
+
+		if (mField == Field::NAME) mWord.name.clear();
+		if (mField == Field::URL) mUrl.clear();
+
+		mKey.clear();
+		return true;
+	}
+
+	bool JsonWordHandler::on_string_part(boost::json::string_view part, std::size_t, boost::system::error_code&) {
+		if (mSkipDepth > 0) return true;
+
+		if (mField == Field::NAME) mWord.name.append(part.data(), part.size());
+		else if (mField == Field::URL) mUrl.append(part.data(), part.size());
+
+		return true;
+	}
+
+	bool JsonWordHandler::on_string(boost::json::string_view part, std::size_t, boost::system::error_code& errorCode) {
+		if (mSkipDepth > 0) return true;
+
+		if (isRootValue()) {
+			errorCode = invalidArgument();
+			return false;
+		}
+
+		if (isBatchElement()) {
+			mWords.emplace_back(invalidArgument());
+			return true;
+		}
+
+		if (mField == Field::NAME) {
+			mWord.name.append(part.data(), part.size());
+			mFoundFields |= NAME_BIT;
+		} else if (mField == Field::URL) {
+			mUrl.append(part.data(), part.size());
+
+			auto url = boost::urls::parse_uri(mUrl);
+			mWord.image.url = url ? boost::urls::url(*url) : boost::urls::url("http://unknown.org");
+			mFoundFields |= URL_BIT;
+		} else if (mField != Field::UNKNOWN) {
+			failField();
+		}
+
+		mField = Field::NONE;
+		return true;
+	}
+
+	bool JsonWordHandler::on_number_part(boost::json::string_view, boost::system::error_code&) {
+		return true;
+	}
+
+	bool JsonWordHandler::on_int64(int64_t value, boost::json::string_view, boost::system::error_code& errorCode) {
+		if (mSkipDepth > 0) return true;
+
+		if (isRootValue()) {
+			errorCode = invalidArgument();
+			return false;
+		}
+
+		if (isBatchElement()) {
+			mWords.emplace_back(invalidArgument());
+			return true;
+		}
+
+		assignInteger(value);
+		return true;
+	}
+
+	bool JsonWordHandler::on_uint64(uint64_t value, boost::json::string_view, boost::system::error_code& errorCode) {
+		if (mSkipDepth > 0) return true;
+
+		if (isRootValue()) {
+			errorCode = invalidArgument();
+			return false;
+		}
+
+		if (isBatchElement()) {
+			mWords.emplace_back(invalidArgument());
+			return true;
+		}
+
+		assignUnsigned(value);
+		return true;
+	}
+
+	bool JsonWordHandler::on_double(double, boost::json::string_view, boost::system::error_code& errorCode) {
+		return on_null(errorCode);
+	}
+
+	bool JsonWordHandler::on_bool(bool, boost::system::error_code& errorCode) {
+		return on_null(errorCode);
+	}
+
+	bool JsonWordHandler::on_null(boost::system::error_code& errorCode) {
+		if (mSkipDepth > 0) return true;
+
+		if (isRootValue()) {
+			errorCode = invalidArgument();
+			return false;
+		}
+
+		if (isBatchElement()) {
+			mWords.emplace_back(invalidArgument());
+			return true;
+		}
+
+		if (mField != Field::UNKNOWN) failField();
+
+		mField = Field::NONE;
+		return true;
+	}
+
+	bool JsonWordHandler::on_comment_part(boost::json::string_view, boost::system::error_code&) {
+		return true;
+	}
+
+	bool JsonWordHandler::on_comment(boost::json::string_view, boost::system::error_code&) {
+		return true;
+	}
+
+	bool JsonWordHandler::isBatch() const {
+		return mBatch;
+	}
+
+	auto JsonWordHandler::releaseWords() -> std::vector<boost::system::result<Word>> {
+		return std::move(mWords);
+	}
+
+	void JsonWordHandler::startWord() {
+		mWord = Word{};
+		mUrl.clear();
+		mFoundFields = 0;
+		mWordFailed = false;
+		mInImage = false;
+	}
+
+	void JsonWordHandler::finishWord() {
+		if (mWordFailed || (mFoundFields & REQUIRED_FIELDS) != REQUIRED_FIELDS) {
+			mWords.emplace_back(invalidArgument());
+		} else {
+			mWords.emplace_back(std::move(mWord));
+		}
+	}
+
+	void JsonWordHandler::failField() {
+		mWordFailed = true;
+	}
+
+	void JsonWordHandler::assignInteger(int64_t value) {
+		if (value >= 0) {
+			assignUnsigned(static_cast<uint64_t>(value));
+			return;
+		}
+
+		if ((mField == Field::WIDTH || mField == Field::HEIGHT) && value >= std::numeric_limits<int32_t>::min()) {
+			(mField == Field::WIDTH ? mWord.image.width : mWord.image.height) = static_cast<int32_t>(value);
+			mFoundFields |= (mField == Field::WIDTH ? WIDTH_BIT : HEIGHT_BIT);
+		} else if (mField != Field::UNKNOWN) {
+			failField();
+		}
+
+		mField = Field::NONE;
+	}
+
+	void JsonWordHandler::assignUnsigned(uint64_t value) {
+		constexpr auto MAX_INT32 = static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+
+		switch (mField) {
+		case Field::ID:
+			mWord.id = value;
+			mFoundFields |= ID_BIT;
+			break;
+		case Field::INDEX:
+			mWord.index = value;
+			mFoundFields |= INDEX_BIT;
+			break;
+		case Field::IMAGE_ID:
+			mWord.image.id = value;
+			break;
+		case Field::TYPE:
+			if (!isWordType(value)) {
+				failField();
+				break;
+			}
+			mWord.type = static_cast<WordType>(value);
+			mFoundFields |= TYPE_BIT;
+			break;
+		case Field::WIDTH:
+		case Field::HEIGHT:
+			if (value > MAX_INT32) {
+				failField();
+				break;
+			}
+			(mField == Field::WIDTH ? mWord.image.width : mWord.image.height) = static_cast<int32_t>(value);
+			mFoundFields |= (mField == Field::WIDTH ? WIDTH_BIT : HEIGHT_BIT);
+			break;
+		case Field::UNKNOWN:
+			break;
+		default:
+			failField();
+			break;
+		}
+
+		mField = Field::NONE;
+	}
+
+	bool JsonWordHandler::isBatchElement() const {
+		return mSkipDepth == 0 && mBatch && mDepth == 1;
+	}
+
+	bool JsonWordHandler::isRootValue() const {
+		return mSkipDepth == 0 && mDepth == 0;
+	}
+
+	JsonWordParser::JsonWordParser()
+		: mParser(boost::json::parse_options{}) {}
+
+	JsonWordParser::~JsonWordParser() {}
+
+	auto JsonWordParser::write(std::string_view input) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+
+		mParser.write_some(true, input.data(), input.size(), errorCode);
+
+		return errorCode;
+	}
+
+	auto JsonWordParser::finish() -> boost::system::error_code {
+		boost::system::error_code errorCode;
+
+		mParser.write_some(false, nullptr, 0, errorCode);
+
+		return errorCode;
+	}
+
+	bool JsonWordParser::isBatch() const {
+		return mParser.handler().isBatch();
+	}
+
+	auto JsonWordParser::releaseWords() -> std::vector<boost::system::result<Word>> {
+		return mParser.handler().releaseWords();
+	}
+}
@@ -99,7 +99,7 @@ namespace lynx {
 		}
 	}
 
-	auto ProtobufParser::deserializeFromBuffer(const std::vector<std::byte>& buffer) -> boost::system::result<Word> {
+	auto ProtobufParser::deserializeFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<Word> {
 		pb::RemoteWord remoteWord;
 
 		if (remoteWord.ParseFromArray(buffer.data(), static_cast<int32_t>(buffer.size()))) {
@@ -109,6 +109,103 @@ namespace lynx {
 		}
 	}
 
+	auto ProtobufParser::serializeWordsToBuffer(const std::vector<Word>& words) -> boost::system::result<std::vector<std::byte>> {
+		rpc::ListWordsResponse remoteWords;
+
+		for (const Word& word : words) {
+			*remoteWords.add_words() = convert(word);
+		}
+
+		const size_t bufferSize = remoteWords.ByteSizeLong();
+		std::vector<std::byte> buffer(bufferSize);
+
+		if (remoteWords.SerializeToArray(buffer.data(), static_cast<int32_t>(bufferSize))) {
+			return buffer;
+		} else {
+			return std::make_error_code(std::errc::io_error);
+		}
+	}
+
+	auto ProtobufParser::deserializeWordsFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<std::vector<Word>> {
+		rpc::ListWordsResponse remoteWords;
+		std::vector<Word> words;
+
+		if (!remoteWords.ParseFromArray(buffer.data(), static_cast<int32_t>(buffer.size()))) {
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		words.reserve(remoteWords.words_size());
+
+		for (const pb::RemoteWord& remoteWord : remoteWords.words()) {
+			words.push_back(convert(remoteWord));
+		}
+
+		return words;
+	}
+
+	auto ProtobufParser::serializeStatusesToBuffer(const std::vector<WordStatus>& statuses)
+		-> boost::system::result<std::vector<std::byte>> {
+		rpc::ListWordStatusesResponse remoteStatuses;
+
+		for (const WordStatus& status : statuses) {
+			rpc::RemoteWordStatus* remoteStatus = remoteStatuses.add_statuses();
+			remoteStatus->set_id(status.id);
+			remoteStatus->set_success(status.success);
+			remoteStatus->set_message(status.message);
+		}
+
+		const size_t bufferSize = remoteStatuses.ByteSizeLong();
+		std::vector<std::byte> buffer(bufferSize);
+
+		if (remoteStatuses.SerializeToArray(buffer.data(), static_cast<int32_t>(bufferSize))) {
+			return buffer;
+		} else {
+			return std::make_error_code(std::errc::io_error);
+		}
+	}
+
+	auto ProtobufParser::deserializeStatusesFromBuffer(std::span<const std::byte> buffer)
+		-> boost::system::result<std::vector<WordStatus>> {
+		rpc::ListWordStatusesResponse remoteStatuses;
+		std::vector<WordStatus> statuses;
+
+		if (!remoteStatuses.ParseFromArray(buffer.data(), static_cast<int32_t>(buffer.size()))) {
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		statuses.reserve(remoteStatuses.statuses_size());
+
+		for (const rpc::RemoteWordStatus& remoteStatus : remoteStatuses.statuses()) {
+			statuses.push_back({ remoteStatus.id(), remoteStatus.success(), remoteStatus.message() });
+		}
+
+		return statuses;
+	}
+
+	auto ProtobufParser::serializeIdToBuffer(uint64_t id) -> boost::system::result<std::vector<std::byte>> {
+		rpc::WordIdRequest remoteWordId;
+		remoteWordId.set_id(id);
+
+		const size_t bufferSize = remoteWordId.ByteSizeLong();
+		std::vector<std::byte> buffer(bufferSize);
+
+		if (remoteWordId.SerializeToArray(buffer.data(), static_cast<int32_t>(bufferSize))) {
+			return buffer;
+		} else {
+			return std::make_error_code(std::errc::io_error);
+		}
+	}
+
+	auto ProtobufParser::deserializeIdFromBuffer(std::span<const std::byte> buffer) -> boost::system::result<uint64_t> {
+		rpc::WordIdRequest remoteWordId;
+
+		if (remoteWordId.ParseFromArray(buffer.data(), static_cast<int32_t>(buffer.size()))) {
+			return remoteWordId.id();
+		} else {
+			return std::make_error_code(std::errc::io_error);
+		}
+	}
+
 	auto ProtobufParser::convert(WordType wordType) -> pb::RemoteWordType {
 		switch (wordType) {
 		case WordType::NOUN:
@@ -24,6 +24,7 @@
 
 #include "format/XmlParser.hpp"
 #include "format/XmlUrlTranslator.hpp"
+#include "util/StringUtils.hpp"
 
 #include <boost/archive/xml_iarchive.hpp>
 #include <boost/archive/xml_oarchive.hpp>
@@ -50,8 +51,9 @@ namespace lynx {
 		return stream.str();
 	}
 
-	auto XmlParser::deserializeFromText(const std::string& text) -> boost::system::result<Word> {
-		std::istringstream stream(text);
+	auto XmlParser::deserializeFromText(std::string_view text) -> boost::system::result<Word> {
+		StringViewBuffer buffer(text);
+		std::istream stream(&buffer);
 
 		mWordTree.clear();
 
@@ -81,8 +83,9 @@ namespace lynx {
 		return stream.str();
 	}
 
-	auto XmlParser::deserializeWordsFromText(const std::string& text) -> boost::system::result<std::vector<Word>> {
-		std::istringstream stream(text);
+	auto XmlParser::deserializeWordsFromText(std::string_view text) -> boost::system::result<std::vector<Word>> {
+		StringViewBuffer buffer(text);
+		std::istream stream(&buffer);
 
 		mWordTree.clear();
 		mWordsTree.clear();
@@ -0,0 +1,394 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/AsyncHttpDictServer.hpp"
+#include "net/NetworkUtils.hpp"
+#include "logging/Logging.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <optional>
+
+static constexpr const char* const TAG = "AsyncHttpDictServer";
+
+namespace lynx {
+
+	AsyncHttpDictServer::AsyncHttpDictServer(const std::string& host, uint16_t port, const ReactorOptions& options,
+											 const SessionLimits& limits, const CompressionOptions& compression, const DumpOptions& dump)
+		: mPort(port)
+		, mLimits(limits)
+		, mReactors(options)
+		, mDictDao(host)
+		, mHandler(mDictDao, mDictDaoMutex, compression, dump)
+		, mDumper(mDictDao, mDictDaoMutex, dump)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+	}
+
+	AsyncHttpDictServer::~AsyncHttpDictServer() {
+		stop();
+		log::info(TAG, "Destroy server");
+	}
+
+	bool AsyncHttpDictServer::isStarted() const { return mStarted; }
+
+	void AsyncHttpDictServer::start() {
+		const ReactorOptions& options = mReactors.getOptions();
+		log::info(TAG, "Start server with %u threads, %u contexts", options.threadCount, mReactors.getContextCount());
+
+		mDictDao.start();
+		mDumper.start();
+
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			/* in sharded mode every context accepts on its own socket bound to same port */
+			for (uint32_t i = 0; i < mReactors.getContextCount(); ++i) {
+				mAcceptors.emplace_back(mReactors.getContext(i));
+				boost::system::error_code errorCode = openAcceptor(mAcceptors.back());
+
+				if (errorCode) {
+					log::error(TAG, "Can't listen on port %u: %s", mPort, errorCode.message().c_str());
+					mAcceptors.clear();
+					mDumper.stop();
+					mDictDao.stop();
+					return;
+				}
+			}
+
+			mStarted = true;
+
+			for (net::ip::tcp::acceptor& acceptor : mAcceptors) {
+				net::co_spawn(acceptor.get_executor(), acceptClients(acceptor), net::detached);
+			}
+		}
+
+		/* contexts stopped before run keep stopped state, so stop which came after lock above isn't lost */
+		mReactors.run();
+
+		std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+		mAcceptors.clear();
+	}
+
+	void AsyncHttpDictServer::stop() {
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+
+			mReactors.stop();
+		}
+
+		mDumper.stop();
+		mDictDao.stop();
+		log::info(TAG, "Stop server");
+	}
+
+	auto AsyncHttpDictServer::openAcceptor(net::ip::tcp::acceptor& acceptor) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		net::ip::tcp::endpoint endpoint(net::ip::tcp::v4(), mPort);
+
+		acceptor.open(endpoint.protocol(), errorCode);
+
+		if (!errorCode) {
+			acceptor.set_option(net::ip::tcp::acceptor::reuse_address(true), errorCode);
+		}
+		if (!errorCode && mReactors.getContextCount() > 1) {
+			acceptor.set_option(reuse_port(true), errorCode);
+		}
+		if (!errorCode) {
+			acceptor.bind(endpoint, errorCode);
+		}
+		if (!errorCode) {
+			acceptor.listen(net::socket_base::max_listen_connections, errorCode);
+		}
+
+		return errorCode;
+	}
+
+	auto AsyncHttpDictServer::acceptClients(net::ip::tcp::acceptor& acceptor) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+
+		while (mStarted) {
+			/* socket is bound to strand of its own, so session handlers never run concurrently */
+			net::ip::tcp::socket socket = co_await acceptor.async_accept(net::make_strand(acceptor.get_executor()),
+					net::redirect_error(net::use_awaitable, errorCode));
+
+			if (errorCode) {
+				log::error(TAG, "Can't accept client: %s", errorCode.message().c_str());
+
+				if (errorCode == net::error::operation_aborted) {
+					co_return;
+				}
+				continue;
+			}
+
+			log::debug(TAG, "Accept client %s", socket.remote_endpoint(errorCode).address().to_string().c_str());
+
+			auto strand = socket.get_executor();
+			net::co_spawn(strand, processSession(std::move(socket)), net::detached);
+		}
+	}
+
+	auto AsyncHttpDictServer::processSession(net::ip::tcp::socket socket) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+		beast::tcp_stream stream(std::move(socket));
+		beast::flat_buffer buffer;
+
+		while (mStarted) {
+			http::request_parser<http::string_body> parser;
+			std::optional<http::request_parser<JsonWordBody>> wordParser;
+			parser.body_limit(mLimits.maxMessageSize);
+
+			/* stream closes socket once deadline passes, idle client has longer to start request than to finish it */
+			stream.expires_after(mLimits.idleTimeout);
+			co_await http::async_read_header(stream, buffer, parser, net::redirect_error(net::use_awaitable, errorCode));
+			const uint32_t version = parser.get().version();
+			const boost::core::string_view target = parser.get().target();
+			const HttpRouteMatch match = matchRoute(parser.get().method(), std::string_view(target.data(), target.size()));
+
+			const boost::core::string_view contentType = parser.get()[http::field::content_type];
+			const ContentFormat contentFormat = parseFormat(std::string_view(contentType.data(), contentType.size()))
+				.value_or(ContentFormat::JSON);
+
+			/* json word bodies are parsed while they arrive, other routes and protobuf keep string body */
+			if (!errorCode && JSON_WORD_STREAMING && isWordRoute(match.route) && contentFormat == ContentFormat::JSON) {
+				wordParser.emplace(std::move(parser));
+				wordParser->body_limit(mLimits.maxMessageSize);
+
+				if (!wordParser->is_done()) {
+					stream.expires_after(mLimits.readTimeout);
+					co_await http::async_read(stream, buffer, *wordParser, net::redirect_error(net::use_awaitable, errorCode));
+				}
+			} else if (!errorCode && !parser.is_done()) {
+				stream.expires_after(mLimits.readTimeout);
+				co_await http::async_read(stream, buffer, parser, net::redirect_error(net::use_awaitable, errorCode));
+			}
+
+			if (errorCode == http::error::end_of_stream) {
+				log::debug(TAG, "Client closed connection");
+				break;
+			} else if (errorCode == http::error::body_limit) {
+				/* rest of body is never read, so connection can't be reused */
+				log::error(TAG, "Received request exceeds %zu bytes", mLimits.maxMessageSize);
+				stream.expires_after(mLimits.writeTimeout);
+				co_await beast::async_write(stream, http::message_generator(mHandler.prepareResponse("Request body exceeds limit",
+						http::status::payload_too_large, version, false)), net::redirect_error(net::use_awaitable, errorCode));
+				break;
+			} else if (errorCode) {
+				log::error(TAG, "Received request isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			const bool keepAlive = wordParser ? wordParser->get().keep_alive() : parser.get().keep_alive();
+
+			if (match.route == HttpRoute::GET_ALL) {
+				errorCode = co_await streamWords(stream, parser.get());
+			} else if (match.route == HttpRoute::GET_DUMP) {
+				errorCode = co_await sendDump(stream, parser.get());
+			} else {
+				std::unique_ptr<http::message_generator> response = wordParser ? routeRequest(wordParser->release(), match)
+																			  : routeRequest(parser.release(), match);
+
+				stream.expires_after(mLimits.writeTimeout);
+				co_await beast::async_write(stream, std::move(*response), net::redirect_error(net::use_awaitable, errorCode));
+			}
+
+			if (errorCode) {
+				log::error(TAG, "Send response isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			if (!keepAlive) {
+				log::debug(TAG, "Close connection without keep alive");
+				break;
+			}
+		}
+
+		stream.socket().shutdown(net::socket_base::shutdown_send, errorCode);
+	}
+
+	auto AsyncHttpDictServer::routeRequest(http::request<JsonWordBody>&& request, const HttpRouteMatch& match)
+		-> std::unique_ptr<http::message_generator> {
+		switch (match.route) {
+		case HttpRoute::POST_WORD:
+			return mHandler.handlePostRequest(std::move(request));
+		case HttpRoute::PUT_WORD:
+			return mHandler.handlePutRequest(std::move(request));
+		case HttpRoute::POST_WORDS:
+			return mHandler.handlePostBatchRequest(std::move(request));
+		case HttpRoute::PUT_WORDS:
+			return mHandler.handlePutBatchRequest(std::move(request));
+		default:
+			break;
+		}
+
+		log::error(TAG, "Received unknown http request");
+		return std::make_unique<http::message_generator>(mHandler.prepareResponse("Unknown request",
+				http::status::not_found, request.version(), request.keep_alive()));
+	}
+
+	auto AsyncHttpDictServer::routeRequest(http::request<http::string_body>&& request, const HttpRouteMatch& match)
+		-> std::unique_ptr<http::message_generator> {
+		switch (match.route) {
+		case HttpRoute::POST_WORD:
+		case HttpRoute::PUT_WORD:
+			return routeRequest(mHandler.decodeWordRequest(std::move(request), false), match);
+		case HttpRoute::POST_WORDS:
+		case HttpRoute::PUT_WORDS:
+			return routeRequest(mHandler.decodeWordRequest(std::move(request), true), match);
+		case HttpRoute::DELETE_WORD:
+			return mHandler.handleDeleteRequest(std::move(request), match.wordId);
+		case HttpRoute::GET_PAGE:
+			return mHandler.handleGetPageRequest(std::move(request));
+		case HttpRoute::GET_WORD:
+			return mHandler.handleGetByIdRequest(std::move(request), match.wordId);
+		default:
+			break;
+		}
+
+		log::error(TAG, "Received unknown http request");
+		return std::make_unique<http::message_generator>(mHandler.prepareResponse("Unknown request",
+				http::status::not_found, request.version(), request.keep_alive()));
+	}
+
+	auto AsyncHttpDictServer::streamWords(beast::tcp_stream& stream, const http::request<http::string_body>& request)
+		-> net::awaitable<boost::system::error_code> {
+		boost::system::error_code errorCode;
+		WordStreamCursor cursor;
+		http::response<http::buffer_body> response = mHandler.prepareStreamResponse(request, cursor);
+		boost::system::result<std::string> piece = mHandler.readWordStream(cursor);
+
+		if (piece.has_error()) {
+			stream.expires_after(mLimits.writeTimeout);
+			co_await beast::async_write(stream, http::message_generator(mHandler.prepareResponse("Db get all words error",
+					http::status::internal_server_error, request.version(), request.keep_alive())),
+					net::redirect_error(net::use_awaitable, errorCode));
+			co_return errorCode;
+		}
+
+		http::response_serializer<http::buffer_body> serializer(response);
+
+		while (true) {
+			/* empty chunk would end body, and compressor may keep whole piece in its buffer */
+			if (!piece->empty()) {
+				response.body().data = piece->data();
+				response.body().size = piece->size();
+				response.body().more = true;
+
+				/* need_buffer means that piece is sent and serializer waits for next one */
+				stream.expires_after(mLimits.writeTimeout);
+				co_await http::async_write(stream, serializer, net::redirect_error(net::use_awaitable, errorCode));
+
+				if (errorCode != http::error::need_buffer) {
+					co_return errorCode;
+				}
+			}
+
+			if (cursor.finished) {
+				break;
+			}
+
+			piece = mHandler.readWordStream(cursor);
+
+			if (piece.has_error()) {
+				/* status line is already sent, so only unfinished chunked body tells client that response is broken */
+				co_return piece.error();
+			}
+		}
+
+		response.body().data = nullptr;
+		response.body().size = 0;
+		response.body().more = false;
+
+		stream.expires_after(mLimits.writeTimeout);
+		co_await http::async_write(stream, serializer, net::redirect_error(net::use_awaitable, errorCode));
+
+		co_return errorCode;
+	}
+
+	auto AsyncHttpDictServer::sendDump(beast::tcp_stream& stream, const http::request<http::string_body>& request)
+		-> net::awaitable<boost::system::error_code> {
+		boost::system::error_code errorCode;
+		DumpFile dump;
+		std::unique_ptr<http::message_generator> response = mHandler.handleDumpRequest(request, dump);
+
+		if (response) {
+			stream.expires_after(mLimits.writeTimeout);
+			co_await beast::async_write(stream, std::move(*response), net::redirect_error(net::use_awaitable, errorCode));
+			co_return errorCode;
+		}
+
+		http::response_serializer<http::file_body> serializer(dump.response);
+
+		/* serializer stops after header, its own body writer would read file through user space buffer */
+		serializer.split(true);
+		stream.expires_after(mLimits.writeTimeout);
+		co_await http::async_write_header(stream, serializer, net::redirect_error(net::use_awaitable, errorCode));
+
+		if (errorCode) {
+			co_return errorCode;
+		}
+
+		/* wait on raw socket isn't bounded by stream, so timer cancels it once peer stalls */
+		net::ip::tcp::socket& socket = stream.socket();
+		net::steady_timer timer(socket.get_executor());
+		const int fileFd = dump.response.body().file().native_handle();
+		/* expiry queued just as wait completed can't be cancelled, so it acts only while its own wait is current */
+		auto waitCount = std::make_shared<uint64_t>(0);
+
+		stream.expires_never();
+		socket.native_non_blocking(true, errorCode);
+
+		while (!errorCode && dump.size != 0) {
+			errorCode = sendFile(socket.native_handle(), fileFd, dump.offset, dump.size);
+
+			if (errorCode == net::error::would_block) {
+				timer.expires_after(mLimits.writeTimeout);
+				timer.async_wait([&socket, waitCount, waitIndex = *waitCount](boost::system::error_code timerError) {
+					if (!timerError && *waitCount == waitIndex) {
+						socket.cancel();
+					}
+				});
+
+				co_await socket.async_wait(net::socket_base::wait_write, net::redirect_error(net::use_awaitable, errorCode));
+				++*waitCount;
+				timer.cancel();
+			}
+		}
+
+		if (errorCode == net::error::operation_aborted) {
+			co_return net::error::timed_out;
+		}
+
+		co_return errorCode;
+	}
+}
@@ -0,0 +1,194 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpCompression.hpp"
+#include "http/HttpContentFormat.hpp"
+#include "util/StringUtils.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace io = boost::iostreams;
+
+namespace lynx {
+
+	auto negotiateCoding(std::string_view acceptEncoding) -> ContentCoding {
+		uint32_t gzipQuality = 0;
+		uint32_t deflateQuality = 0;
+		uint32_t anyQuality = 0;
+		bool gzipListed = false;
+		bool deflateListed = false;
+
+		while (!acceptEncoding.empty()) {
+			const std::size_t separator = acceptEncoding.find(',');
+			const std::string_view element = acceptEncoding.substr(0, separator);
+			acceptEncoding = (separator == std::string_view::npos) ? std::string_view{} : acceptEncoding.substr(separator + 1);
+
+			const std::size_t parametersSeparator = element.find(';');
+			const std::string_view coding = trim(element.substr(0, parametersSeparator));
+			const uint32_t quality = (parametersSeparator == std::string_view::npos) ? 1000 : parseQuality(element.substr(parametersSeparator + 1));
+
+			if (equalsIgnoreCase(coding, "gzip") || equalsIgnoreCase(coding, "x-gzip")) {
+				gzipQuality = quality;
+				gzipListed = true;
+			} else if (equalsIgnoreCase(coding, "deflate")) {
+				deflateQuality = quality;
+				deflateListed = true;
+			} else if (coding == "*") {
+				anyQuality = quality;
+			}
+		}
+
+		/* coding matched only by wildcard gets its q-value */
+		gzipQuality = gzipListed ? gzipQuality : anyQuality;
+		deflateQuality = deflateListed ? deflateQuality : anyQuality;
+
+		if (gzipQuality != 0 && gzipQuality >= deflateQuality) {
+			return ContentCoding::GZIP;
+		} else if (deflateQuality != 0) {
+			return ContentCoding::DEFLATE;
+		}
+
+		return ContentCoding::IDENTITY;
+	}
+
+	auto parseCoding(std::string_view contentEncoding) -> ContentCoding {
+		contentEncoding = trim(contentEncoding);
+
+		if (equalsIgnoreCase(contentEncoding, "gzip") || equalsIgnoreCase(contentEncoding, "x-gzip")) {
+			return ContentCoding::GZIP;
+		} else if (equalsIgnoreCase(contentEncoding, "deflate")) {
+			return ContentCoding::DEFLATE;
+		}
+
+		return ContentCoding::IDENTITY;
+	}
+
+	auto toString(ContentCoding coding) -> const char* {
+		switch (coding) {
+			case ContentCoding::GZIP: return "gzip";
+			case ContentCoding::DEFLATE: return "deflate";
+			default: return "identity";
+		}
+	}
+
+	auto compress(std::string_view input, ContentCoding coding, int level) -> boost::system::result<std::string> {
+		try {
+			HttpCompressor compressor(coding, level);
+			std::string output = compressor.compress(input);
+			output += compressor.finish();
+
+			return output;
+		} catch (...) {
+			return boost::system::errc::make_error_code(boost::system::errc::io_error);
+		}
+	}
+
+	/* Sink of decompressed bytes which stops copy as soon as output outgrows limit */
+	class LimitedSink final {
+	public:
+		using char_type = char;
+		using category = io::sink_tag;
+
+		LimitedSink(std::string& output, std::size_t maxSize)
+			: mOutput(output)
+			, mMaxSize(maxSize) {
+		}
+
+		auto write(const char* data, std::streamsize size) -> std::streamsize {
+			if (static_cast<std::size_t>(size) > mMaxSize - mOutput.size()) {
+				throw std::length_error("decompressed body exceeds limit");
+			}
+
+			mOutput.append(data, static_cast<std::size_t>(size));
+			return size;
+		}
+
+	private:
+		std::string& mOutput;
+		std::size_t mMaxSize;
+	};
+
+	auto decompress(std::string_view input, ContentCoding coding, std::size_t maxSize) -> boost::system::result<std::string> {
+		if (coding == ContentCoding::IDENTITY) {
+			if (input.size() > maxSize) {
+				return boost::system::errc::make_error_code(boost::system::errc::message_size);
+			}
+
+			return std::string(input);
+		}
+
+		std::string output;
+
+		try {
+			io::filtering_istream stream;
+
+			if (coding == ContentCoding::GZIP) {
+				stream.push(io::gzip_decompressor());
+			} else {
+				stream.push(io::zlib_decompressor());
+			}
+			stream.push(io::array_source(input.data(), input.size()));
+
+			io::copy(stream, LimitedSink(output, maxSize));
+		} catch (const std::length_error&) {
+			return boost::system::errc::make_error_code(boost::system::errc::message_size);
+		} catch (...) {
+			return boost::system::errc::make_error_code(boost::system::errc::illegal_byte_sequence);
+		}
+
+		return output;
+	}
+
+	HttpCompressor::HttpCompressor(ContentCoding coding, int level) {
+		if (coding == ContentCoding::GZIP) {
+			mStream.push(io::gzip_compressor(io::gzip_params(level)));
+		} else if (coding == ContentCoding::DEFLATE) {
+			mStream.push(io::zlib_compressor(io::zlib_params(level)));
+		}
+		mStream.push(io::back_inserter(mOutput));
+	}
+
+	auto HttpCompressor::compress(std::string_view input) -> std::string {
+		mStream.write(input.data(), static_cast<std::streamsize>(input.size()));
+		/* moves bytes of stream buffer into zlib, which emits them once its own buffer is full */
+		mStream.flush();
+
+		return std::exchange(mOutput, {});
+	}
+
+	auto HttpCompressor::finish() -> std::string {
+		/* closing chain writes rest of deflate stream and gzip trailer */
+		mStream.reset();
+
+		return std::exchange(mOutput, {});
+	}
+}
@@ -0,0 +1,107 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpContentFormat.hpp"
+#include "util/StringUtils.hpp"
+
+#include <algorithm>
+
+namespace lynx {
+
+	static bool isProtobufMime(std::string_view mediaType) {
+		return equalsIgnoreCase(mediaType, "application/x-protobuf") || equalsIgnoreCase(mediaType, "application/protobuf");
+	}
+
+	auto negotiateFormat(std::string_view accept) -> ContentFormat {
+		uint32_t protobufQuality = 0;
+		uint32_t jsonQuality = 0;
+		uint32_t anyQuality = 0;
+		bool jsonListed = false;
+
+		while (!accept.empty()) {
+			const std::size_t separator = accept.find(',');
+			const std::string_view element = accept.substr(0, separator);
+			accept = (separator == std::string_view::npos) ? std::string_view{} : accept.substr(separator + 1);
+
+			const std::size_t parametersSeparator = element.find(';');
+			const std::string_view mediaType = trim(element.substr(0, parametersSeparator));
+			const uint32_t quality = (parametersSeparator == std::string_view::npos) ? 1000 : parseQuality(element.substr(parametersSeparator + 1));
+
+			if (isProtobufMime(mediaType)) {
+				protobufQuality = quality;
+			} else if (equalsIgnoreCase(mediaType, "application/json")) {
+				jsonQuality = quality;
+				jsonListed = true;
+			} else if (mediaType == "*/*" || equalsIgnoreCase(mediaType, "application/*")) {
+				anyQuality = std::max(anyQuality, quality);
+			}
+		}
+
+		jsonQuality = jsonListed ? jsonQuality : anyQuality;
+
+		return (protobufQuality != 0 && protobufQuality >= jsonQuality) ? ContentFormat::PROTOBUF : ContentFormat::JSON;
+	}
+
+	auto parseFormat(std::string_view contentType) -> std::optional<ContentFormat> {
+		const std::string_view mediaType = trim(contentType.substr(0, contentType.find(';')));
+
+		if (isProtobufMime(mediaType)) {
+			return ContentFormat::PROTOBUF;
+		} else if (equalsIgnoreCase(mediaType, "application/json")) {
+			return ContentFormat::JSON;
+		}
+
+		return std::nullopt;
+	}
+
+	auto toMime(ContentFormat format) -> const char* {
+		switch (format) {
+			case ContentFormat::PROTOBUF: return "application/x-protobuf";
+			default: return "application/json";
+		}
+	}
+
+	auto parseQuality(std::string_view parameters) -> uint32_t {
+		const std::size_t position = parameters.find("q=");
+
+		if (position == std::string_view::npos) {
+			return 1000;
+		}
+
+		const std::string_view value = trim(parameters.substr(position + 2));
+		uint32_t quality = (!value.empty() && value.front() == '1') ? 1000 : 0;
+		const std::size_t point = value.find('.');
+
+		if (quality == 0 && point != std::string_view::npos) {
+			uint32_t scale = 100;
+
+			for (std::size_t i = point + 1; i < value.size() && scale != 0 && value[i] >= '0' && value[i] <= '9'; ++i) {
+				quality += (value[i] - '0') * scale;
+				scale /= 10;
+			}
+		}
+
+		return quality;
+	}
+}
@@ -0,0 +1,206 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpDictClientPool.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+
+static constexpr const char* const TAG = "HttpDictClientPool";
+
+namespace lynx {
+
+	HttpDictClientPool::Lease::Lease(HttpDictClientPool& pool, uint32_t index)
+		: mPool(&pool)
+		, mIndex(index) {
+	}
+
+	HttpDictClientPool::Lease::Lease(Lease&& other) noexcept
+		: mPool(std::exchange(other.mPool, nullptr))
+		, mIndex(other.mIndex) {
+	}
+
+	HttpDictClientPool::Lease::~Lease() {
+		if (mPool) {
+			mPool->release(mIndex);
+		}
+	}
+
+	auto HttpDictClientPool::Lease::operator*() -> SyncHttpDictClient& { return *mPool->mSlots[mIndex].client; }
+
+	auto HttpDictClientPool::Lease::operator->() -> SyncHttpDictClient* { return mPool->mSlots[mIndex].client.get(); }
+
+	HttpDictClientPool::HttpDictClientPool(const std::string& host, uint16_t port, const HttpDictClientPoolOptions& options)
+		: mHost(host)
+		, mPort(port)
+		, mOptions(options)
+		, mNextIndex(0)
+		, mReleaseCount(0)
+		, mStarted(false) {
+		mOptions.clientCount = std::max(mOptions.clientCount, 1u);
+		mOptions.pipelineDepth = std::max(mOptions.pipelineDepth, 1u);
+		mSlots = std::make_unique<Slot[]>(mOptions.clientCount);
+
+		log::info(TAG, "Create pool");
+	}
+
+	HttpDictClientPool::~HttpDictClientPool() {
+		stop();
+		log::info(TAG, "Destroy pool");
+	}
+
+	bool HttpDictClientPool::isStarted() const { return mStarted; }
+
+	void HttpDictClientPool::start() {
+		log::info(TAG, "Start pool with %u clients", mOptions.clientCount);
+
+		/* slot leased before start is connected by its lease, so only slots claimed here are touched */
+		for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+			if (mSlots[i].leased.test_and_set(std::memory_order_acquire)) {
+				continue;
+			}
+
+			prepareClient(mSlots[i]);
+			release(i);
+		}
+
+		mStarted = true;
+	}
+
+	void HttpDictClientPool::stop() {
+		if (!mStarted.exchange(false)) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+			Slot& slot = mSlots[i];
+
+			/* client still leased may be in the middle of request, it is closed with pool */
+			if (slot.leased.test_and_set(std::memory_order_acquire)) {
+				continue;
+			}
+
+			if (slot.client && slot.client->isStarted()) {
+				slot.client->stop();
+			}
+			release(i);
+		}
+
+		log::info(TAG, "Stop pool");
+	}
+
+	auto HttpDictClientPool::acquire() -> Lease {
+		while (true) {
+			const uint32_t releaseCount = mReleaseCount.load(std::memory_order_acquire);
+			const uint32_t firstIndex = mNextIndex.fetch_add(1, std::memory_order_relaxed);
+
+			for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+				const uint32_t index = (firstIndex + i) % mOptions.clientCount;
+
+				if (!mSlots[index].leased.test_and_set(std::memory_order_acquire)) {
+					Lease lease(*this, index);
+					prepareClient(mSlots[index]);
+					return lease;
+				}
+			}
+
+			/* wakes up once any lease is released after the scan above began */
+			mReleaseCount.wait(releaseCount, std::memory_order_acquire);
+		}
+	}
+
+	void HttpDictClientPool::performPost(const Word& word) {
+		acquire()->performPost(word);
+	}
+
+	void HttpDictClientPool::performPut(const Word& word) {
+		acquire()->performPut(word);
+	}
+
+	void HttpDictClientPool::performDelete(uint64_t id) {
+		acquire()->performDelete(id);
+	}
+
+	auto HttpDictClientPool::performPost(const std::vector<Word>& words) -> std::vector<WordStatus> {
+		return acquire()->performPost(words);
+	}
+
+	auto HttpDictClientPool::performPut(const std::vector<Word>& words) -> std::vector<WordStatus> {
+		return acquire()->performPut(words);
+	}
+
+	auto HttpDictClientPool::performGet(uint64_t id) -> Word {
+		return acquire()->performGet(id);
+	}
+
+	auto HttpDictClientPool::performGet() -> std::vector<Word> {
+		return acquire()->performGet();
+	}
+
+	auto HttpDictClientPool::performGet(const std::vector<uint64_t>& ids) -> std::vector<Word> {
+		Lease lease = acquire();
+		std::vector<Word> words;
+		words.reserve(ids.size());
+
+		/* depth bounds requests which server buffers for one connection before it answers them */
+		for (std::size_t first = 0; first < ids.size(); first += mOptions.pipelineDepth) {
+			const std::size_t last = std::min(first + mOptions.pipelineDepth, ids.size());
+			std::vector<Word> batchWords = lease->performGet(std::vector<uint64_t>(ids.begin() + first, ids.begin() + last));
+			const bool complete = batchWords.size() == last - first;
+
+			words.insert(words.end(), std::make_move_iterator(batchWords.begin()), std::make_move_iterator(batchWords.end()));
+
+			if (!complete) {
+				log::error(TAG, "Connection broke after %zu of %zu words", words.size(), ids.size());
+				break;
+			}
+		}
+
+		return words;
+	}
+
+	void HttpDictClientPool::prepareClient(Slot& slot) {
+		/* slot of pool which isn't started yet has no client, it is connected on first lease */
+		if (!slot.client || !slot.client->checkConnection()) {
+			reconnectClient(slot);
+		}
+	}
+
+	void HttpDictClientPool::reconnectClient(Slot& slot) {
+		slot.client = std::make_unique<SyncHttpDictClient>(mHost, mPort);
+		slot.client->setFormat(mOptions.format);
+		slot.client->start();
+
+		if (!slot.client->isStarted()) {
+			log::error(TAG, "Can't connect client to %s:%u", mHost.c_str(), mPort);
+		}
+	}
+
+	void HttpDictClientPool::release(uint32_t index) {
+		mSlots[index].leased.clear(std::memory_order_release);
+
+		mReleaseCount.fetch_add(1, std::memory_order_release);
+		mReleaseCount.notify_one();
+	}
+}
@@ -0,0 +1,232 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpDictDumper.hpp"
+#include "logging/Logging.hpp"
+#include "util/StringUtils.hpp"
+
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+
+static constexpr const char* const TAG = "HttpDictDumper";
+static constexpr std::string_view BYTES_UNIT = "bytes=";
+static constexpr const char* const TEMPORARY_SUFFIX = ".tmp";
+
+namespace lynx {
+	namespace {
+		bool parseNumber(std::string_view text, uint64_t& number) {
+			const auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), number);
+			return !text.empty() && errorCode == std::errc() && end == text.data() + text.size();
+		}
+	}
+
+	auto parseByteRange(std::string_view range, uint64_t fileSize) -> ByteRange {
+		const ByteRange whole = { .offset = 0, .size = fileSize };
+		range = trim(range);
+
+		/* server may ignore Range it doesn't support, so several ranges get whole file instead of multipart body */
+		if (!range.starts_with(BYTES_UNIT) || range.find(',') != std::string_view::npos) {
+			return whole;
+		}
+
+		range.remove_prefix(BYTES_UNIT.size());
+
+		const std::size_t dash = range.find('-');
+
+		if (dash == std::string_view::npos) {
+			return whole;
+		}
+
+		const std::string_view firstText = trim(range.substr(0, dash));
+		const std::string_view lastText = trim(range.substr(dash + 1));
+		uint64_t first = 0;
+		uint64_t last = 0;
+
+		/* suffix range -n asks for last n bytes */
+		if (firstText.empty()) {
+			if (!parseNumber(lastText, last)) {
+				return whole;
+			}
+			if (last == 0 || fileSize == 0) {
+				return { .satisfiable = false };
+			}
+
+			last = std::min(last, fileSize);
+			return { .offset = fileSize - last, .size = last, .partial = true };
+		}
+
+		if (!parseNumber(firstText, first)) {
+			return whole;
+		}
+
+		if (lastText.empty()) {
+			last = UINT64_MAX;
+		} else if (!parseNumber(lastText, last) || last < first) {
+			return whole;
+		}
+
+		if (first >= fileSize) {
+			return { .satisfiable = false };
+		}
+
+		last = std::min(last, fileSize - 1);
+		return { .offset = first, .size = last - first + 1, .partial = true };
+	}
+
+	HttpDictDumper::HttpDictDumper(SyncDictDao& dictDao, std::mutex& dictDaoMutex, const DumpOptions& options)
+		: mDictDao(dictDao)
+		, mDictDaoMutex(dictDaoMutex)
+		, mOptions(options)
+		, mStarted(false) {
+		log::info(TAG, "Create dumper");
+	}
+
+	HttpDictDumper::~HttpDictDumper() {
+		stop();
+		log::info(TAG, "Destroy dumper");
+	}
+
+	bool HttpDictDumper::isStarted() const { return mStarted; }
+
+	void HttpDictDumper::start() {
+		if (mOptions.path.empty() || mStarted.exchange(true)) {
+			return;
+		}
+
+		log::info(TAG, "Start dumper to %s every %lld s", mOptions.path.c_str(), static_cast<long long>(mOptions.interval.count()));
+		mThread = std::thread(&HttpDictDumper::runDumps, this);
+	}
+
+	void HttpDictDumper::stop() {
+		{
+			/* flag is changed under mutex, so thread can't miss notification between check and wait */
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+		}
+
+		mCondition.notify_all();
+
+		if (mThread.joinable()) {
+			mThread.join();
+		}
+
+		log::info(TAG, "Stop dumper");
+	}
+
+	void HttpDictDumper::runDumps() {
+		while (mStarted) {
+			const auto startTime = std::chrono::steady_clock::now();
+			boost::system::result<std::size_t> count = writeDump();
+
+			if (count.has_error()) {
+				log::error(TAG, "Can't write dump: %s", count.error().message().c_str());
+			} else {
+				log::info(TAG, "Dump %zu words in %lld ms", *count, static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+						std::chrono::steady_clock::now() - startTime).count()));
+			}
+
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait_for(lock, mOptions.interval, [this]() { return !mStarted; });
+		}
+	}
+
+	auto HttpDictDumper::writeDump() -> boost::system::result<std::size_t> {
+		const std::string temporaryPath = mOptions.path + TEMPORARY_SUFFIX;
+		std::ofstream stream(temporaryPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+		uint64_t afterId = 0;
+		std::size_t count = 0;
+
+		if (!stream.is_open()) {
+			return std::make_error_code(std::io_errc::stream);
+		}
+
+		while (true) {
+			boost::system::result<std::vector<Word>> localWords = [this, afterId]() {
+				std::lock_guard<std::mutex> lock(mDictDaoMutex);
+				return mDictDao.getPage(afterId, mOptions.pageSize);
+			}();
+
+			if (localWords.has_error()) {
+				std::remove(temporaryPath.c_str());
+				return localWords.error();
+			}
+
+			/* short page doesn't mean end, words may be inserted behind it while dump is written */
+			if (localWords->empty()) {
+				break;
+			}
+
+			boost::system::result<void> status = writeWords(stream, *localWords);
+
+			if (status.has_error()) {
+				std::remove(temporaryPath.c_str());
+				return status.error();
+			}
+
+			count += localWords->size();
+			afterId = localWords->back().id;
+		}
+
+		stream.close();
+
+		/* rename replaces old dump at once, responses which already opened it keep reading old inode */
+		if (!stream || std::rename(temporaryPath.c_str(), mOptions.path.c_str()) != 0) {
+			std::remove(temporaryPath.c_str());
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		return count;
+	}
+
+	auto HttpDictDumper::writeWords(std::ofstream& stream, const std::vector<Word>& words) -> boost::system::result<void> {
+		for (const Word& word : words) {
+			if (mOptions.format == ContentFormat::PROTOBUF) {
+				if (!google::protobuf::util::SerializeDelimitedToOstream(mProtobufParser.convert(word), &stream)) {
+					return std::make_error_code(std::errc::io_error);
+				}
+				continue;
+			}
+
+			boost::system::result<std::string> localData = mParser.serializeToText(word);
+
+			if (localData.has_error()) {
+				return localData.error();
+			}
+
+			stream << *localData << '\n';
+		}
+
+		if (!stream) {
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		return {};
+	}
+}
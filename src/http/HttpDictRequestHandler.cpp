@@ -0,0 +1,772 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpDictRequestHandler.hpp"
+#include "logging/Logging.hpp"
+#include "util/StringUtils.hpp"
+
+#include <charconv>
+#include <span>
+#include <string_view>
+
+#include <boost/beast/version.hpp>
+
+#include <sys/stat.h>
+
+static constexpr const char* const TAG = "HttpDictRequestHandler";
+static constexpr const char* const DUMP_JSON_MIME = "application/x-ndjson";
+
+namespace lynx {
+
+	/* FNV-1a is stable between runs, so clients keep valid etags over server restarts */
+	static auto makeEtag(std::string_view body) -> std::string {
+		uint64_t hash = 14695981039346656037ull;
+
+		for (const char symbol : body) {
+			hash ^= static_cast<uint8_t>(symbol);
+			hash *= 1099511628211ull;
+		}
+
+		return format("\"%016llx-%zx\"", static_cast<unsigned long long>(hash), body.size());
+	}
+
+	/* If-None-Match uses weak comparison, so W/ prefix is ignored and any tag of list may match */
+	static bool matchesEtag(boost::core::string_view ifNoneMatch, std::string_view etag) {
+		std::string_view tags(ifNoneMatch.data(), ifNoneMatch.size());
+
+		while (!tags.empty()) {
+			const std::size_t separator = tags.find(',');
+			std::string_view tag = tags.substr(0, separator);
+			tags = (separator == std::string_view::npos) ? std::string_view{} : tags.substr(separator + 1);
+
+			while (!tag.empty() && (tag.front() == ' ' || tag.front() == '\t')) {
+				tag.remove_prefix(1);
+			}
+			while (!tag.empty() && (tag.back() == ' ' || tag.back() == '\t')) {
+				tag.remove_suffix(1);
+			}
+			if (tag.starts_with("W/")) {
+				tag.remove_prefix(2);
+			}
+			if (tag == "*" || tag == etag) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/* Reads unsigned number of query parameter, missing parameter keeps its default value */
+	static bool parseQueryNumber(std::string_view query, std::string_view name, uint64_t& value) {
+		while (!query.empty()) {
+			const std::size_t separator = query.find('&');
+			const std::string_view parameter = query.substr(0, separator);
+			query = (separator == std::string_view::npos) ? std::string_view{} : query.substr(separator + 1);
+
+			const std::size_t equal = parameter.find('=');
+
+			if (parameter.substr(0, equal) != name) {
+				continue;
+			} else if (equal == std::string_view::npos) {
+				return false;
+			}
+
+			const std::string_view number = parameter.substr(equal + 1);
+			auto [end, errorCode] = std::from_chars(number.data(), number.data() + number.size(), value);
+
+			return errorCode == std::errc{} && end == number.data() + number.size();
+		}
+
+		return true;
+	}
+
+	static auto toStringView(boost::core::string_view value) -> std::string_view {
+		return std::string_view(value.data(), value.size());
+	}
+
+	static auto toBody(boost::system::result<std::vector<std::byte>>&& buffer) -> boost::system::result<std::string> {
+		if (buffer.has_error()) {
+			return buffer.error();
+		}
+
+		return std::string(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+	}
+
+	HttpDictRequestHandler::HttpDictRequestHandler(SyncDictDao& dictDao, std::mutex& dictDaoMutex,
+												   const CompressionOptions& compression, const DumpOptions& dump,
+												   std::size_t wordCacheCapacity)
+		: mDictDao(dictDao)
+		, mDictDaoMutex(dictDaoMutex)
+		, mCompression(compression)
+		, mDump(dump)
+		, mWordCache(wordCacheCapacity)
+		, mProtobufWordCache(wordCacheCapacity) {
+	}
+
+	auto HttpDictRequestHandler::handlePostRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		boost::system::result<Word> remoteWord = takeRequestWord(request.body());
+
+		if (remoteWord.has_error()) {
+			const std::string message = format("Deserialize request word error %s",
+											   remoteWord.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::bad_request, version, keepAlive));
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.insert(remoteWord.value());
+		invalidateWord(remoteWord->id);
+
+		if (operationStatus.has_value()) {
+			const std::string message = "Handle POST/ request success";
+			log::debug(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::ok, version, keepAlive));
+		} else {
+			const auto message = format("Db insert word error %s",
+					                    operationStatus.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+	}
+
+	auto HttpDictRequestHandler::handlePutRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		boost::system::result<Word> remoteWord = takeRequestWord(request.body());
+
+		if (remoteWord.has_error()) {
+			const std::string message = format("Deserialize request word error %s",
+											   remoteWord.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::bad_request, version, keepAlive));
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.update(remoteWord.value());
+		invalidateWord(remoteWord->id);
+
+		if (operationStatus.has_value()) {
+			const std::string message = "Handle PUT/ request success";
+			log::debug(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::ok, version, keepAlive));
+		} else {
+			const auto message = format("Db update word error %s",
+										operationStatus.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+	}
+
+	auto HttpDictRequestHandler::handlePostBatchRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator> {
+		return handleBatchRequest(std::move(request), "insert", [this](const std::vector<Word>& words) {
+			return mDictDao.insert(words);
+		});
+	}
+
+	auto HttpDictRequestHandler::handlePutBatchRequest(http::request<JsonWordBody>&& request) -> std::unique_ptr<http::message_generator> {
+		return handleBatchRequest(std::move(request), "update", [this](const std::vector<Word>& words)
+			-> boost::system::result<std::vector<uint64_t>> {
+			boost::system::result<void> operationStatus = mDictDao.update(words);
+
+			if (operationStatus.has_error()) {
+				return operationStatus.error();
+			}
+
+			std::vector<uint64_t> wordIds;
+			wordIds.reserve(words.size());
+
+			for (const Word& word : words) {
+				wordIds.push_back(word.id);
+			}
+
+			return wordIds;
+		});
+	}
+
+	auto HttpDictRequestHandler::handleDeleteRequest(http::request<http::string_body>&& request, uint64_t wordId) -> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.remove(wordId);
+		invalidateWord(wordId);
+
+		if (operationStatus.has_value()) {
+			const std::string message = format("Handle DELETE/%u/ request success", wordId);
+			log::debug(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::ok, version, keepAlive));
+		} else {
+			const auto message = format("Db delete word error %s",
+										operationStatus.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+	}
+
+	auto HttpDictRequestHandler::handleGetByIdRequest(http::request<http::string_body>&& request, uint64_t wordId) -> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		const ContentFormat contentFormat = negotiateFormat(toStringView(request[http::field::accept]));
+		std::shared_ptr<const CachedWord> cachedWord;
+		{
+			std::lock_guard<std::mutex> cacheLock(mWordCacheMutex);
+			cachedWord = wordCache(contentFormat).get(wordId).value_or(nullptr);
+		}
+
+		if (cachedWord) {
+			log::debug(TAG, "Handle GET/%u/ request from cache", wordId);
+			return std::make_unique<http::message_generator>(prepareCachedResponse(*cachedWord, request));
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<Word> localWord = mDictDao.getById(wordId);
+
+		if (localWord.has_error()) {
+			const std::string message = format("Db get word by id error: %s",
+											   localWord.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+
+		boost::system::result<std::string> localData = serializeWord(*localWord, contentFormat);
+
+		if (localData.has_value()) {
+			log::debug(TAG, "Handle GET/%u/ request success", wordId);
+
+			std::string etag = makeEtag(*localData);
+			cachedWord = std::make_shared<const CachedWord>(CachedWord{ std::move(*localData), std::move(etag), contentFormat });
+			{
+				std::lock_guard<std::mutex> cacheLock(mWordCacheMutex);
+				wordCache(contentFormat).put(wordId, cachedWord);
+			}
+
+			return std::make_unique<http::message_generator>(prepareCachedResponse(*cachedWord, request));
+		} else {
+			const auto message = format("Serialize word error: %s",
+										localData.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+	}
+
+	auto HttpDictRequestHandler::handleGetPageRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		const std::string_view target(request.target().data(), request.target().size());
+		const std::size_t querySeparator = target.find('?');
+		const std::string_view query = (querySeparator == std::string_view::npos) ? std::string_view{} : target.substr(querySeparator + 1);
+		uint64_t afterId = 0;
+		uint64_t limit = WORD_PAGE_LIMIT;
+
+		if (!parseQueryNumber(query, "after", afterId) || !parseQueryNumber(query, "limit", limit)
+			|| limit == 0 || limit > WORD_PAGE_MAX_LIMIT) {
+			const std::string message = format("Received illegal page query, limit must be in [1, %zu]", WORD_PAGE_MAX_LIMIT);
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::bad_request, version, keepAlive));
+		}
+
+		const ContentFormat contentFormat = negotiateFormat(toStringView(request[http::field::accept]));
+		std::string localData = (contentFormat == ContentFormat::JSON) ? "[" : "";
+		boost::system::result<std::size_t> wordCount = loadWordPage(afterId, limit, contentFormat, localData);
+
+		if (wordCount.has_error()) {
+			const std::string message = format("Db get page of words error: %s",
+											   wordCount.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+
+		if (contentFormat == ContentFormat::JSON) {
+			localData += ']';
+		}
+		log::debug(TAG, "Handle GET/?after&limit request success with %zu words", *wordCount);
+
+		http::response<http::string_body> response = prepareResponse(localData, http::status::ok, version, keepAlive, contentFormat);
+
+		/* short page is last one, so client stops without requesting empty page */
+		if (*wordCount == limit) {
+			response.set(http::field::link, format("</get?after=%llu&limit=%llu>; rel=\"next\"",
+					static_cast<unsigned long long>(afterId), static_cast<unsigned long long>(limit)));
+		}
+
+		compressResponse(response, request);
+		return std::make_unique<http::message_generator>(std::move(response));
+	}
+
+	auto HttpDictRequestHandler::readWordStream(WordStreamCursor& cursor) -> boost::system::result<std::string> {
+		std::string localData;
+		boost::system::result<std::size_t> wordCount = loadWordPage(cursor.afterId, WORD_STREAM_PAGE_SIZE, cursor.format, localData);
+
+		if (wordCount.has_error()) {
+			log::error(TAG, "Db get page of words error: %s", wordCount.error().message().c_str());
+			return wordCount.error();
+		}
+
+		const bool json = (cursor.format == ContentFormat::JSON);
+		std::string piece = (cursor.started || !json) ? "" : "[";
+
+		if (json && cursor.started && *wordCount != 0) {
+			piece += ',';
+		}
+		piece += localData;
+
+		/* table may grow while it is streamed, so only empty page ends it */
+		if (*wordCount == 0) {
+			piece += json ? "]" : "";
+			cursor.finished = true;
+		}
+
+		cursor.started = true;
+
+		/* zlib failure leaves stream of compressor broken, so response can only be cut short */
+		if (cursor.compressor) {
+			try {
+				piece = cursor.compressor->compress(piece);
+
+				if (cursor.finished) {
+					piece += cursor.compressor->finish();
+				}
+			} catch (...) {
+				log::error(TAG, "Compress stream of words error");
+				return boost::system::errc::make_error_code(boost::system::errc::io_error);
+			}
+		}
+
+		return piece;
+	}
+
+	auto HttpDictRequestHandler::prepareStreamResponse(const http::request<http::string_body>& request, WordStreamCursor& cursor)
+		-> http::response<http::buffer_body> {
+		http::response<http::buffer_body> response{http::status::ok, request.version()};
+		response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+		cursor.format = negotiateFormat(toStringView(request[http::field::accept]));
+		response.set(http::field::content_type, toMime(cursor.format));
+		response.set(http::field::vary, "Accept, Accept-Encoding");
+		response.keep_alive(request.keep_alive());
+		response.chunked(true);
+
+		const boost::core::string_view acceptEncoding = request[http::field::accept_encoding];
+		const ContentCoding coding = mCompression.enabled
+			? negotiateCoding(std::string_view(acceptEncoding.data(), acceptEncoding.size())) : ContentCoding::IDENTITY;
+
+		if (coding != ContentCoding::IDENTITY) {
+			response.set(http::field::content_encoding, toString(coding));
+			cursor.compressor = std::make_unique<HttpCompressor>(coding, mCompression.level);
+		}
+
+		return response;
+	}
+
+	auto HttpDictRequestHandler::handleDumpRequest(const http::request<http::string_body>& request, DumpFile& dump)
+		-> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+		beast::error_code errorCode;
+		http::file_body::value_type body;
+		struct stat fileStat = {};
+
+		if (!mDump.path.empty()) {
+			body.open(mDump.path.c_str(), beast::file_mode::scan, errorCode);
+		}
+
+		/* dumper may not have finished first dump yet */
+		if (mDump.path.empty() || errorCode || ::fstat(body.file().native_handle(), &fileStat) != 0) {
+			const std::string message = "Dump isn't available";
+			log::error(TAG, "%s: %s", message.c_str(), errorCode.message().c_str());
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					http::status::not_found, version, keepAlive));
+		}
+
+		/* size and mtime of opened file name one dump, dump renamed over it gets new tag */
+		const uint64_t fileSize = body.size();
+		const std::string etag = format("\"%llx-%llx\"", static_cast<unsigned long long>(fileSize),
+				static_cast<unsigned long long>(fileStat.st_mtim.tv_sec) * 1000000000ull + fileStat.st_mtim.tv_nsec);
+
+		ByteRange range = { .offset = 0, .size = fileSize };
+		const auto rangeField = request.find(http::field::range);
+		const auto ifRange = request.find(http::field::if_range);
+
+		/* part of replaced dump can't continue download, so client gets new dump whole */
+		if (rangeField != request.end() && (ifRange == request.end() || toStringView(ifRange->value()) == etag)) {
+			range = parseByteRange(toStringView(rangeField->value()), fileSize);
+		}
+
+		if (!range.satisfiable) {
+			http::response<http::string_body> response = prepareResponse("Range isn't satisfiable",
+					http::status::range_not_satisfiable, version, keepAlive);
+			response.set(http::field::content_range, format("bytes */%llu", static_cast<unsigned long long>(fileSize)));
+
+			return std::make_unique<http::message_generator>(std::move(response));
+		}
+
+		dump.response = http::response<http::file_body>{range.partial ? http::status::partial_content : http::status::ok, version};
+		dump.response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+		dump.response.set(http::field::content_type, (mDump.format == ContentFormat::JSON) ? DUMP_JSON_MIME : toMime(mDump.format));
+		dump.response.set(http::field::accept_ranges, "bytes");
+		dump.response.set(http::field::etag, etag);
+
+		if (range.partial) {
+			dump.response.set(http::field::content_range, format("bytes %llu-%llu/%llu", static_cast<unsigned long long>(range.offset),
+					static_cast<unsigned long long>(range.offset + range.size - 1), static_cast<unsigned long long>(fileSize)));
+		}
+
+		/* length is that of range, not of file, since only range follows header */
+		dump.response.body() = std::move(body);
+		dump.response.content_length(range.size);
+		dump.response.keep_alive(keepAlive);
+		dump.offset = range.offset;
+		dump.size = range.size;
+
+		return nullptr;
+	}
+
+	auto HttpDictRequestHandler::handleBatchRequest(http::request<JsonWordBody>&& request, const char* operation,
+			const std::function<boost::system::result<std::vector<uint64_t>>(const std::vector<Word>&)>& applyWords)
+		-> std::unique_ptr<http::message_generator> {
+		const uint32_t version = request.version();
+		const bool keepAlive = request.keep_alive();
+
+		if (!checkTarget(request.target())) {
+			const std::string message = "Received illegal request-target";
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+					                http::status::bad_request, version, keepAlive));
+		}
+
+		JsonWordBody::value_type& body = request.body();
+
+		if (body.error || !body.batch) {
+			const std::string message = format("Deserialize request words error %s", body.error ?
+											   body.error.message().c_str() : "Body isn't array of words");
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::bad_request, version, keepAlive));
+		}
+
+		std::vector<boost::system::result<Word>>& remoteWords = body.words;
+
+		std::vector<WordStatus> statuses(remoteWords.size());
+		std::vector<std::size_t> validIndexes;
+		std::vector<Word> validWords;
+
+		for (std::size_t i = 0; i < remoteWords.size(); ++i) {
+			if (remoteWords.at(i).has_value()) {
+				validIndexes.push_back(i);
+				validWords.push_back(std::move(*remoteWords.at(i)));
+			} else {
+				statuses[i].message = "Deserialize word error";
+			}
+		}
+
+		http::status status = http::status::ok;
+
+		if (!validWords.empty()) {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			boost::system::result<std::vector<uint64_t>> wordIds = applyWords(validWords);
+
+			/* batch is one transaction, so db error fails every word of it */
+			for (std::size_t i = 0; i < validIndexes.size(); ++i) {
+				WordStatus& wordStatus = statuses[validIndexes[i]];
+
+				if (wordIds.has_value()) {
+					wordStatus.id = wordIds->at(i);
+					wordStatus.success = true;
+					invalidateWord(wordStatus.id);
+				} else {
+					wordStatus.message = format("Db %s words error %s", operation, wordIds.error().message().c_str());
+				}
+			}
+
+			if (wordIds.has_error()) {
+				log::error(TAG, "Db %s batch of %zu words error %s", operation, validWords.size(), wordIds.error().message().c_str());
+				status = http::status::internal_server_error;
+			}
+		}
+
+		const ContentFormat contentFormat = negotiateFormat(toStringView(request[http::field::accept]));
+		boost::system::result<std::string> localData = (contentFormat == ContentFormat::PROTOBUF)
+			? toBody(mProtobufParser.serializeStatusesToBuffer(statuses)) : mParser.serializeStatusesToText(statuses);
+
+		if (localData.has_error()) {
+			const auto message = format("Serialize statuses error: %s", localData.error().message().c_str());
+			log::error(TAG, message);
+			return std::make_unique<http::message_generator>(prepareResponse(message,
+									http::status::internal_server_error, version, keepAlive));
+		}
+
+		log::debug(TAG, "Handle %s batch of %zu words, %zu valid", operation, statuses.size(), validWords.size());
+		return std::make_unique<http::message_generator>(prepareResponse(*localData, status, version, keepAlive, contentFormat));
+	}
+
+	auto HttpDictRequestHandler::prepareResponse(const std::string& body, http::status status, uint32_t version, bool keepAlive,
+												 ContentFormat contentFormat) -> http::response<http::string_body> {
+		http::response<http::string_body> response{status, version};
+		response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+		response.set(http::field::content_type, toMime(contentFormat));
+		response.keep_alive(keepAlive);
+		response.body() = body;
+		response.prepare_payload();
+
+		return response;
+	}
+
+	auto HttpDictRequestHandler::prepareCachedResponse(const CachedWord& word, const http::request<http::string_body>& request)
+		-> http::response<http::string_body> {
+		const auto ifNoneMatch = request.find(http::field::if_none_match);
+
+		if (ifNoneMatch != request.end() && matchesEtag(ifNoneMatch->value(), word.etag)) {
+			http::response<http::string_body> response{http::status::not_modified, request.version()};
+			response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+			response.set(http::field::etag, word.etag);
+			response.set(http::field::vary, "Accept");
+			response.keep_alive(request.keep_alive());
+
+			return response;
+		}
+
+		http::response<http::string_body> response = prepareResponse(word.body, http::status::ok, request.version(),
+																	  request.keep_alive(), word.format);
+		response.set(http::field::etag, word.etag);
+		response.set(http::field::vary, "Accept");
+
+		return response;
+	}
+
+	/* Words by id keep raw body, so their strong etag always names one representation */
+	void HttpDictRequestHandler::compressResponse(http::response<http::string_body>& response,
+												  const http::request<http::string_body>& request) {
+		response.set(http::field::vary, "Accept, Accept-Encoding");
+
+		if (!mCompression.enabled || response.body().size() < mCompression.minSize) {
+			return;
+		}
+
+		const boost::core::string_view acceptEncoding = request[http::field::accept_encoding];
+		const ContentCoding coding = negotiateCoding(std::string_view(acceptEncoding.data(), acceptEncoding.size()));
+
+		if (coding == ContentCoding::IDENTITY) {
+			return;
+		}
+
+		boost::system::result<std::string> localData = compress(response.body(), coding, mCompression.level);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Compress response error: %s, send it raw", localData.error().message().c_str());
+			return;
+		}
+
+		response.body() = std::move(*localData);
+		response.set(http::field::content_encoding, toString(coding));
+		response.prepare_payload();
+	}
+
+	void HttpDictRequestHandler::invalidateWord(uint64_t wordId) {
+		std::lock_guard<std::mutex> cacheLock(mWordCacheMutex);
+		mWordCache.erase(wordId);
+		mProtobufWordCache.erase(wordId);
+	}
+
+	auto HttpDictRequestHandler::wordCache(ContentFormat contentFormat) -> LruCache<uint64_t, std::shared_ptr<const CachedWord>>& {
+		return (contentFormat == ContentFormat::PROTOBUF) ? mProtobufWordCache : mWordCache;
+	}
+
+	auto HttpDictRequestHandler::serializeWord(const Word& word, ContentFormat contentFormat) -> boost::system::result<std::string> {
+		return (contentFormat == ContentFormat::PROTOBUF) ? toBody(mProtobufParser.serializeToBuffer(word)) : mParser.serializeToText(word);
+	}
+
+	auto HttpDictRequestHandler::loadWordPage(uint64_t& afterId, std::size_t limit, ContentFormat contentFormat, std::string& body)
+		-> boost::system::result<std::size_t> {
+		boost::system::result<std::vector<Word>> localWords = [this, afterId, limit]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getPage(afterId, limit);
+		}();
+
+		if (localWords.has_error()) {
+			return localWords.error();
+		}
+
+		/* serialized lists concatenate into one list, since protobuf merges repeated field of every part */
+		if (contentFormat == ContentFormat::PROTOBUF) {
+			boost::system::result<std::string> localData = toBody(mProtobufParser.serializeWordsToBuffer(*localWords));
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
+				return localData.error();
+			}
+
+			body += *localData;
+			afterId = localWords->empty() ? afterId : localWords->back().id;
+
+			return localWords->size();
+		}
+
+		for (std::size_t i = 0; i < localWords->size(); ++i) {
+			boost::system::result<std::string> localData = mParser.serializeToText(localWords->at(i));
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+				return localData.error();
+			}
+
+			if (i != 0) {
+				body += ',';
+			}
+			body += *localData;
+			afterId = localWords->at(i).id;
+		}
+
+		return localWords->size();
+	}
+
+	auto HttpDictRequestHandler::decodeWordRequest(http::request<http::string_body>&& request, bool batch)
+		-> http::request<JsonWordBody> {
+		const ContentFormat contentFormat = parseFormat(toStringView(request[http::field::content_type])).value_or(ContentFormat::JSON);
+		const std::span<const std::byte> buffer = std::as_bytes(std::span(request.body().data(), request.body().size()));
+		http::request<JsonWordBody> wordRequest(std::move(request.base()));
+		JsonWordBody::value_type& body = wordRequest.body();
+
+		body.batch = batch;
+
+		/* only tuple form of template reflection comes here as json, streaming parser reads object form */
+		if (contentFormat == ContentFormat::JSON) {
+			if (batch) {
+				boost::system::result<std::vector<boost::system::result<Word>>> remoteWords =
+					mParser.deserializeWordBatchFromText(request.body());
+
+				if (remoteWords.has_error()) {
+					body.error = remoteWords.error();
+					return wordRequest;
+				}
+
+				body.words = std::move(*remoteWords);
+			} else {
+				try {
+					boost::system::result<Word> remoteWord = mParser.deserializeFromText(request.body());
+
+					if (remoteWord.has_error()) {
+						body.error = remoteWord.error();
+						return wordRequest;
+					}
+
+					body.words.push_back(std::move(*remoteWord));
+				} catch (...) {
+					body.error = boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+				}
+			}
+
+			return wordRequest;
+		}
+
+		if (batch) {
+			boost::system::result<std::vector<Word>> remoteWords = mProtobufParser.deserializeWordsFromBuffer(buffer);
+
+			if (remoteWords.has_error()) {
+				body.error = remoteWords.error();
+				return wordRequest;
+			}
+
+			body.words.assign(std::make_move_iterator(remoteWords->begin()), std::make_move_iterator(remoteWords->end()));
+		} else {
+			boost::system::result<Word> remoteWord = mProtobufParser.deserializeFromBuffer(buffer);
+
+			if (remoteWord.has_error()) {
+				body.error = remoteWord.error();
+				return wordRequest;
+			}
+
+			body.words.push_back(std::move(*remoteWord));
+		}
+
+		return wordRequest;
+	}
+
+	auto HttpDictRequestHandler::takeRequestWord(JsonWordBody::value_type& body) -> boost::system::result<Word> {
+		if (body.error) {
+			return body.error;
+		}
+
+		if (body.batch || body.words.size() != 1) {
+			return boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+		}
+
+		return std::move(body.words.front());
+	}
+
+	bool HttpDictRequestHandler::checkTarget(boost::core::string_view target) const {
+		return !target.empty() || target[0] == '/' || target.find("..") == boost::core::string_view::npos;
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "http/HttpRouteTable.hpp"
+
+#include <charconv>
+
+namespace lynx {
+	namespace {
+		auto findRoute(http::verb method, std::string_view prefix, std::string_view parameter, std::string_view query)
+			-> const HttpRouteEntry* {
+			const uint32_t bucket = hashRoute(method, { prefix, parameter, query }) % HTTP_ROUTE_BUCKET_COUNT;
+			const uint8_t index = HTTP_ROUTE_BUCKETS[bucket];
+
+			if (index == HTTP_ROUTE_EMPTY_BUCKET) {
+				return nullptr;
+			}
+
+			const HttpRouteEntry& entry = HTTP_ROUTES[index];
+			const std::string_view pattern = entry.pattern;
+
+			/* placeholder matches only parsed id, target spelling it literally isn't that route */
+			if (parameter.empty() && pattern.find('{') != std::string_view::npos) {
+				return nullptr;
+			}
+
+			if (entry.method != method || pattern.size() != prefix.size() + parameter.size() + query.size() ||
+				!pattern.starts_with(prefix) || pattern.substr(prefix.size(), parameter.size()) != parameter ||
+				!pattern.ends_with(query)) {
+				return nullptr;
+			}
+
+			return &entry;
+		}
+	}
+
+	auto matchRoute(http::verb method, std::string_view target) -> HttpRouteMatch {
+		const std::size_t queryStart = target.find('?');
+		const std::string_view path = target.substr(0, queryStart);
+		HttpRouteMatch match;
+
+		std::string_view prefix = path;
+		std::string_view parameter;
+
+		/* numeric last segment is word id, so /get/15 is looked up as /get/{id} */
+		const std::size_t segmentStart = path.find_last_of('/') + 1;
+		const std::string_view segment = path.substr(segmentStart);
+
+		if (!segment.empty()) {
+			const auto [end, errorCode] = std::from_chars(segment.data(), segment.data() + segment.size(), match.wordId);
+
+			if (errorCode == std::errc{} && end == segment.data() + segment.size()) {
+				prefix = path.substr(0, segmentStart);
+				parameter = "{id}";
+			} else {
+				match.wordId = 0;
+			}
+		}
+
+		const HttpRouteEntry* entry = nullptr;
+
+		if (queryStart != std::string_view::npos) {
+			entry = findRoute(method, prefix, parameter, "?");
+		}
+
+		if (entry == nullptr) {
+			entry = findRoute(method, prefix, parameter, {});
+		}
+
+		match.route = (entry != nullptr) ? entry->route : HttpRoute::UNKNOWN;
+		return match;
+	}
+}
@@ -23,27 +23,61 @@
  */
 
 #include "http/SyncHttpDictClient.hpp"
+#include "http/HttpCompression.hpp"
 #include "logging/Logging.hpp"
+#include "net/NetworkUtils.hpp"
+#include "util/StringUtils.hpp"
 
+#include <boost/asio/write.hpp>
 #include <boost/beast/version.hpp>
 
+#include <span>
+#include <sstream>
+
 static constexpr const char* const TAG = "SyncHttpDictClient";
+static constexpr std::size_t BODY_LIMIT = 8 * 1024 * 1024;         /* default limit of beast parser */
+static constexpr std::size_t WORDS_BODY_LIMIT = 1024 * 1024 * 1024; /* whole dictionary of GET /get */
 
 namespace lynx {
 
+	static auto toBody(boost::system::result<std::vector<std::byte>>&& buffer) -> boost::system::result<std::string> {
+		if (buffer.has_error()) {
+			return buffer.error();
+		}
+
+		return std::string(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+	}
+
+	static auto toBytes(const std::string& body) -> std::span<const std::byte> {
+		return std::as_bytes(std::span(body.data(), body.size()));
+	}
+
 	SyncHttpDictClient::SyncHttpDictClient(const std::string& host, uint16_t port)
 		: mHost(host)
 		, mPort(port)
 		, mStream(mContext)
+		, mFormat(ContentFormat::JSON)
+		, mStarted(false) {
+		log::info(TAG, "Create client");
+	}
+
+	SyncHttpDictClient::SyncHttpDictClient(const std::string& socketPath)
+		: mHost("localhost")
+		, mPort(0)
+		, mSocketPath(socketPath)
+		, mStream(mContext)
+		, mFormat(ContentFormat::JSON)
 		, mStarted(false) {
 		log::info(TAG, "Create client");
 	}
 
 	SyncHttpDictClient::~SyncHttpDictClient() {
+		boost::system::error_code errorCode;
 		auto& socket = mStream.socket();
 
+		/* pool destroys clients whose connection is already broken, so shutdown must not throw */
 		if (socket.is_open()) {
-			socket.shutdown(net::ip::tcp::socket::shutdown_both);
+			socket.shutdown(net::socket_base::shutdown_both, errorCode);
 		}
 
 		log::info(TAG, "Destroy client");
@@ -56,16 +90,28 @@ namespace lynx {
 
 		boost::system::error_code errorCode;
 
-		net::ip::tcp::resolver resolver(mContext);
-		auto endpoints = resolver.resolve(mHost, std::to_string(mPort), errorCode);
-
-		if (errorCode) {
-			log::error(TAG, "Can't resolve host of http server %s: %s", mHost.c_str(), errorCode.message().c_str());
-			return;
+		if (!mSocketPath.empty()) {
+			mStream.connect(toLocalEndpoint(mSocketPath), errorCode);
+		} else {
+			net::ip::tcp::resolver resolver(mContext);
+			auto endpoints = resolver.resolve(mHost, std::to_string(mPort), errorCode);
+
+			if (errorCode) {
+				log::error(TAG, "Can't resolve host of http server %s: %s", mHost.c_str(), errorCode.message().c_str());
+				return;
+			}
+
+			/* generic stream doesn't take resolver results, so they are tried one by one */
+			for (const auto& entry : endpoints) {
+				mStream.connect(entry.endpoint(), errorCode);
+
+				if (!errorCode) {
+					break;
+				}
+				mStream.close();
+			}
 		}
 
-		mStream.connect(endpoints, errorCode);
-
 		if (!errorCode) {
 			mStarted = true;
 			log::debug(TAG, "Connect to http server %s success", mHost.c_str());
@@ -79,11 +125,24 @@ namespace lynx {
 		log::info(TAG, "Stop client");
 	}
 
+	void SyncHttpDictClient::setFormat(ContentFormat format) {
+		mFormat = format;
+	}
+
+	bool SyncHttpDictClient::checkConnection() {
+		if (mStarted && isPeerClosed(mStream.socket().native_handle())) {
+			log::info(TAG, "Http server closed connection");
+			mStarted = false;
+		}
+
+		return mStarted;
+	}
+
 	void SyncHttpDictClient::performPost(const Word& word) {
 		boost::system::error_code errorCode;
 		const std::string verbRequest = http::to_string(http::verb::post);
 
-		boost::system::result<std::string> localData = mParser.serializeToText(word);
+		boost::system::result<std::string> localData = serializeWord(word);
 
 		if (localData.has_error()) {
 			log::error(TAG, "Serialize word error: %s", errorCode.message().c_str());
@@ -91,7 +150,7 @@ namespace lynx {
 		}
 
 		http::request<http::string_body> request = prepareRequest(http::verb::post, "/post", localData.value());
-		http::write(mStream, request, errorCode);
+		errorCode = writeRequest(request);
 
 		if (!errorCode) {
 			log::debug(TAG, "Write request %s success", verbRequest.c_str());
@@ -100,9 +159,8 @@ namespace lynx {
 			return;
 		}
 
-		beast::flat_buffer buffer;
-		http::response<http::dynamic_body> response;
-		http::read(mStream, buffer, response, errorCode);
+		http::response_parser<http::dynamic_body> parser;
+		errorCode = readResponse(parser);
 
 		if (!errorCode) {
 			log::debug(TAG, "Read response %s success", verbRequest.c_str());
@@ -115,7 +173,7 @@ namespace lynx {
 		boost::system::error_code errorCode;
 		const std::string verbRequest = http::to_string(http::verb::put);
 
-		boost::system::result<std::string> localData = mParser.serializeToText(word);
+		boost::system::result<std::string> localData = serializeWord(word);
 
 		if (localData.has_error()) {
 			log::error(TAG, "Serialize word error: %s", errorCode.message().c_str());
@@ -123,7 +181,7 @@ namespace lynx {
 		}
 
 		http::request<http::string_body> request = prepareRequest(http::verb::put, "/put", localData.value());
-		http::write(mStream, request, errorCode);
+		errorCode = writeRequest(request);
 
 		if (!errorCode) {
 			log::debug(TAG, "Write request %s success", verbRequest.c_str());
@@ -132,9 +190,8 @@ namespace lynx {
 			return;
 		}
 
-		beast::flat_buffer buffer;
-		http::response<http::dynamic_body> response;
-		http::read(mStream, buffer, response, errorCode);
+		http::response_parser<http::dynamic_body> parser;
+		errorCode = readResponse(parser);
 
 		if (!errorCode) {
 			log::debug(TAG, "Read response %s success", verbRequest.c_str());
@@ -148,7 +205,7 @@ namespace lynx {
 		const std::string verbRequest = http::to_string(http::verb::delete_);
 
 		http::request<http::string_body> request = prepareRequest(http::verb::delete_, "/delete/" + std::to_string(id));
-		http::write(mStream, request, errorCode);
+		errorCode = writeRequest(request);
 
 		if (!errorCode) {
 			log::debug(TAG, "Write request %s/%lu success", verbRequest.c_str(), id);
@@ -157,9 +214,8 @@ namespace lynx {
 			return;
 		}
 
-		beast::flat_buffer buffer;
-		http::response<http::dynamic_body> response;
-		http::read(mStream, buffer, response, errorCode);
+		http::response_parser<http::dynamic_body> parser;
+		errorCode = readResponse(parser);
 
 		if (!errorCode) {
 			log::debug(TAG, "Read response %s/%lu success", verbRequest.c_str(), id);
@@ -168,12 +224,20 @@ namespace lynx {
 		}
 	}
 
+	auto SyncHttpDictClient::performPost(const std::vector<Word>& words) -> std::vector<WordStatus> {
+		return performBatch(http::verb::post, "/post/batch", words);
+	}
+
+	auto SyncHttpDictClient::performPut(const std::vector<Word>& words) -> std::vector<WordStatus> {
+		return performBatch(http::verb::put, "/put/batch", words);
+	}
+
 	auto SyncHttpDictClient::performGet(uint64_t id) -> Word {
 		boost::system::error_code errorCode;
 		const std::string verbRequest = http::to_string(http::verb::get);
 
 		http::request<http::string_body> request = prepareRequest(http::verb::get, "/get/" + std::to_string(id));
-		http::write(mStream, request, errorCode);
+		errorCode = writeRequest(request);
 
 		if (!errorCode) {
 			log::debug(TAG, "Write request %s/%lu success", verbRequest.c_str(), id);
@@ -182,9 +246,8 @@ namespace lynx {
 			return {};
 		}
 
-		beast::flat_buffer buffer;
-		http::response<http::dynamic_body> response;
-		http::read(mStream, buffer, response, errorCode);
+		http::response_parser<http::dynamic_body> parser;
+		errorCode = readResponse(parser);
 
 		if (!errorCode) {
 			log::debug(TAG, "Read response %s/%lu success", verbRequest.c_str(), id);
@@ -193,9 +256,15 @@ namespace lynx {
 			return {};
 		}
 
-		std::string remoteData = beast::buffers_to_string(response.body().data());
+		ContentFormat remoteFormat = mFormat;
+		boost::system::result<std::string> remoteData = decodeBody(parser.get(), BODY_LIMIT, remoteFormat);
+
+		if (remoteData.has_error()) {
+			log::error(TAG, "Decode response %s/%lu error: %s", verbRequest.c_str(), id, remoteData.error().message().c_str());
+			return {};
+		}
 
-		boost::system::result<Word> remoteWord = mParser.deserializeFromText(remoteData);
+		boost::system::result<Word> remoteWord = deserializeWord(*remoteData, remoteFormat);
 
 		if (remoteWord.has_value()) {
 			return *remoteWord;
@@ -206,11 +275,19 @@ namespace lynx {
 	}
 
 	auto SyncHttpDictClient::performGet() -> std::vector<Word> {
+		return performGetWords("/get");
+	}
+
+	auto SyncHttpDictClient::performGet(uint64_t afterId, std::size_t limit) -> std::vector<Word> {
+		return performGetWords(format("/get?after=%llu&limit=%zu", static_cast<unsigned long long>(afterId), limit));
+	}
+
+	auto SyncHttpDictClient::performGetWords(const std::string& target) -> std::vector<Word> {
 		boost::system::error_code errorCode;
 		const std::string verbRequest = http::to_string(http::verb::get);
 
-		http::request<http::string_body> request = prepareRequest(http::verb::get, "/get");
-		http::write(mStream, request, errorCode);
+		http::request<http::string_body> request = prepareRequest(http::verb::get, target);
+		errorCode = writeRequest(request);
 
 		if (!errorCode) {
 			log::debug(TAG, "Write request %s success", verbRequest.c_str());
@@ -219,9 +296,10 @@ namespace lynx {
 			return {};
 		}
 
-		beast::flat_buffer buffer;
-		http::response<http::dynamic_body> response;
-		http::read(mStream, buffer, response, errorCode);
+		/* whole dictionary comes as chunked body, which may outgrow default limit of parser */
+		http::response_parser<http::dynamic_body> parser;
+		parser.body_limit(WORDS_BODY_LIMIT);
+		errorCode = readResponse(parser);
 
 		if (!errorCode) {
 			log::debug(TAG, "Read response %s success", verbRequest.c_str());
@@ -230,9 +308,15 @@ namespace lynx {
 			return {};
 		}
 
-		std::string remoteData = beast::buffers_to_string(response.body().data());
+		ContentFormat remoteFormat = mFormat;
+		boost::system::result<std::string> remoteData = decodeBody(parser.get(), WORDS_BODY_LIMIT, remoteFormat);
 
-		boost::system::result<std::vector<Word>> remoteWords = mParser.deserializeWordsFromText(remoteData);
+		if (remoteData.has_error()) {
+			log::error(TAG, "Decode response %s error: %s", verbRequest.c_str(), remoteData.error().message().c_str());
+			return {};
+		}
+
+		boost::system::result<std::vector<Word>> remoteWords = deserializeWords(*remoteData, remoteFormat);
 
 		if (remoteWords.has_value()) {
 			return *remoteWords;
@@ -242,19 +326,213 @@ namespace lynx {
 		}
 	}
 
+	auto SyncHttpDictClient::performBatch(http::verb method, const std::string& target, const std::vector<Word>& words)
+		-> std::vector<WordStatus> {
+		boost::system::error_code errorCode;
+		const std::string verbRequest = http::to_string(method);
+
+		boost::system::result<std::string> localData = serializeWords(words);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
+			return {};
+		}
+
+		http::request<http::string_body> request = prepareRequest(method, target, localData.value());
+		errorCode = writeRequest(request);
+
+		if (!errorCode) {
+			log::debug(TAG, "Write request %s %s success", verbRequest.c_str(), target.c_str());
+		} else {
+			log::error(TAG, "Can't write request %s %s: %s", verbRequest.c_str(), target.c_str(), errorCode.message().c_str());
+			return {};
+		}
+
+		http::response_parser<http::dynamic_body> parser;
+		errorCode = readResponse(parser);
+
+		if (!errorCode) {
+			log::debug(TAG, "Read response %s %s success", verbRequest.c_str(), target.c_str());
+		} else {
+			log::error(TAG, "Can't read response %s %s: %s", verbRequest.c_str(), target.c_str(), errorCode.message().c_str());
+			return {};
+		}
+
+		ContentFormat remoteFormat = mFormat;
+		boost::system::result<std::string> remoteData = decodeBody(parser.get(), BODY_LIMIT, remoteFormat);
+
+		if (remoteData.has_error()) {
+			log::error(TAG, "Decode response %s error: %s", verbRequest.c_str(), remoteData.error().message().c_str());
+			return {};
+		}
+
+		boost::system::result<std::vector<WordStatus>> remoteStatuses = deserializeStatuses(*remoteData, remoteFormat);
+
+		if (remoteStatuses.has_value()) {
+			return *remoteStatuses;
+		} else {
+			log::error(TAG, "Deserialize statuses error %s", remoteStatuses.error().message().c_str());
+			return {};
+		}
+	}
+
+	auto SyncHttpDictClient::performGet(const std::vector<uint64_t>& ids) -> std::vector<Word> {
+		boost::system::error_code errorCode;
+		const std::string verbRequest = http::to_string(http::verb::get);
+		std::ostringstream localData;
+		std::vector<Word> words;
+
+		/* requests go out in one write, so whole batch costs one round trip instead of one per word */
+		for (uint64_t id : ids) {
+			localData << prepareRequest(http::verb::get, "/get/" + std::to_string(id));
+		}
+
+		net::write(mStream, net::buffer(localData.str()), errorCode);
+
+		if (!errorCode) {
+			log::debug(TAG, "Write %zu pipelined requests %s success", ids.size(), verbRequest.c_str());
+		} else {
+			log::error(TAG, "Can't write pipelined requests %s: %s", verbRequest.c_str(), errorCode.message().c_str());
+			mStarted = false;
+			return {};
+		}
+
+		words.reserve(ids.size());
+
+		/* server answers pipelined requests in order they were sent */
+		for (uint64_t id : ids) {
+			http::response_parser<http::dynamic_body> parser;
+			errorCode = readResponse(parser);
+
+			if (errorCode) {
+				log::error(TAG, "Can't read response %s/%lu: %s", verbRequest.c_str(), id, errorCode.message().c_str());
+				return words;
+			}
+
+			ContentFormat remoteFormat = mFormat;
+			boost::system::result<std::string> remoteData = decodeBody(parser.get(), BODY_LIMIT, remoteFormat);
+
+			if (parser.get().result() != http::status::ok || remoteData.has_error()) {
+				log::error(TAG, "Can't get word %lu: status %u", id, parser.get().result_int());
+				words.emplace_back();
+				continue;
+			}
+
+			boost::system::result<Word> remoteWord = deserializeWord(*remoteData, remoteFormat);
+
+			if (remoteWord.has_value()) {
+				words.push_back(std::move(*remoteWord));
+			} else {
+				log::error(TAG, "Deserialize word %lu error %s", id, remoteWord.error().message().c_str());
+				words.emplace_back();
+			}
+		}
+
+		return words;
+	}
+
+	auto SyncHttpDictClient::writeRequest(const http::request<http::string_body>& request) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		http::write(mStream, request, errorCode);
+
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		return errorCode;
+	}
+
+	auto SyncHttpDictClient::readResponse(http::response_parser<http::dynamic_body>& parser) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		http::read(mStream, mBuffer, parser, errorCode);
+
+		/* connection which server is going to close can't take next request */
+		if (errorCode || !parser.get().keep_alive()) {
+			mStarted = false;
+		}
+
+		return errorCode;
+	}
+
+	auto SyncHttpDictClient::decodeBody(const http::response<http::dynamic_body>& response, std::size_t bodyLimit,
+										ContentFormat& format) -> boost::system::result<std::string> {
+		const boost::core::string_view contentType = response[http::field::content_type];
+		const std::optional<ContentFormat> contentFormat = parseFormat(std::string_view(contentType.data(), contentType.size()));
+
+		/* server may answer in other format than asked, yet body of unknown type can't be read as words */
+		if (!contentFormat.has_value()) {
+			log::error(TAG, "Response has content type '%s' which isn't word format", std::string(contentType).c_str());
+			return boost::system::errc::make_error_code(boost::system::errc::not_supported);
+		}
+
+		format = *contentFormat;
+
+		const boost::core::string_view contentEncoding = response[http::field::content_encoding];
+		const ContentCoding coding = parseCoding(std::string_view(contentEncoding.data(), contentEncoding.size()));
+
+		return decompress(beast::buffers_to_string(response.body().data()), coding, bodyLimit);
+	}
+
 	auto SyncHttpDictClient::prepareRequest(http::verb method, const std::string& target, const std::string& body)
 		-> http::request<http::string_body> {
 		http::request<http::string_body> request;
 		request.set(http::field::host, mHost);
 		request.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+		request.set(http::field::accept_encoding, "gzip, deflate");
+		request.set(http::field::accept, toMime(mFormat));
 		request.target(target);
 		request.method(method);
+
+		if (!body.empty()) {
+			request.set(http::field::content_type, toMime(mFormat));
+		}
+
 		request.body() = body;
 		request.prepare_payload();
 
 		return request;
 	}
 
+	auto SyncHttpDictClient::serializeWord(const Word& word) -> boost::system::result<std::string> {
+		if (mFormat == ContentFormat::JSON) {
+			return mParser.serializeToText(word);
+		}
+
+		return toBody(mProtobufParser.serializeToBuffer(word));
+	}
+
+	auto SyncHttpDictClient::serializeWords(const std::vector<Word>& words) -> boost::system::result<std::string> {
+		if (mFormat == ContentFormat::JSON) {
+			return mParser.serializeWordsToText(words);
+		}
+
+		return toBody(mProtobufParser.serializeWordsToBuffer(words));
+	}
+
+	auto SyncHttpDictClient::deserializeWord(const std::string& body, ContentFormat format) -> boost::system::result<Word> {
+		if (format == ContentFormat::JSON) {
+			return mParser.deserializeFromText(body);
+		}
+
+		return mProtobufParser.deserializeFromBuffer(toBytes(body));
+	}
+
+	auto SyncHttpDictClient::deserializeWords(const std::string& body, ContentFormat format) -> boost::system::result<std::vector<Word>> {
+		if (format == ContentFormat::JSON) {
+			return mParser.deserializeWordsFromText(body);
+		}
+
+		return mProtobufParser.deserializeWordsFromBuffer(toBytes(body));
+	}
+
+	auto SyncHttpDictClient::deserializeStatuses(const std::string& body, ContentFormat format) -> boost::system::result<std::vector<WordStatus>> {
+		if (format == ContentFormat::JSON) {
+			return mParser.deserializeStatusesFromText(body);
+		}
+
+		return mProtobufParser.deserializeStatusesFromBuffer(toBytes(body));
+	}
+
 }
 
 
@@ -23,33 +23,51 @@
  */
 
 #include "http/SyncHttpDictServer.hpp"
+#include "concurrency/ThreadUtils.hpp"
 #include "logging/Logging.hpp"
-#include "util/StringUtils.hpp"
+#include "net/NetworkUtils.hpp"
 
+#include <algorithm>
+#include <optional>
 #include <thread>
-#include <charconv>
-
-#include <boost/beast/version.hpp>
 
 static constexpr const char* const TAG = "SyncHttpDictServer";
 static constexpr const char* const SERVER_TARGET = "/";
-static constexpr const char* const SERVER_MIME = "application/json";
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
 
 namespace lynx {
 
-	SyncHttpDictServer::SyncHttpDictServer(const std::string& host , uint16_t port)
+	SyncHttpDictServer::SyncHttpDictServer(const std::string& host , uint16_t port, const ReactorOptions& options,
+										   const SessionLimits& limits, const CompressionOptions& compression, const DumpOptions& dump)
 		: mHost(host)
 		, mPort(port)
-		, mAcceptor(mContext)
+		, mOptions(options)
+		, mLimits(limits)
 		, mSignals(mContext)
 		, mDictDao(host)
+		, mHandler(mDictDao, mDictDaoMutex, compression, dump)
+		, mDumper(mDictDao, mDictDaoMutex, dump)
 		, mStarted(false) {
 		log::info(TAG, "Create server");
 	}
 
+	SyncHttpDictServer::SyncHttpDictServer(const std::string& host, const std::string& socketPath, const SessionLimits& limits,
+										   const CompressionOptions& compression, const DumpOptions& dump)
+		: mHost(host)
+		, mPort(0)
+		, mSocketPath(socketPath)
+		, mOptions{ .threadCount = 1 }
+		, mLimits(limits)
+		, mSignals(mContext)
+		, mDictDao(host)
+		, mHandler(mDictDao, mDictDaoMutex, compression, dump)
+		, mDumper(mDictDao, mDictDaoMutex, dump)
+		, mStarted(false) {
+		log::info(TAG, "Create server on %s", socketPath.c_str());
+	}
+
 	SyncHttpDictServer::~SyncHttpDictServer() {
 		stop();
 		log::info(TAG, "Destroy server");
@@ -59,29 +77,118 @@ namespace lynx {
 
 	void SyncHttpDictServer::start() {
 		log::info(TAG, "Start server");
-		boost::system::error_code errorCode;
 
 		startSignalHandler();
 
-		mStarted = true;
 		mDictDao.start();
+		mDumper.start();
+
+		const uint32_t acceptorCount = (mOptions.mode == ReactorMode::SHARDED) ? std::max(mOptions.threadCount, 1u) : 1;
+
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			/* vector is filled before threads start, so it never reallocates under them */
+			try {
+				for (uint32_t i = 0; i < acceptorCount; ++i) {
+					mShardContexts.push_back(std::make_unique<net::io_context>(1));
+					mAcceptors.emplace_back(*mShardContexts.back());
+					openAcceptor(mAcceptors.back());
+				}
+			} catch (...) {
+				mAcceptors.clear();
+				mShardContexts.clear();
+				mDumper.stop();
+				mDictDao.stop();
+				throw;
+			}
+
+			mStarted = true;
+		}
+
+		std::vector<std::thread> acceptorThreads;
+
+		for (uint32_t i = 1; i < acceptorCount; ++i) {
+			acceptorThreads.emplace_back(&SyncHttpDictServer::acceptClients, this, i);
+		}
+		acceptClients(0);
+
+		for (std::thread& acceptorThread : acceptorThreads) {
+			acceptorThread.join();
+		}
+	}
+
+	void SyncHttpDictServer::stop() {
+		boost::system::error_code errorCode;
+
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+
+			for (stream_acceptor& acceptor : mAcceptors) {
+				acceptor.close(errorCode);
+
+				if (errorCode) {
+					log::error(TAG, "Can't close acceptor: %s", errorCode.message().c_str());
+				}
+			}
+		}
+
+		mDumper.stop();
+		mDictDao.stop();
+		log::info(TAG, "Stop server");
+	}
+
+	void SyncHttpDictServer::openAcceptor(stream_acceptor& acceptor) {
+		if (!mSocketPath.empty()) {
+			const net::generic::stream_protocol::endpoint endpoint = toLocalEndpoint(mSocketPath);
+
+			removeLocalSocket(mSocketPath);
+			acceptor.open(endpoint.protocol());
+			acceptor.bind(endpoint);
+			acceptor.listen();
+			return;
+		}
+
+		const net::generic::stream_protocol::endpoint endpoint = net::ip::tcp::endpoint(net::ip::tcp::v4(), mPort); /*net::ip::address::from_string(mHost)*/
+		acceptor.open(endpoint.protocol());
+		acceptor.set_option(net::socket_base::reuse_address(true));
+
+		if (mOptions.mode == ReactorMode::SHARDED) {
+			acceptor.set_option(reuse_port(true));
+		}
 
-		net::ip::tcp::endpoint endpoint(net::ip::tcp::v4(), mPort); /*net::ip::address::from_string(mHost)*/
-		mAcceptor.open(endpoint.protocol());
-		mAcceptor.set_option(net::ip::tcp::acceptor::reuse_address(true));
-		mAcceptor.bind(endpoint);
-		mAcceptor.listen();
+		acceptor.bind(endpoint);
+		acceptor.listen();
+	}
+
+	void SyncHttpDictServer::acceptClients(uint32_t acceptorIndex) {
+		boost::system::error_code errorCode;
+		stream_acceptor& acceptor = mAcceptors.at(acceptorIndex);
+
+		/* session threads inherit affinity of accepting thread, so connection stays on its cpu */
+		if (mOptions.pinThreads) {
+			const uint32_t cpu = acceptorIndex % std::max(std::thread::hardware_concurrency(), 1u);
+			boost::system::result<void> status = setAffinity(cpu);
+
+			if (status.has_error()) {
+				log::error(TAG, "Can't pin acceptor %u to cpu %u: %s", acceptorIndex, cpu, status.error().message().c_str());
+			}
+		}
 
 		while (mStarted) {
-			if (!mAcceptor.is_open()) {
+			if (!acceptor.is_open()) {
 				log::error(TAG, "Acceptor is already closed");
 				return;
 			}
 
-			net::ip::tcp::socket socket(mContext);
+			net::generic::stream_protocol::socket socket(*mShardContexts.at(acceptorIndex));
 
 			log::debug(TAG, "Ready accept client");
-			mAcceptor.accept(socket, errorCode);
+			acceptor.accept(socket, errorCode);
 
 			if (errorCode) {
 				log::error(TAG, "Can't accept client: %s", errorCode.message().c_str());
@@ -93,20 +200,6 @@ namespace lynx {
 		}
 	}
 
-	void SyncHttpDictServer::stop() {
-		boost::system::error_code errorCode;
-
-		mAcceptor.close(errorCode);
-
-		if (errorCode) {
-			log::error(TAG, "Can't close acceptor: %s", errorCode.message().c_str());
-		}
-
-		mStarted = false;
-		mDictDao.stop();
-		log::info(TAG, "Stop server");
-	}
-
 	void SyncHttpDictServer::startSignalHandler() {
 		mSignals.add(SIGINT);
 		mSignals.add(SIGTERM);
@@ -124,41 +217,66 @@ namespace lynx {
 		});
 	}
 
-	void SyncHttpDictServer::processSession(net::ip::tcp::socket& socket) {
+	void SyncHttpDictServer::processSession(net::generic::stream_protocol::socket& socket) {
 		boost::system::error_code errorCode;
 		beast::flat_buffer buffer;
 
-		while (mStarted) {
-			std::unique_ptr<http::message_generator> response;
-			http::request<http::string_body> request;
+		socket.non_blocking(true, errorCode);
 
-			http::read(socket, buffer, request, errorCode);
+		while (mStarted && !errorCode) {
+			std::unique_ptr<http::message_generator> response;
+			http::request_parser<http::string_body> parser;
+			std::optional<http::request_parser<JsonWordBody>> wordParser;
+
+			parser.body_limit(mLimits.maxMessageSize);
+			errorCode = readRequest(socket, buffer, parser, true);
+			const uint32_t version = parser.get().version();
+			const boost::core::string_view target = parser.get().target();
+			const HttpRouteMatch match = matchRoute(parser.get().method(), std::string_view(target.data(), target.size()));
+
+			const boost::core::string_view contentType = parser.get()[http::field::content_type];
+			const ContentFormat contentFormat = parseFormat(std::string_view(contentType.data(), contentType.size()))
+				.value_or(ContentFormat::JSON);
+
+			/* json word bodies are parsed while they arrive, other routes and protobuf keep string body */
+			if (!errorCode && JSON_WORD_STREAMING && isWordRoute(match.route) && contentFormat == ContentFormat::JSON) {
+				wordParser.emplace(std::move(parser));
+				wordParser->body_limit(mLimits.maxMessageSize);
+				errorCode = readRequest(socket, buffer, *wordParser, false);
+			} else if (!errorCode) {
+				errorCode = readRequest(socket, buffer, parser, false);
+			}
 
 			if (errorCode == http::error::end_of_stream) {
 				log::error(TAG, "Received request with EOF");
 				break;
+			} else if (errorCode == http::error::body_limit) {
+				/* rest of body is never read, so connection can't be reused */
+				log::error(TAG, "Received request exceeds %zu bytes", mLimits.maxMessageSize);
+				response = std::make_unique<http::message_generator>(mHandler.prepareResponse("Request body exceeds limit",
+						http::status::payload_too_large, version, false));
+				writeResponse(socket, *response);
+				break;
 			} else if (errorCode) {
+				/* timed out or broken peer, session thread is released */
 				log::error(TAG, "Received request isn't correct: %s", errorCode.message().c_str());
-				continue;
+				break;
 			}
 
-			if (request.method() == http::verb::post && request.target() == "/post") {
-				response = handlePostRequest(std::move(request));
-			} else if (request.method() == http::verb::put && request.target() == "/put") {
-				response = handlePutRequest(std::move(request));
-			} else if (request.method() == http::verb::delete_ && request.target().starts_with("/delete/")) {
-				response = handleDeleteRequest(std::move(request));
-			} else if (request.method() == http::verb::put && request.target() == "/get") {
-				response = handleGetAllRequest(std::move(request));
-			} if (request.method() == http::verb::get && request.target().starts_with("/get/")) {
-				response = handleGetByIdRequest(std::move(request));
+			const bool keepAlive = wordParser ? wordParser->get().keep_alive() : parser.get().keep_alive();
+
+			if (wordParser) {
+				response = routeRequest(wordParser->release(), match);
+				errorCode = writeResponse(socket, *response);
+			} else if (match.route == HttpRoute::GET_ALL) {
+				errorCode = streamWords(socket, parser.get());
+			} else if (match.route == HttpRoute::GET_DUMP) {
+				errorCode = sendDump(socket, parser.get());
 			} else {
-				log::error(TAG, "Received unknow http request");
+				response = routeRequest(parser.release(), match);
+				errorCode = writeResponse(socket, *response);
 			}
 
-			const bool keepAlive = response->keep_alive();
-			beast::write(socket, std::move(*response), errorCode);
-
 			if (errorCode) {
 				log::error(TAG, "Send response isn't correct: %s", errorCode.message().c_str());
 				return;
@@ -168,230 +286,231 @@ namespace lynx {
 				log::error(TAG, "Made response hasn't keep alive");
 				break;
 			}
-
-			std::this_thread::sleep_for(50ms);
 		}
 
-		socket.shutdown(net::ip::tcp::socket::shutdown_send, errorCode);
+		socket.shutdown(net::socket_base::shutdown_send, errorCode);
 	}
 
-	auto SyncHttpDictServer::handlePostRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
-		const uint32_t version = request.version();
-		const bool keepAlive = request.keep_alive();
-
-		if (!checkTarget(request.target())) {
-			const std::string message = "Received illegal request-target";
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-					                http::status::bad_request, version, keepAlive));
+	auto SyncHttpDictServer::routeRequest(http::request<JsonWordBody>&& request, const HttpRouteMatch& match)
+		-> std::unique_ptr<http::message_generator> {
+		switch (match.route) {
+		case HttpRoute::POST_WORD:
+			return mHandler.handlePostRequest(std::move(request));
+		case HttpRoute::PUT_WORD:
+			return mHandler.handlePutRequest(std::move(request));
+		case HttpRoute::POST_WORDS:
+			return mHandler.handlePostBatchRequest(std::move(request));
+		case HttpRoute::PUT_WORDS:
+			return mHandler.handlePutBatchRequest(std::move(request));
+		default:
+			break;
 		}
 
-		boost::system::result<Word> remoteWord = mParser.deserializeFromText(request.body());
+		log::error(TAG, "Received unknown http request");
+		return std::make_unique<http::message_generator>(mHandler.prepareResponse("Unknown request",
+				http::status::not_found, request.version(), request.keep_alive()));
+	}
 
-		if (remoteWord.has_error()) {
-			const std::string message = format("Deserialize request word error %s",
-											   remoteWord.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+	auto SyncHttpDictServer::routeRequest(http::request<http::string_body>&& request, const HttpRouteMatch& match)
+		-> std::unique_ptr<http::message_generator> {
+		switch (match.route) {
+		case HttpRoute::POST_WORD:
+		case HttpRoute::PUT_WORD:
+			return routeRequest(mHandler.decodeWordRequest(std::move(request), false), match);
+		case HttpRoute::POST_WORDS:
+		case HttpRoute::PUT_WORDS:
+			return routeRequest(mHandler.decodeWordRequest(std::move(request), true), match);
+		case HttpRoute::DELETE_WORD:
+			return mHandler.handleDeleteRequest(std::move(request), match.wordId);
+		case HttpRoute::GET_PAGE:
+			return mHandler.handleGetPageRequest(std::move(request));
+		case HttpRoute::GET_WORD:
+			return mHandler.handleGetByIdRequest(std::move(request), match.wordId);
+		default:
+			break;
 		}
 
-		boost::system::result<void> operationStatus = mDictDao.insert(remoteWord.value());
-
-		if (operationStatus.has_value()) {
-			const std::string message = "Handle POST/ request success";
-			log::debug(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::ok, version, keepAlive));
-		} else {
-			const auto message = format("Db insert word error %s",
-					                    operationStatus.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
-		}
+		log::error(TAG, "Received unknown http request");
+		return std::make_unique<http::message_generator>(mHandler.prepareResponse("Unknown request",
+				http::status::not_found, request.version(), request.keep_alive()));
 	}
 
-	auto SyncHttpDictServer::handlePutRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
-		const uint32_t version = request.version();
-		const bool keepAlive = request.keep_alive();
+	template<class Body>
+	auto SyncHttpDictServer::readRequest(net::generic::stream_protocol::socket& socket, beast::flat_buffer& buffer,
+										 http::request_parser<Body>& parser, bool headerOnly) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		bool started = parser.got_some() || buffer.size() != 0;
+		auto deadline = std::chrono::steady_clock::now() + (started ? mLimits.readTimeout : mLimits.idleTimeout);
+
+		while (true) {
+			/* parser keeps its state, so read continues where would_block stopped it */
+			if (headerOnly) {
+				http::read_header(socket, buffer, parser, errorCode);
+			} else if (!parser.is_done()) {
+				http::read(socket, buffer, parser, errorCode);
+			} else {
+				return {};
+			}
 
-		if (!checkTarget(request.target())) {
-			const std::string message = "Received illegal request-target";
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-					                http::status::bad_request, version, keepAlive));
-		}
+			if (errorCode != net::error::would_block) {
+				return errorCode;
+			}
 
-		boost::system::result<Word> remoteWord = mParser.deserializeFromText(request.body());
+			/* idle timeout runs until request is started, read timeout after that */
+			if (!started && (parser.got_some() || buffer.size() != 0)) {
+				started = true;
+				deadline = std::chrono::steady_clock::now() + mLimits.readTimeout;
+			}
 
-		if (remoteWord.has_error()) {
-			const std::string message = format("Deserialize request word error %s",
-											   remoteWord.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
-		}
+			errorCode = waitReadable(socket.native_handle(), deadline);
 
-		boost::system::result<void> operationStatus = mDictDao.update(remoteWord.value());
-
-		if (operationStatus.has_value()) {
-			const std::string message = "Handle PUT/ request success";
-			log::debug(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::ok, version, keepAlive));
-		} else {
-			const auto message = format("Db update word error %s",
-										operationStatus.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+			if (errorCode) {
+				return errorCode;
+			}
 		}
 	}
 
-	auto SyncHttpDictServer::handleDeleteRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
-		const uint32_t version = request.version();
-		const bool keepAlive = request.keep_alive();
+	auto SyncHttpDictServer::writeResponse(net::generic::stream_protocol::socket& socket, http::message_generator& response)
+		-> boost::system::error_code {
+		boost::system::error_code errorCode;
+		const auto deadline = std::chrono::steady_clock::now() + mLimits.writeTimeout;
+
+		/* written bytes are consumed one by one, so partial write on full socket buffer is resumed without loss */
+		while (!response.is_done()) {
+			const http::message_generator::const_buffers_type localBuffers = response.prepare(errorCode);
 
-		if (!checkTarget(request.target())) {
-			const std::string message = "Received illegal request-target";
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-					                http::status::bad_request, version, keepAlive));
-		}
+			if (errorCode) {
+				return errorCode;
+			}
 
-		uint64_t wordId = 0;
-		std::string remoteData = request.target().substr(request.target().find_last_of("/") + 1);
-		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+			response.consume(socket.write_some(localBuffers, errorCode));
 
-		if (remoteWordId.ec != std::errc{}) {
-			const std::string message = format("Parse word id error: %s",
-											   std::make_error_code(remoteWordId.ec).message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
-		}
+			if (errorCode == net::error::would_block) {
+				errorCode = waitWritable(socket.native_handle(), deadline);
+			}
 
-		boost::system::result<void> operationStatus = mDictDao.remove(wordId);
-
-		if (operationStatus.has_value()) {
-			const std::string message = format("Handle DELETE/%u/ request success", wordId);
-			log::debug(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::ok, version, keepAlive));
-		} else {
-			const auto message = format("Db delete word error %s",
-										operationStatus.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+			if (errorCode) {
+				return errorCode;
+			}
 		}
+
+		return {};
 	}
 
-	auto SyncHttpDictServer::handleGetByIdRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
-		const uint32_t version = request.version();
-		const bool keepAlive = request.keep_alive();
+	auto SyncHttpDictServer::streamWords(net::generic::stream_protocol::socket& socket, const http::request<http::string_body>& request)
+		-> boost::system::error_code {
+		WordStreamCursor cursor;
+		http::response<http::buffer_body> response = mHandler.prepareStreamResponse(request, cursor);
+		boost::system::result<std::string> piece = mHandler.readWordStream(cursor);
 
-		if (!checkTarget(request.target())) {
-			const std::string message = "Received illegal request-target";
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-					                http::status::bad_request, version, keepAlive));
+		if (piece.has_error()) {
+			http::message_generator errorResponse(mHandler.prepareResponse("Db get all words error",
+					http::status::internal_server_error, request.version(), request.keep_alive()));
+			return writeResponse(socket, errorResponse);
 		}
 
-		uint64_t wordId = 0;
-		std::string remoteData = request.target().substr(request.target().find_last_of("/") + 1);
-		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+		http::response_serializer<http::buffer_body> serializer(response);
 
-		if (remoteWordId.ec != std::errc{}) {
-			const std::string message = format("Parse word id error: %s",
-											   std::make_error_code(remoteWordId.ec).message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
-		}
+		while (true) {
+			/* empty chunk would end body, and compressor may keep whole piece in its buffer */
+			if (!piece->empty()) {
+				response.body().data = piece->data();
+				response.body().size = piece->size();
+				response.body().more = true;
 
-		boost::system::result<Word> localWord = mDictDao.getById(wordId);
+				const boost::system::error_code errorCode = writeChunk(socket, serializer);
 
-		if (localWord.has_error()) {
-			const std::string message = format("Db get word by id error: %s",
-											   localWord.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
-		}
+				if (errorCode) {
+					return errorCode;
+				}
+			}
+
+			if (cursor.finished) {
+				break;
+			}
 
-		boost::system::result<std::string> localData = mParser.serializeToText(*localWord);
-
-		if (localData.has_value()) {
-			const std::string message = format("Handle GET/%u/ request success", wordId);
-			log::debug(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(*localData,
-									http::status::ok, version, keepAlive));
-		} else {
-			const auto message = format("Serialize word error: %s",
-										localData.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+			piece = mHandler.readWordStream(cursor);
+
+			if (piece.has_error()) {
+				/* status line is already sent, so only unfinished chunked body tells client that response is broken */
+				return piece.error();
+			}
 		}
+
+		response.body().data = nullptr;
+		response.body().size = 0;
+		response.body().more = false;
+
+		return writeChunk(socket, serializer);
 	}
 
-	auto SyncHttpDictServer::handleGetAllRequest(http::request<http::string_body>&& request) -> std::unique_ptr<http::message_generator> {
-		const uint32_t version = request.version();
-		const bool keepAlive = request.keep_alive();
+	auto SyncHttpDictServer::writeChunk(net::generic::stream_protocol::socket& socket,
+										http::response_serializer<http::buffer_body>& serializer) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		const auto deadline = std::chrono::steady_clock::now() + mLimits.writeTimeout;
 
-		if (!checkTarget(request.target())) {
-			const std::string message = "Received illegal request-target";
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-					                http::status::bad_request, version, keepAlive));
-		}
+		/* need_buffer means that piece is sent and serializer waits for next one */
+		while (!serializer.is_done()) {
+			http::write_some(socket, serializer, errorCode);
 
-		boost::system::result<std::vector<Word>> localWords = mDictDao.getAll();
+			if (errorCode == http::error::need_buffer) {
+				return {};
+			} else if (errorCode == net::error::would_block) {
+				errorCode = waitWritable(socket.native_handle(), deadline);
+			}
 
-		if (localWords.has_error()) {
-			const std::string message = format("Db get all words error: %s",
-											   localWords.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+			if (errorCode) {
+				return errorCode;
+			}
 		}
 
+		return {};
+	}
 
-		boost::system::result<std::string> localData = mParser.serializeWordsToText(*localWords);
+	auto SyncHttpDictServer::sendDump(net::generic::stream_protocol::socket& socket, const http::request<http::string_body>& request)
+		-> boost::system::error_code {
+		boost::system::error_code errorCode;
+		DumpFile dump;
+		std::unique_ptr<http::message_generator> response = mHandler.handleDumpRequest(request, dump);
 
-		if (localData.has_value()) {
-			const std::string message = format("Handle GET/ request success");
-			log::debug(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(*localData,
-									http::status::ok, version, keepAlive));
-		} else {
-			const auto message = format("Serialize words error: %s",
-										localData.error().message().c_str());
-			log::error(TAG, message);
-			return std::make_unique<http::message_generator>(prepareResponse(message,
-									http::status::internal_server_error, version, keepAlive));
+		if (response) {
+			return writeResponse(socket, *response);
 		}
-	}
 
-	auto SyncHttpDictServer::prepareResponse(const std::string& body, http::status status, uint32_t version, bool keepAlive)
-		-> http::response<http::string_body> {
-		http::response<http::string_body> response{status, version};
-		response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
-		response.set(http::field::content_type, SERVER_MIME);
-		response.keep_alive(keepAlive);
-		response.body() = body;
-		response.prepare_payload();
+		http::response_serializer<http::file_body> serializer(dump.response);
+		auto deadline = std::chrono::steady_clock::now() + mLimits.writeTimeout;
 
-		return response;
-	}
+		/* serializer stops after header, its own body writer would read file through user space buffer */
+		serializer.split(true);
 
-	bool SyncHttpDictServer::checkTarget(boost::core::string_view target) const {
-		return !target.empty() || target[0] == '/' || target.find("..") == boost::core::string_view::npos;
-	}
-}
+		while (!serializer.is_header_done()) {
+			http::write_header(socket, serializer, errorCode);
+
+			if (errorCode == net::error::would_block) {
+				errorCode = waitWritable(socket.native_handle(), deadline);
+			}
 
+			if (errorCode) {
+				return errorCode;
+			}
+		}
 
+		const int fileFd = dump.response.body().file().native_handle();
 
+		while (dump.size != 0) {
+			errorCode = sendFile(socket.native_handle(), fileFd, dump.offset, dump.size);
 
+			/* dump may be large, so timeout bounds stalled peer instead of whole transfer */
+			if (errorCode == net::error::would_block) {
+				deadline = std::chrono::steady_clock::now() + mLimits.writeTimeout;
+				errorCode = waitWritable(socket.native_handle(), deadline);
+			}
+
+			if (errorCode) {
+				return errorCode;
+			}
+		}
+
+		return {};
+	}
+}
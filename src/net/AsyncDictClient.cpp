@@ -0,0 +1,357 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/AsyncDictClient.hpp"
+#include "net/NetworkUtils.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+
+#include <optional>
+
+static constexpr const char* const TAG = "AsyncDictClient";
+
+using namespace std::string_literals;
+
+namespace lynx {
+
+	/* caller sleeps on timer which reader cancels once reply is stored */
+	struct AsyncDictClient::PendingFrame final {
+		explicit PendingFrame(const net::strand<net::io_context::executor_type>& strand)
+			: signal(strand, net::steady_timer::time_point::max()) {
+		}
+
+		net::steady_timer signal;
+		std::optional<boost::system::result<DictFrame>> frame;
+	};
+
+	/* state of connection, it is only touched on strand */
+	struct AsyncDictClient::Connection final {
+		explicit Connection(const net::strand<net::io_context::executor_type>& strand)
+			: socket(strand)
+			, writeSignal(strand, net::steady_timer::time_point::max())
+			, lastRequestId(0)
+			, started(false) {
+		}
+
+		net::ip::tcp::socket socket;
+		net::steady_timer writeSignal;
+		std::deque<DictFrame> outgoingFrames;
+		std::unordered_map<uint32_t, std::shared_ptr<PendingFrame>> pendingFrames;
+
+		uint32_t lastRequestId;
+		std::atomic_bool started;
+	};
+
+	AsyncDictClient::AsyncDictClient(net::io_context& context, const std::string& host, uint16_t port)
+		: mStrand(net::make_strand(context))
+		, mEndpoint(net::ip::address::from_string(host), port)
+		, mConnection(std::make_shared<Connection>(mStrand)) {
+		log::info(TAG, "Create client");
+	}
+
+	AsyncDictClient::~AsyncDictClient() {
+		/* socket is closed on strand, reader and writer then end with connection they own */
+		net::dispatch(mStrand, [connection = mConnection]() {
+			boost::system::error_code errorCode;
+
+			connection->started = false;
+			connection->writeSignal.cancel();
+			connection->socket.close(errorCode);
+		});
+
+		log::info(TAG, "Destroy client");
+	}
+
+	bool AsyncDictClient::isStarted() const { return mConnection->started; }
+
+	auto AsyncDictClient::start() -> net::awaitable<boost::system::result<void>> {
+		return start(net::use_awaitable);
+	}
+
+	void AsyncDictClient::stop() {
+		/* writer flushes frames queued so far and closes socket, which ends reader too */
+		net::dispatch(mStrand, [connection = mConnection]() {
+			connection->started = false;
+			connection->writeSignal.cancel();
+			log::info(TAG, "Stop client");
+		});
+	}
+
+	void AsyncDictClient::quit() {
+		net::dispatch(mStrand, [connection = mConnection]() {
+			if (connection->started) {
+				connection->outgoingFrames.push_back(makeFrame(DictOpcode::QUIT, ++connection->lastRequestId));
+				connection->writeSignal.cancel();
+			}
+		});
+	}
+
+	auto AsyncDictClient::insert(const Word& word) -> net::awaitable<boost::system::result<void>> {
+		return insert(word, net::use_awaitable);
+	}
+
+	auto AsyncDictClient::update(const Word& word) -> net::awaitable<boost::system::result<void>> {
+		return update(word, net::use_awaitable);
+	}
+
+	auto AsyncDictClient::remove(uint64_t id) -> net::awaitable<boost::system::result<void>> {
+		return remove(id, net::use_awaitable);
+	}
+
+	auto AsyncDictClient::getById(uint64_t id) -> net::awaitable<boost::system::result<Word>> {
+		return getById(id, net::use_awaitable);
+	}
+
+	auto AsyncDictClient::getAll() -> net::awaitable<boost::system::result<std::vector<Word>>> {
+		return getAll(net::use_awaitable);
+	}
+
+	auto AsyncDictClient::ping() -> net::awaitable<boost::system::result<void>> {
+		return ping(net::use_awaitable);
+	}
+
+	auto AsyncDictClient::performConnect() -> net::awaitable<boost::system::result<void>> {
+		log::info(TAG, "Start client");
+
+		boost::system::error_code errorCode;
+		net::ip::tcp::socket& socket = mConnection->socket;
+		co_await socket.async_connect(mEndpoint, net::redirect_error(net::use_awaitable, errorCode));
+
+		if (errorCode) {
+			log::error(TAG, "Can't connect to server: %s", errorCode.message().c_str());
+			co_return errorCode;
+		}
+
+		socket.set_option(net::ip::tcp::no_delay(true), errorCode);
+
+		const std::string localData = PROTOCOL_V2_COMMAND + "\n"s;
+		co_await net::async_write(socket, net::buffer(localData), net::redirect_error(net::use_awaitable, errorCode));
+
+		if (errorCode) {
+			log::error(TAG, "Can't send message %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+			co_return errorCode;
+		}
+
+		/* server sends nothing after acknowledge until first frame, so buffer holds exactly one line */
+		std::string remoteData;
+		co_await net::async_read_until(socket, net::dynamic_buffer(remoteData), "\n", net::redirect_error(net::use_awaitable, errorCode));
+
+		if (errorCode || !remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+			log::error(TAG, "Server doesn't support %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+			co_return errorCode ? errorCode : boost::system::errc::make_error_code(boost::system::errc::protocol_not_supported);
+		}
+
+		log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+		mConnection->started = true;
+
+		net::co_spawn(mStrand, readFrames(mConnection), net::detached);
+		net::co_spawn(mStrand, writeFrames(mConnection), net::detached);
+
+		co_return boost::system::result<void>();
+	}
+
+	auto AsyncDictClient::performStatusFrame(DictOpcode opcode, boost::system::result<std::vector<std::byte>> payload)
+		-> net::awaitable<boost::system::result<void>> {
+		if (payload.has_error()) {
+			log::error(TAG, "Serialize payload error: %s", payload.error().message().c_str());
+			co_return payload.error();
+		}
+
+		boost::system::result<DictFrame> remoteFrame = co_await performFrame(opcode, std::move(*payload));
+
+		if (remoteFrame.has_error()) {
+			co_return remoteFrame.error();
+		}
+
+		co_return boost::system::result<void>();
+	}
+
+	auto AsyncDictClient::performGetById(boost::system::result<std::vector<std::byte>> payload) -> net::awaitable<boost::system::result<Word>> {
+		if (payload.has_error()) {
+			log::error(TAG, "Serialize word id error: %s", payload.error().message().c_str());
+			co_return payload.error();
+		}
+
+		boost::system::result<DictFrame> remoteFrame = co_await performFrame(DictOpcode::GET_BY_ID, std::move(*payload));
+
+		if (remoteFrame.has_error()) {
+			co_return remoteFrame.error();
+		}
+
+		co_return mParser.deserializeFromBuffer(remoteFrame->payload);
+	}
+
+	auto AsyncDictClient::performGetAll() -> net::awaitable<boost::system::result<std::vector<Word>>> {
+		boost::system::result<DictFrame> remoteFrame = co_await performFrame(DictOpcode::GET_ALL, {});
+
+		if (remoteFrame.has_error()) {
+			co_return remoteFrame.error();
+		}
+
+		co_return mParser.deserializeWordsFromBuffer(remoteFrame->payload);
+	}
+
+	auto AsyncDictClient::performFrame(DictOpcode opcode, std::vector<std::byte> payload) -> net::awaitable<boost::system::result<DictFrame>> {
+		if (!mConnection->started) {
+			co_return std::make_error_code(std::errc::not_connected);
+		}
+
+		const uint32_t requestId = ++mConnection->lastRequestId;
+		auto pending = std::make_shared<PendingFrame>(mStrand);
+
+		mConnection->pendingFrames.emplace(requestId, pending);
+		mConnection->outgoingFrames.push_back(makeFrame(opcode, requestId, std::move(payload)));
+		mConnection->writeSignal.cancel();
+
+		/* reply can't arrive before wait starts, strand runs nothing else until we suspend */
+		boost::system::error_code errorCode;
+		co_await pending->signal.async_wait(net::redirect_error(net::use_awaitable, errorCode));
+
+		if (!pending->frame.has_value()) {
+			co_return boost::system::error_code(net::error::operation_aborted);
+		}
+
+		co_return std::move(*pending->frame);
+	}
+
+	auto AsyncDictClient::readFrames(std::shared_ptr<Connection> connection) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+		std::array<std::byte, DICT_FRAME_HEADER_SIZE> remoteHeader;
+
+		while (connection->started) {
+			co_await net::async_read(connection->socket, net::buffer(remoteHeader), net::redirect_error(net::use_awaitable, errorCode));
+
+			if (errorCode) {
+				log::debug(TAG, "Receive frame header isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(remoteHeader);
+
+			if (header.has_error()) {
+				log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+				errorCode = header.error();
+				break;
+			}
+
+			DictFrame remoteFrame = { .header = *header, .payload = std::vector<std::byte>(header->payloadSize) };
+			co_await net::async_read(connection->socket, net::buffer(remoteFrame.payload), net::redirect_error(net::use_awaitable, errorCode));
+
+			if (errorCode) {
+				log::error(TAG, "Receive frame payload isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			auto node = connection->pendingFrames.extract(remoteFrame.header.requestId);
+
+			if (node.empty()) {
+				log::error(TAG, "Receive frame %u without request", remoteFrame.header.requestId);
+				continue;
+			}
+
+			PendingFrame& pending = *node.mapped();
+
+			if (remoteFrame.header.status == DictStatus::FAILURE) {
+				const std::string message(reinterpret_cast<const char*>(remoteFrame.payload.data()), remoteFrame.payload.size());
+				log::error(TAG, "Server failed to process frame %u: %s", remoteFrame.header.requestId, message.c_str());
+				pending.frame = boost::system::errc::make_error_code(boost::system::errc::io_error);
+			} else {
+				pending.frame = std::move(remoteFrame);
+			}
+
+			pending.signal.cancel();
+		}
+
+		connection->started = false;
+		connection->writeSignal.cancel();
+		completeFrames(*connection, errorCode ? errorCode : boost::system::error_code(net::error::not_connected));
+	}
+
+	auto AsyncDictClient::writeFrames(std::shared_ptr<Connection> connection) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+
+		std::vector<DictFrame> flushingFrames;
+		std::vector<std::array<std::byte, DICT_FRAME_HEADER_SIZE>> flushingHeaders;
+		std::vector<net::const_buffer> flushingBuffers;
+
+		while (true) {
+			while (connection->outgoingFrames.empty()) {
+				if (!connection->started) {
+					connection->socket.shutdown(net::ip::tcp::socket::shutdown_both, errorCode);
+					connection->socket.close(errorCode);
+					co_return;
+				}
+
+				connection->writeSignal.expires_at(net::steady_timer::time_point::max());
+				co_await connection->writeSignal.async_wait(net::redirect_error(net::use_awaitable, errorCode));
+			}
+
+			/* requests of all callers queued meanwhile go out with one gather write */
+			while (!connection->outgoingFrames.empty() && flushingFrames.size() < DICT_FRAME_MAX_FLUSH_COUNT) {
+				flushingFrames.push_back(std::move(connection->outgoingFrames.front()));
+				connection->outgoingFrames.pop_front();
+			}
+
+			flushingHeaders.reserve(flushingFrames.size());
+
+			for (const DictFrame& localFrame : flushingFrames) {
+				flushingHeaders.push_back(encodeFrameHeader(localFrame.header));
+				flushingBuffers.push_back(net::buffer(flushingHeaders.back()));
+				flushingBuffers.push_back(net::buffer(localFrame.payload));
+			}
+
+			co_await net::async_write(connection->socket, flushingBuffers, net::redirect_error(net::use_awaitable, errorCode));
+
+			flushingFrames.clear();
+			flushingHeaders.clear();
+			flushingBuffers.clear();
+
+			if (errorCode) {
+				log::error(TAG, "Can't send frames: %s", errorCode.message().c_str());
+				connection->started = false;
+				connection->outgoingFrames.clear();
+				connection->socket.shutdown(net::ip::tcp::socket::shutdown_both, errorCode);
+			}
+		}
+	}
+
+	void AsyncDictClient::completeFrames(Connection& connection, boost::system::error_code errorCode) {
+		std::unordered_map<uint32_t, std::shared_ptr<PendingFrame>> pendingFrames;
+		pendingFrames.swap(connection.pendingFrames);
+
+		for (auto& [requestId, pending] : pendingFrames) {
+			pending->frame = errorCode;
+			pending->signal.cancel();
+		}
+	}
+}
@@ -0,0 +1,406 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/AsyncDictServer.hpp"
+#include "net/DictRequestHandler.hpp"
+#include "net/NetworkUtils.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+
+#include <deque>
+
+static constexpr const char* const TAG = "AsyncDictServer";
+
+namespace lynx {
+
+	/*
+	 * State of connection switched to protocol v2. Frames are read in order, but
+	 * processed concurrently on the thread pool, so replies are queued in order
+	 * of completion and matched by client with request id.
+	 * Queue and counters are only touched on session strand.
+	 */
+	struct AsyncDictServer::FrameSession final {
+		FrameSession(net::ip::tcp::socket&& socket, const net::any_io_executor& strand,
+					 SyncDictDao& dictDao, std::mutex& dictDaoMutex)
+			: socket(std::move(socket))
+			, strand(strand)
+			, signal(strand, net::steady_timer::time_point::max())
+			, handler(dictDao, dictDaoMutex)
+			, inFlightCount(0)
+			, reading(true)
+			, writing(true) {
+		}
+
+		net::ip::tcp::socket socket;
+		net::any_io_executor strand;
+		net::steady_timer signal;
+
+		DictRequestHandler handler;
+		std::deque<DictFrame> outgoingFrames;
+		/* streams which found queue full wait here until writer takes frames from it */
+		std::vector<DictStreamCursor> pausedStreams;
+
+		/* reused by every flush, so batched write doesn't allocate after warm up */
+		std::vector<DictFrame> flushingFrames;
+		std::vector<std::array<std::byte, DICT_FRAME_HEADER_SIZE>> flushingHeaders;
+		std::vector<net::const_buffer> flushingBuffers;
+		uint32_t inFlightCount;
+		bool reading;
+		bool writing;
+	};
+
+	AsyncDictServer::AsyncDictServer(const std::string& host, uint16_t port, const ReactorOptions& options)
+		: mPort(port)
+		, mReactors(options)
+		, mDictDao(host)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+	}
+
+	AsyncDictServer::~AsyncDictServer() {
+		stop();
+		log::info(TAG, "Destroy server");
+	}
+
+	bool AsyncDictServer::isStarted() const { return mStarted; }
+
+	void AsyncDictServer::start() {
+		const ReactorOptions& options = mReactors.getOptions();
+		log::info(TAG, "Start server with %u threads, %u contexts", options.threadCount, mReactors.getContextCount());
+
+		mDictDao.start();
+
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			/* in sharded mode every context accepts on its own socket bound to same port */
+			for (uint32_t i = 0; i < mReactors.getContextCount(); ++i) {
+				mAcceptors.emplace_back(mReactors.getContext(i));
+				boost::system::error_code errorCode = openAcceptor(mAcceptors.back());
+
+				if (errorCode) {
+					log::error(TAG, "Can't listen on port %u: %s", mPort, errorCode.message().c_str());
+					mAcceptors.clear();
+					mDictDao.stop();
+					return;
+				}
+			}
+
+			mStarted = true;
+
+			for (net::ip::tcp::acceptor& acceptor : mAcceptors) {
+				net::co_spawn(acceptor.get_executor(), acceptClients(acceptor), net::detached);
+			}
+		}
+
+		/* contexts stopped before run keep stopped state, so stop which came after lock above isn't lost */
+		mReactors.run();
+
+		std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+		mAcceptors.clear();
+	}
+
+	void AsyncDictServer::stop() {
+		{
+			std::lock_guard<std::mutex> lock(mAcceptorsMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+
+			mReactors.stop();
+		}
+
+		mDictDao.stop();
+		log::info(TAG, "Stop server");
+	}
+
+	auto AsyncDictServer::openAcceptor(net::ip::tcp::acceptor& acceptor) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+		net::ip::tcp::endpoint endpoint(net::ip::tcp::v4(), mPort);
+
+		acceptor.open(endpoint.protocol(), errorCode);
+
+		if (!errorCode) {
+			acceptor.set_option(net::ip::tcp::acceptor::reuse_address(true), errorCode);
+		}
+		if (!errorCode && mReactors.getContextCount() > 1) {
+			acceptor.set_option(reuse_port(true), errorCode);
+		}
+		if (!errorCode) {
+			acceptor.bind(endpoint, errorCode);
+		}
+		if (!errorCode) {
+			acceptor.listen(net::socket_base::max_listen_connections, errorCode);
+		}
+
+		return errorCode;
+	}
+
+	auto AsyncDictServer::acceptClients(net::ip::tcp::acceptor& acceptor) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+
+		while (mStarted) {
+			net::ip::tcp::socket socket = co_await acceptor.async_accept(
+					net::redirect_error(net::use_awaitable, errorCode));
+
+			if (errorCode) {
+				log::error(TAG, "Can't accept client: %s", errorCode.message().c_str());
+
+				if (errorCode == net::error::operation_aborted) {
+					co_return;
+				}
+				continue;
+			}
+
+			log::debug(TAG, "Accept client %s", socket.remote_endpoint(errorCode).address().to_string().c_str());
+
+			/* session stays on context of acceptor, so in sharded mode connection never leaves its core */
+			net::co_spawn(net::make_strand(acceptor.get_executor()), processSession(std::move(socket)), net::detached);
+		}
+	}
+
+	auto AsyncDictServer::processSession(net::ip::tcp::socket socket) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+		DictRequestHandler handler(mDictDao, mDictDaoMutex);
+		std::string remoteBuffer;
+		std::string localBuffer;
+
+		while (mStarted) {
+			const std::size_t messageSize = co_await net::async_read_until(socket, net::dynamic_buffer(remoteBuffer), "\n",
+					net::redirect_error(net::use_awaitable, errorCode));
+
+			if (errorCode == net::error::eof) {
+				log::debug(TAG, "Client closed connection");
+				break;
+			} else if (errorCode) {
+				log::error(TAG, "Receive data isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			const std::string_view remoteData(remoteBuffer.data(), messageSize);
+
+			if (remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+				remoteBuffer.erase(0, messageSize);
+				localBuffer.append(PROTOCOL_V2_COMMAND).append(" processed success\n");
+
+				co_await net::async_write(socket, net::buffer(localBuffer), net::redirect_error(net::use_awaitable, errorCode));
+
+				if (errorCode) {
+					log::error(TAG, "Can't send %s reply: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+					break;
+				}
+
+				log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+
+				auto strand = co_await net::this_coro::executor;
+				auto session = std::make_shared<FrameSession>(std::move(socket), strand, mDictDao, mDictDaoMutex);
+				session->socket.set_option(net::ip::tcp::no_delay(true), errorCode);
+
+				net::co_spawn(strand, writeFrames(session), net::detached);
+				co_await readFrames(session, std::move(remoteBuffer));
+				co_return;
+			}
+
+			const bool processing = handler.processMessage(remoteData, localBuffer);
+			remoteBuffer.erase(0, messageSize);
+
+			if (!processing) {
+				log::debug(TAG, "Process %s message", QUIT_COMMAND);
+			} else if (remoteBuffer.find('\n') != std::string::npos) {
+				/* replies of pipelined messages are flushed together once no complete message is left */
+				continue;
+			}
+
+			if (!localBuffer.empty()) {
+				co_await net::async_write(socket, net::buffer(localBuffer), net::redirect_error(net::use_awaitable, errorCode));
+				localBuffer.clear();
+
+				if (errorCode) {
+					log::error(TAG, "Can't send reply: %s", errorCode.message().c_str());
+					break;
+				}
+			}
+
+			if (!processing) {
+				break;
+			}
+		}
+
+		socket.shutdown(net::ip::tcp::socket::shutdown_both, errorCode);
+		socket.close(errorCode);
+	}
+
+	auto AsyncDictServer::readFrames(std::shared_ptr<FrameSession> session, std::string remoteBuffer) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+
+		/* reads exactly missing bytes of frame, bytes of next frame are never consumed */
+		auto receiveExactly = [&session, &remoteBuffer, &errorCode](std::size_t size) -> net::awaitable<bool> {
+			if (remoteBuffer.size() < size) {
+				co_await net::async_read(session->socket, net::dynamic_buffer(remoteBuffer),
+						net::transfer_exactly(size - remoteBuffer.size()),
+						net::redirect_error(net::use_awaitable, errorCode));
+			}
+			co_return !errorCode;
+		};
+
+		while (mStarted) {
+			if (!co_await receiveExactly(DICT_FRAME_HEADER_SIZE)) {
+				if (errorCode != net::error::eof) {
+					log::error(TAG, "Receive frame header isn't correct: %s", errorCode.message().c_str());
+				}
+				break;
+			}
+
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(
+					std::as_bytes(std::span(remoteBuffer.data(), DICT_FRAME_HEADER_SIZE)));
+
+			if (header.has_error()) {
+				log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+				break;
+			}
+
+			if (!co_await receiveExactly(DICT_FRAME_HEADER_SIZE + header->payloadSize)) {
+				log::error(TAG, "Receive frame payload isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			const auto* payloadBegin = reinterpret_cast<const std::byte*>(remoteBuffer.data()) + DICT_FRAME_HEADER_SIZE;
+			std::vector<std::byte> payload(payloadBegin, payloadBegin + header->payloadSize);
+			remoteBuffer.erase(0, DICT_FRAME_HEADER_SIZE + header->payloadSize);
+
+			if (header->opcode == DictOpcode::QUIT) {
+				log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+				break;
+			}
+
+			++session->inFlightCount;
+
+			if (header->opcode == DictOpcode::GET_ALL_STREAM) {
+				streamFrames(session, DictStreamCursor{ .header = *header });
+				continue;
+			}
+
+			net::post(session->socket.get_executor(), [session, header = *header, payload = std::move(payload)]() {
+				std::optional<DictFrame> localFrame = session->handler.processFrame(header, payload);
+
+				net::post(session->strand, [session, localFrame = std::move(localFrame)]() mutable {
+					--session->inFlightCount;
+
+					if (localFrame.has_value()) {
+						session->outgoingFrames.push_back(std::move(*localFrame));
+					}
+					session->signal.cancel();
+				});
+			});
+		}
+
+		session->reading = false;
+		session->signal.cancel();
+	}
+
+	auto AsyncDictServer::writeFrames(std::shared_ptr<FrameSession> session) -> net::awaitable<void> {
+		boost::system::error_code errorCode;
+
+		while (true) {
+			while (session->outgoingFrames.empty()) {
+				if (!session->reading && session->inFlightCount == 0) {
+					session->socket.shutdown(net::ip::tcp::socket::shutdown_both, errorCode);
+					session->socket.close(errorCode);
+					co_return;
+				}
+
+				session->signal.expires_at(net::steady_timer::time_point::max());
+				co_await session->signal.async_wait(net::redirect_error(net::use_awaitable, errorCode));
+			}
+
+			/* every reply queued so far goes out with one gather write */
+			while (!session->outgoingFrames.empty() && session->flushingFrames.size() < DICT_FRAME_MAX_FLUSH_COUNT) {
+				session->flushingFrames.push_back(std::move(session->outgoingFrames.front()));
+				session->outgoingFrames.pop_front();
+			}
+
+			/* queue has room again, so paused streams read their next chunks while this flush is written */
+			if (session->outgoingFrames.size() < DICT_STREAM_MAX_QUEUED_COUNT) {
+				for (DictStreamCursor& cursor : session->pausedStreams) {
+					streamFrames(session, cursor);
+				}
+				session->pausedStreams.clear();
+			}
+
+			session->flushingHeaders.reserve(session->flushingFrames.size());
+
+			for (const DictFrame& localFrame : session->flushingFrames) {
+				session->flushingHeaders.push_back(encodeFrameHeader(localFrame.header));
+				session->flushingBuffers.push_back(net::buffer(session->flushingHeaders.back()));
+				session->flushingBuffers.push_back(net::buffer(localFrame.payload));
+			}
+
+			co_await net::async_write(session->socket, session->flushingBuffers, net::redirect_error(net::use_awaitable, errorCode));
+
+			session->flushingFrames.clear();
+			session->flushingHeaders.clear();
+			session->flushingBuffers.clear();
+
+			if (errorCode) {
+				log::error(TAG, "Can't send frames: %s", errorCode.message().c_str());
+				session->reading = false;
+				session->writing = false;
+				session->socket.close(errorCode);
+				co_return;
+			}
+		}
+	}
+
+	void AsyncDictServer::streamFrames(std::shared_ptr<FrameSession> session, DictStreamCursor cursor) {
+		net::post(session->socket.get_executor(), [session, cursor]() mutable {
+			DictFrame localFrame = session->handler.processStreamFrame(cursor);
+
+			net::post(session->strand, [session, cursor, localFrame = std::move(localFrame)]() mutable {
+				session->outgoingFrames.push_back(std::move(localFrame));
+				session->signal.cancel();
+
+				/* nobody sends frames after writer failed, so stream ends there too */
+				if (cursor.finished || !session->writing) {
+					--session->inFlightCount;
+				} else if (session->outgoingFrames.size() < DICT_STREAM_MAX_QUEUED_COUNT) {
+					streamFrames(session, cursor);
+				} else {
+					session->pausedStreams.push_back(cursor);
+				}
+			});
+		});
+	}
+}
@@ -0,0 +1,187 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/DictClientPool.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+
+static constexpr const char* const TAG = "DictClientPool";
+
+namespace lynx {
+
+	DictClientPool::Lease::Lease(DictClientPool& pool, uint32_t index)
+		: mPool(&pool)
+		, mIndex(index) {
+	}
+
+	DictClientPool::Lease::Lease(Lease&& other) noexcept
+		: mPool(std::exchange(other.mPool, nullptr))
+		, mIndex(other.mIndex) {
+	}
+
+	DictClientPool::Lease::~Lease() {
+		if (mPool) {
+			mPool->release(mIndex);
+		}
+	}
+
+	auto DictClientPool::Lease::operator*() -> SyncDictClient& { return *mPool->mSlots[mIndex].client; }
+
+	auto DictClientPool::Lease::operator->() -> SyncDictClient* { return mPool->mSlots[mIndex].client.get(); }
+
+	DictClientPool::DictClientPool(const std::string& host, uint64_t port, const DictClientPoolOptions& options)
+		: mHost(host)
+		, mPort(port)
+		, mOptions(options)
+		, mNextIndex(0)
+		, mReleaseCount(0)
+		, mStarted(false) {
+		mOptions.clientCount = std::max(mOptions.clientCount, 1u);
+		mSlots = std::make_unique<Slot[]>(mOptions.clientCount);
+
+		log::info(TAG, "Create pool");
+	}
+
+	DictClientPool::~DictClientPool() {
+		stop();
+		log::info(TAG, "Destroy pool");
+	}
+
+	bool DictClientPool::isStarted() const { return mStarted; }
+
+	void DictClientPool::start() {
+		log::info(TAG, "Start pool with %u clients", mOptions.clientCount);
+
+		/* slot leased before start is connected by its lease, so only slots claimed here are touched */
+		for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+			Slot& slot = mSlots[i];
+
+			if (slot.leased.test_and_set(std::memory_order_acquire)) {
+				continue;
+			}
+
+			if (!slot.client || !slot.client->isStarted()) {
+				reconnectClient(slot);
+			}
+			release(i);
+		}
+
+		mStarted = true;
+	}
+
+	void DictClientPool::stop() {
+		if (!mStarted.exchange(false)) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+			Slot& slot = mSlots[i];
+
+			/* client still leased may be in the middle of request, it is closed with pool */
+			if (slot.leased.test_and_set(std::memory_order_acquire)) {
+				continue;
+			}
+
+			if (slot.client && slot.client->isStarted()) {
+				slot.client->performQuit();
+				slot.client->stop();
+			}
+			release(i);
+		}
+
+		log::info(TAG, "Stop pool");
+	}
+
+	auto DictClientPool::acquire() -> Lease {
+		while (true) {
+			const uint32_t releaseCount = mReleaseCount.load(std::memory_order_acquire);
+			const uint32_t firstIndex = mNextIndex.fetch_add(1, std::memory_order_relaxed);
+
+			for (uint32_t i = 0; i < mOptions.clientCount; ++i) {
+				const uint32_t index = (firstIndex + i) % mOptions.clientCount;
+
+				if (!mSlots[index].leased.test_and_set(std::memory_order_acquire)) {
+					Lease lease(*this, index);
+					prepareClient(mSlots[index]);
+					return lease;
+				}
+			}
+
+			/* wakes up once any lease is released after the scan above began */
+			mReleaseCount.wait(releaseCount, std::memory_order_acquire);
+		}
+	}
+
+	void DictClientPool::performInsert(const Word& word) {
+		acquire()->performInsert(word);
+	}
+
+	void DictClientPool::performUpdate(const Word& word) {
+		acquire()->performUpdate(word);
+	}
+
+	void DictClientPool::performDelete(uint64_t id) {
+		acquire()->performDelete(id);
+	}
+
+	auto DictClientPool::performGetById(uint64_t id) -> Word {
+		return acquire()->performGetById(id);
+	}
+
+	auto DictClientPool::performGetAll() -> std::vector<Word> {
+		return acquire()->performGetAll();
+	}
+
+	void DictClientPool::prepareClient(Slot& slot) {
+		/* slot of pool which isn't started yet has no client, it is connected on first lease */
+		if (!slot.client || !slot.client->isStarted()) {
+			reconnectClient(slot);
+			return;
+		}
+
+		if (std::chrono::steady_clock::now() - slot.lastUsed > mOptions.healthCheckInterval && !slot.client->performPing()) {
+			log::info(TAG, "Idle client failed health check");
+			reconnectClient(slot);
+		}
+	}
+
+	void DictClientPool::reconnectClient(Slot& slot) {
+		slot.client = std::make_unique<SyncDictClient>(mHost, mPort, mOptions.protocol);
+		slot.client->start();
+		slot.lastUsed = std::chrono::steady_clock::now();
+
+		if (!slot.client->isStarted()) {
+			log::error(TAG, "Can't connect client to %s:%lu", mHost.c_str(), mPort);
+		}
+	}
+
+	void DictClientPool::release(uint32_t index) {
+		mSlots[index].lastUsed = std::chrono::steady_clock::now();
+		mSlots[index].leased.clear(std::memory_order_release);
+
+		mReleaseCount.fetch_add(1, std::memory_order_release);
+		mReleaseCount.notify_one();
+	}
+}
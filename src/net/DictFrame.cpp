@@ -0,0 +1,112 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/DictFrame.hpp"
+
+#include <boost/endian/conversion.hpp>
+
+#include <cstring>
+
+namespace lynx {
+
+	auto encodeFrameHeader(const DictFrameHeader& header) -> std::array<std::byte, DICT_FRAME_HEADER_SIZE> {
+		std::array<std::byte, DICT_FRAME_HEADER_SIZE> buffer;
+
+		const uint16_t flags = boost::endian::native_to_big(header.flags);
+		const uint32_t requestId = boost::endian::native_to_big(header.requestId);
+		const uint32_t payloadSize = boost::endian::native_to_big(header.payloadSize);
+
+		buffer[0] = static_cast<std::byte>(header.opcode);
+		buffer[1] = static_cast<std::byte>(header.status);
+		std::memcpy(buffer.data() + 2, &flags, sizeof(flags));
+		std::memcpy(buffer.data() + 4, &requestId, sizeof(requestId));
+		std::memcpy(buffer.data() + 8, &payloadSize, sizeof(payloadSize));
+
+		return buffer;
+	}
+
+	auto decodeFrameHeader(std::span<const std::byte> buffer) -> boost::system::result<DictFrameHeader> {
+		if (buffer.size() < DICT_FRAME_HEADER_SIZE) {
+			return std::make_error_code(std::errc::message_size);
+		}
+
+		DictFrameHeader header;
+		header.opcode = static_cast<DictOpcode>(buffer[0]);
+		header.status = static_cast<DictStatus>(buffer[1]);
+		std::memcpy(&header.flags, buffer.data() + 2, sizeof(header.flags));
+		std::memcpy(&header.requestId, buffer.data() + 4, sizeof(header.requestId));
+		std::memcpy(&header.payloadSize, buffer.data() + 8, sizeof(header.payloadSize));
+
+		header.flags = boost::endian::big_to_native(header.flags);
+		header.requestId = boost::endian::big_to_native(header.requestId);
+		header.payloadSize = boost::endian::big_to_native(header.payloadSize);
+
+		if (header.opcode < DictOpcode::QUIT || header.opcode > DictOpcode::GET_ALL_STREAM) {
+			return std::make_error_code(std::errc::bad_message);
+		}
+
+		if (header.status != DictStatus::SUCCESS && header.status != DictStatus::FAILURE) {
+			return std::make_error_code(std::errc::bad_message);
+		}
+
+		if (header.payloadSize > DICT_FRAME_MAX_PAYLOAD_SIZE) {
+			return std::make_error_code(std::errc::message_size);
+		}
+
+		return header;
+	}
+
+	auto makeFrame(DictOpcode opcode, uint32_t requestId, std::vector<std::byte>&& payload) -> DictFrame {
+		/* size field of bigger reply would be cut and client would reject frame as corrupt */
+		if (payload.size() > DICT_FRAME_MAX_PAYLOAD_SIZE) {
+			return makeErrorFrame(opcode, requestId, "Reply exceeds frame size limit");
+		}
+
+		return DictFrame {
+			.header = DictFrameHeader {
+				.opcode = opcode,
+				.status = DictStatus::SUCCESS,
+				.flags = 0,
+				.requestId = requestId,
+				.payloadSize = static_cast<uint32_t>(payload.size())
+			},
+			.payload = std::move(payload)
+		};
+	}
+
+	auto makeErrorFrame(DictOpcode opcode, uint32_t requestId, const std::string& message) -> DictFrame {
+		const auto* begin = reinterpret_cast<const std::byte*>(message.data());
+
+		DictFrame frame = makeFrame(opcode, requestId, std::vector<std::byte>(begin, begin + message.size()));
+		frame.header.status = DictStatus::FAILURE;
+
+		return frame;
+	}
+
+	void appendFrame(std::string& output, const DictFrame& frame) {
+		const auto localHeader = encodeFrameHeader(frame.header);
+		output.append(reinterpret_cast<const char*>(localHeader.data()), localHeader.size());
+		output.append(reinterpret_cast<const char*>(frame.payload.data()), frame.payload.size());
+	}
+}
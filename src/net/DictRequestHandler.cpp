@@ -0,0 +1,386 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/DictRequestHandler.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <charconv>
+#include <cstring>
+
+static constexpr const char* const TAG = "DictRequestHandler";
+
+namespace lynx {
+
+	DictRequestHandler::DictRequestHandler(SyncDictDao& dictDao, std::mutex& dictDaoMutex)
+		: mDictDao(dictDao)
+		, mDictDaoMutex(dictDaoMutex) {
+	}
+
+	bool DictRequestHandler::processMessage(std::string_view message, std::string& reply) {
+		if (message.starts_with(INSERT_COMMAND)) {
+			processInsert(message, reply);
+		} else if (message.starts_with(UPDATE_COMMAND)) {
+			processUpdate(message, reply);
+		} else if (message.starts_with(DELETE_COMMAND)) {
+			processDelete(message, reply);
+		} else if (message.starts_with(GET_BY_ID_COMMAND)) {
+			processGetById(message, reply);
+		} else if (message.starts_with(GET_ALL_COMMAND)) {
+			processGetAll(message, reply);
+		} else if (message.starts_with(PING_COMMAND)) {
+			log::debug(TAG, "Process %s message", PING_COMMAND);
+			reply.append(PING_COMMAND).append(" processed success");
+		} else if (message.starts_with(QUIT_COMMAND)) {
+			log::debug(TAG, "Process %s message", QUIT_COMMAND);
+			return false;
+		} else {
+			log::error(TAG, "Process unknown message");
+			reply.append("Unknown command error");
+		}
+
+		reply.push_back('\n');
+		return true;
+	}
+
+	void DictRequestHandler::processInsert(std::string_view message, std::string& reply) {
+		log::debug(TAG, "Process %s message", INSERT_COMMAND);
+
+		std::string_view remoteData = message.substr(std::strlen(INSERT_COMMAND));
+
+		boost::system::result<Word> remoteWord = mParser.deserializeFromText(remoteData);
+
+		if (remoteWord.has_error()) {
+			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+			reply.append("Deserialize word error");
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.insert(remoteWord.value());
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db insert word error: %s", operationStatus.error().message().c_str());
+			reply.append("Db insert word error");
+			return;
+		}
+
+		reply.append(INSERT_COMMAND).append(" processed success");
+	}
+
+	void DictRequestHandler::processUpdate(std::string_view message, std::string& reply) {
+		log::debug(TAG, "Process %s message", UPDATE_COMMAND);
+
+		std::string_view remoteData = message.substr(std::strlen(UPDATE_COMMAND));
+
+		boost::system::result<Word> remoteWord = mParser.deserializeFromText(remoteData);
+
+		if (remoteWord.has_error()) {
+			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+			reply.append("Deserialize word error");
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.update(remoteWord.value());
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db update word error: %s", operationStatus.error().message().c_str());
+			reply.append("Db update word error");
+			return;
+		}
+
+		reply.append(UPDATE_COMMAND).append(" processed success");
+	}
+
+	void DictRequestHandler::processDelete(std::string_view message, std::string& reply) {
+		log::debug(TAG, "Process %s message", DELETE_COMMAND);
+
+		uint64_t wordId = 0;
+		std::string_view remoteData = message.substr(std::strlen(DELETE_COMMAND));
+		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+
+		if (remoteWordId.ec != std::errc{}) {
+			log::error(TAG, "Parse word id error: %s", std::make_error_code(remoteWordId.ec).message().c_str());
+			reply.append("Parse word id error");
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.remove(wordId);
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db delete word error: %s", operationStatus.error().message().c_str());
+			reply.append("Db delete word error");
+			return;
+		}
+
+		reply.append(DELETE_COMMAND).append(" processed success");
+	}
+
+	void DictRequestHandler::processGetById(std::string_view message, std::string& reply) {
+		log::debug(TAG, "Process %s message", GET_BY_ID_COMMAND);
+
+		uint64_t wordId = 0;
+		std::string_view remoteData = message.substr(std::strlen(GET_BY_ID_COMMAND));
+		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+
+		if (remoteWordId.ec != std::errc{}) {
+			log::error(TAG, "Parse word id error: %s", std::make_error_code(remoteWordId.ec).message().c_str());
+			reply.append("Parse word id error");
+			return;
+		}
+
+		boost::system::result<Word> localWord = [this, wordId]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getById(wordId);
+		}();
+
+		if (localWord.has_error()) {
+			log::error(TAG, "Db get word by id error: %s", localWord.error().message().c_str());
+			reply.append("Db get word by id error");
+			return;
+		}
+
+		boost::system::result<std::string> localData = mParser.serializeToText(*localWord);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+			reply.append("Serialize word error");
+			return;
+		}
+
+		reply.append(GET_BY_ID_COMMAND).append(*localData);
+	}
+
+	void DictRequestHandler::processGetAll(std::string_view message, std::string& reply) {
+		log::debug(TAG, "Process %s message", GET_ALL_COMMAND);
+
+		boost::system::result<std::vector<Word>> localWords = [this]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getAll();
+		}();
+
+		if (localWords.has_error()) {
+			log::error(TAG, "Db get all words error: %s", localWords.error().message().c_str());
+			reply.append("Db get all words error");
+			return;
+		}
+
+		boost::system::result<std::string> localData = mParser.serializeWordsToText(*localWords);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
+			reply.append("Serialize words error");
+			return;
+		}
+
+		reply.append(GET_ALL_COMMAND).append(*localData);
+	}
+
+	auto DictRequestHandler::processFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> std::optional<DictFrame> {
+		switch (header.opcode) {
+		case DictOpcode::INSERT:
+			return processInsertFrame(header, payload);
+		case DictOpcode::UPDATE:
+			return processUpdateFrame(header, payload);
+		case DictOpcode::DELETE:
+			return processDeleteFrame(header, payload);
+		case DictOpcode::GET_BY_ID:
+			return processGetByIdFrame(header, payload);
+		case DictOpcode::GET_ALL:
+			return processGetAllFrame(header);
+		case DictOpcode::GET_ALL_STREAM:
+			log::error(TAG, "Process %s frame without stream", GET_ALL_STREAM_COMMAND);
+			return makeErrorFrame(header.opcode, header.requestId, "Stream isn't supported error");
+		case DictOpcode::PING:
+			log::debug(TAG, "Process %s frame", PING_COMMAND);
+			return makeFrame(header.opcode, header.requestId);
+		case DictOpcode::QUIT:
+			log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+			return std::nullopt;
+		default:
+			log::error(TAG, "Process unknown frame");
+			return makeErrorFrame(header.opcode, header.requestId, "Unknown command error");
+		}
+	}
+
+	auto DictRequestHandler::processInsertFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame {
+		log::debug(TAG, "Process %s frame", INSERT_COMMAND);
+
+		boost::system::result<Word> remoteWord = mBinaryParser.deserializeFromBuffer(payload);
+
+		if (remoteWord.has_error()) {
+			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Deserialize word error");
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.insert(remoteWord.value());
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db insert word error: %s", operationStatus.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Db insert word error");
+		}
+
+		return makeFrame(header.opcode, header.requestId);
+	}
+
+	auto DictRequestHandler::processUpdateFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame {
+		log::debug(TAG, "Process %s frame", UPDATE_COMMAND);
+
+		boost::system::result<Word> remoteWord = mBinaryParser.deserializeFromBuffer(payload);
+
+		if (remoteWord.has_error()) {
+			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Deserialize word error");
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.update(remoteWord.value());
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db update word error: %s", operationStatus.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Db update word error");
+		}
+
+		return makeFrame(header.opcode, header.requestId);
+	}
+
+	auto DictRequestHandler::processDeleteFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame {
+		log::debug(TAG, "Process %s frame", DELETE_COMMAND);
+
+		boost::system::result<uint64_t> wordId = mBinaryParser.deserializeIdFromBuffer(payload);
+
+		if (wordId.has_error()) {
+			log::error(TAG, "Parse word id error: %s", wordId.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Parse word id error");
+		}
+
+		std::lock_guard<std::mutex> lock(mDictDaoMutex);
+		boost::system::result<void> operationStatus = mDictDao.remove(*wordId);
+
+		if (operationStatus.has_error()) {
+			log::error(TAG, "Db delete word error: %s", operationStatus.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Db delete word error");
+		}
+
+		return makeFrame(header.opcode, header.requestId);
+	}
+
+	auto DictRequestHandler::processGetByIdFrame(const DictFrameHeader& header, std::span<const std::byte> payload) -> DictFrame {
+		log::debug(TAG, "Process %s frame", GET_BY_ID_COMMAND);
+
+		boost::system::result<uint64_t> wordId = mBinaryParser.deserializeIdFromBuffer(payload);
+
+		if (wordId.has_error()) {
+			log::error(TAG, "Parse word id error: %s", wordId.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Parse word id error");
+		}
+
+		boost::system::result<Word> localWord = [this, &wordId]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getById(*wordId);
+		}();
+
+		if (localWord.has_error()) {
+			log::error(TAG, "Db get word by id error: %s", localWord.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Db get word by id error");
+		}
+
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeToBuffer(*localWord);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Serialize word error");
+		}
+
+		return makeFrame(header.opcode, header.requestId, std::move(*localData));
+	}
+
+	auto DictRequestHandler::processGetAllFrame(const DictFrameHeader& header) -> DictFrame {
+		log::debug(TAG, "Process %s frame", GET_ALL_COMMAND);
+
+		boost::system::result<std::vector<Word>> localWords = [this]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getAll();
+		}();
+
+		if (localWords.has_error()) {
+			log::error(TAG, "Db get all words error: %s", localWords.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Db get all words error");
+		}
+
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeWordsToBuffer(*localWords);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
+			return makeErrorFrame(header.opcode, header.requestId, "Serialize words error");
+		}
+
+		return makeFrame(header.opcode, header.requestId, std::move(*localData));
+	}
+
+	auto DictRequestHandler::processStreamFrame(DictStreamCursor& cursor) -> DictFrame {
+		log::debug(TAG, "Process %s frame after id=%llu", GET_ALL_STREAM_COMMAND, static_cast<unsigned long long>(cursor.afterId));
+
+		const DictFrameHeader& header = cursor.header;
+		boost::system::result<std::vector<Word>> localWords = [this, &cursor]() {
+			std::lock_guard<std::mutex> lock(mDictDaoMutex);
+			return mDictDao.getPage(cursor.afterId, DICT_STREAM_CHUNK_SIZE);
+		}();
+
+		if (localWords.has_error()) {
+			log::error(TAG, "Db get all words error: %s", localWords.error().message().c_str());
+			cursor.finished = true;
+			return makeErrorFrame(header.opcode, header.requestId, "Db get all words error");
+		}
+
+		/* table may grow while it is streamed, so only empty page ends it */
+		if (localWords->empty()) {
+			cursor.finished = true;
+			return makeFrame(header.opcode, header.requestId);
+		}
+
+		cursor.afterId = localWords->back().id;
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeWordsToBuffer(*localWords);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
+			cursor.finished = true;
+			return makeErrorFrame(header.opcode, header.requestId, "Serialize words error");
+		}
+
+		DictFrame localFrame = makeFrame(header.opcode, header.requestId, std::move(*localData));
+
+		/* chunk above frame limit comes back as error frame, which ends stream */
+		if (localFrame.header.status == DictStatus::SUCCESS) {
+			localFrame.header.flags |= DICT_FRAME_FLAG_MORE;
+		} else {
+			cursor.finished = true;
+		}
+
+		return localFrame;
+	}
+}
@@ -24,18 +24,126 @@
 
 #include "net/NetworkUtils.hpp"
 
-#include <sstream>
+#include <boost/asio/error.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+static constexpr char ABSTRACT_SOCKET_PREFIX = '@';
 
 namespace lynx {
 
+	static boost::system::error_code waitSocket(int socketFd, short events, std::chrono::steady_clock::time_point deadline) {
+		while (true) {
+			const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+			if (timeout.count() <= 0) {
+				return boost::asio::error::timed_out;
+			}
+
+			pollfd descriptor = { .fd = socketFd, .events = events, .revents = 0 };
+			const int count = ::poll(&descriptor, 1, static_cast<int>(std::min<int64_t>(timeout.count(), INT_MAX)));
+
+			/* error and hang up are ready too, following read or write reports them */
+			if (count > 0) {
+				return {};
+			}
+
+			if (count < 0 && errno != EINTR) {
+				return boost::system::error_code(errno, boost::system::system_category());
+			}
+		}
+	}
+
+	std::string_view toStringView(const boost::asio::streambuf& buffer) {
+		/* input sequence of basic_streambuf is always one contiguous block */
+		const boost::asio::const_buffer data = buffer.data();
+		return std::string_view(static_cast<const char*>(data.data()), data.size());
+	}
+
 	std::string toString(boost::asio::streambuf& buffer) {
-		std::ostringstream out;
-		out << &buffer;
-		return out.str();
+		std::string result(toStringView(buffer));
+		buffer.consume(buffer.size());
+		return result;
 	}
 
 	std::string toStringFast(boost::asio::streambuf& buffer) {
-		std::string result = boost::asio::buffer_cast<const char*>(buffer.data());
-		return result;
+		/* data isn't NUL terminated, so size is taken from buffer */
+		return std::string(toStringView(buffer));
+	}
+
+	boost::asio::local::stream_protocol::endpoint toLocalEndpoint(std::string_view path) {
+		if (path.starts_with(ABSTRACT_SOCKET_PREFIX)) {
+			/* abstract name is passed with leading NUL and without terminating one */
+			std::string name(path);
+			name.front() = '\0';
+			return boost::asio::local::stream_protocol::endpoint(name);
+		}
+
+		return boost::asio::local::stream_protocol::endpoint(std::string(path));
+	}
+
+	std::string toLocalAddress(std::string_view path) {
+		if (path.starts_with(ABSTRACT_SOCKET_PREFIX)) {
+			return "unix-abstract:" + std::string(path.substr(1));
+		}
+
+		return "unix:" + std::string(path);
+	}
+
+	void removeLocalSocket(std::string_view path) {
+		if (!path.empty() && !path.starts_with(ABSTRACT_SOCKET_PREFIX)) {
+			::unlink(std::string(path).c_str());
+		}
+	}
+
+	bool isPeerClosed(int socketFd) {
+		pollfd descriptor = { .fd = socketFd, .events = POLLRDHUP, .revents = 0 };
+
+		if (::poll(&descriptor, 1, 0) < 0) {
+			return false;
+		}
+
+		return (descriptor.revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL)) != 0;
+	}
+
+	boost::system::error_code waitReadable(int socketFd, std::chrono::steady_clock::time_point deadline) {
+		return waitSocket(socketFd, POLLIN, deadline);
+	}
+
+	boost::system::error_code waitWritable(int socketFd, std::chrono::steady_clock::time_point deadline) {
+		return waitSocket(socketFd, POLLOUT, deadline);
+	}
+
+	boost::system::error_code sendFile(int socketFd, int fileFd, uint64_t& offset, uint64_t& size) {
+		off_t fileOffset = static_cast<off_t>(offset);
+		/* kernel sends at most 0x7ffff000 bytes per call anyway */
+		const ssize_t count = ::sendfile(socketFd, fileFd, &fileOffset, static_cast<std::size_t>(std::min<uint64_t>(size, INT_MAX)));
+
+		if (count < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				return boost::asio::error::would_block;
+			}
+			if (errno == EINTR) {
+				return {};
+			}
+
+			return boost::system::error_code(errno, boost::system::system_category());
+		}
+
+		/* file was cut while it was sent, rest of promised length never comes */
+		if (count == 0) {
+			return boost::asio::error::eof;
+		}
+
+		offset += static_cast<uint64_t>(count);
+		size -= static_cast<uint64_t>(count);
+
+		return {};
 	}
 }
@@ -0,0 +1,306 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/PipelinedDictClient.hpp"
+#include "net/NetworkUtils.hpp"
+#include "logging/Logging.hpp"
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+static constexpr const char* const TAG = "PipelinedDictClient";
+
+using namespace std::string_literals;
+
+namespace lynx {
+
+	PipelinedDictClient::PipelinedDictClient(const std::string& host, uint16_t port)
+		: mSocket(mContext)
+		, mEndpoint(net::ip::address::from_string(host), port)
+		, mLastRequestId(0)
+		, mStarted(false) {
+		log::info(TAG, "Create client");
+	}
+
+	PipelinedDictClient::~PipelinedDictClient() {
+		stop();
+		log::info(TAG, "Destroy client");
+	}
+
+	bool PipelinedDictClient::isStarted() const { return mStarted; }
+
+	void PipelinedDictClient::start() {
+		log::info(TAG, "Start client");
+
+		boost::system::error_code errorCode;
+		mSocket.connect(mEndpoint, errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't connect to server: %s", errorCode.message().c_str());
+			return;
+		}
+
+		mSocket.set_option(net::ip::tcp::no_delay(true), errorCode);
+		performNegotiation();
+
+		if (mStarted) {
+			mReceiveThread = std::thread(&PipelinedDictClient::receiveFrames, this);
+		}
+	}
+
+	void PipelinedDictClient::stop() {
+		boost::system::error_code errorCode;
+
+		mStarted = false;
+
+		if (mSocket.is_open()) {
+			mSocket.shutdown(net::ip::tcp::socket::shutdown_both, errorCode);
+		}
+
+		if (mReceiveThread.joinable()) {
+			mReceiveThread.join();
+		}
+
+		mSocket.close(errorCode);
+		log::info(TAG, "Stop client");
+	}
+
+	void PipelinedDictClient::performQuit() {
+		boost::system::error_code errorCode;
+
+		const auto localHeader = encodeFrameHeader(makeFrame(DictOpcode::QUIT, ++mLastRequestId).header);
+
+		std::lock_guard<std::mutex> lock(mSendMutex);
+		net::write(mSocket, net::buffer(localHeader), errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't send frame %s: %s", QUIT_COMMAND, errorCode.message().c_str());
+		}
+	}
+
+	auto PipelinedDictClient::performInsert(const Word& word) -> std::future<boost::system::result<void>> {
+		return performStatusFrame(DictOpcode::INSERT, mParser.serializeToBuffer(word));
+	}
+
+	auto PipelinedDictClient::performUpdate(const Word& word) -> std::future<boost::system::result<void>> {
+		return performStatusFrame(DictOpcode::UPDATE, mParser.serializeToBuffer(word));
+	}
+
+	auto PipelinedDictClient::performDelete(uint64_t id) -> std::future<boost::system::result<void>> {
+		return performStatusFrame(DictOpcode::DELETE, mParser.serializeIdToBuffer(id));
+	}
+
+	auto PipelinedDictClient::performGetById(uint64_t id) -> std::future<boost::system::result<Word>> {
+		auto promise = std::make_shared<std::promise<boost::system::result<Word>>>();
+		auto future = promise->get_future();
+
+		boost::system::result<std::vector<std::byte>> localData = mParser.serializeIdToBuffer(id);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word id error: %s", localData.error().message().c_str());
+			promise->set_value(localData.error());
+			return future;
+		}
+
+		performFrame(DictOpcode::GET_BY_ID, std::move(*localData), [this, promise](boost::system::result<DictFrame>&& remoteFrame) {
+			if (remoteFrame.has_error()) {
+				promise->set_value(remoteFrame.error());
+			} else {
+				promise->set_value(mParser.deserializeFromBuffer(remoteFrame->payload));
+			}
+		});
+
+		return future;
+	}
+
+	auto PipelinedDictClient::performGetAll() -> std::future<boost::system::result<std::vector<Word>>> {
+		auto promise = std::make_shared<std::promise<boost::system::result<std::vector<Word>>>>();
+		auto future = promise->get_future();
+
+		performFrame(DictOpcode::GET_ALL, {}, [this, promise](boost::system::result<DictFrame>&& remoteFrame) {
+			if (remoteFrame.has_error()) {
+				promise->set_value(remoteFrame.error());
+			} else {
+				promise->set_value(mParser.deserializeWordsFromBuffer(remoteFrame->payload));
+			}
+		});
+
+		return future;
+	}
+
+	auto PipelinedDictClient::performStatusFrame(DictOpcode opcode, boost::system::result<std::vector<std::byte>>&& payload)
+		-> std::future<boost::system::result<void>> {
+		auto promise = std::make_shared<std::promise<boost::system::result<void>>>();
+		auto future = promise->get_future();
+
+		if (payload.has_error()) {
+			log::error(TAG, "Serialize payload error: %s", payload.error().message().c_str());
+			promise->set_value(payload.error());
+			return future;
+		}
+
+		performFrame(opcode, std::move(*payload), [promise](boost::system::result<DictFrame>&& remoteFrame) {
+			if (remoteFrame.has_error()) {
+				promise->set_value(remoteFrame.error());
+			} else {
+				promise->set_value({});
+			}
+		});
+
+		return future;
+	}
+
+	void PipelinedDictClient::performNegotiation() {
+		boost::system::error_code errorCode;
+		net::streambuf remoteBuffer;
+
+		net::write(mSocket, net::buffer(PROTOCOL_V2_COMMAND + "\n"s), errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't send message %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+			return;
+		}
+
+		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
+
+		if (!errorCode && remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+			log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+			mStarted = true;
+		} else {
+			log::error(TAG, "Server doesn't support %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+		}
+	}
+
+	void PipelinedDictClient::performFrame(DictOpcode opcode, std::vector<std::byte>&& payload, FrameCompletion&& completion) {
+		boost::system::error_code errorCode;
+		uint32_t requestId = 0;
+
+		{
+			/* started flag is cleared under same lock by completeFrames, so frame can't be added after pending map is drained */
+			std::unique_lock<std::mutex> lock(mPendingMutex);
+
+			if (!mStarted) {
+				lock.unlock();
+				completion(std::make_error_code(std::errc::not_connected));
+				return;
+			}
+
+			/* 32-bit id wraps on long connection, id of request still in flight is skipped */
+			do {
+				requestId = ++mLastRequestId;
+			} while (mPendingFrames.contains(requestId));
+
+			mPendingFrames.emplace(requestId, std::move(completion));
+		}
+
+		const DictFrame localFrame = makeFrame(opcode, requestId, std::move(payload));
+		const auto localHeader = encodeFrameHeader(localFrame.header);
+		const std::array<net::const_buffer, 2> localBuffers = {
+			net::buffer(localHeader), net::buffer(localFrame.payload)
+		};
+
+		{
+			std::lock_guard<std::mutex> lock(mSendMutex);
+			net::write(mSocket, localBuffers, errorCode);
+		}
+
+		if (errorCode) {
+			log::error(TAG, "Can't send frame %u: %s", requestId, errorCode.message().c_str());
+
+			std::unique_lock<std::mutex> lock(mPendingMutex);
+			auto node = mPendingFrames.extract(requestId);
+			lock.unlock();
+
+			if (!node.empty()) {
+				node.mapped()(errorCode);
+			}
+		}
+	}
+
+	void PipelinedDictClient::receiveFrames() {
+		boost::system::error_code errorCode;
+		std::array<std::byte, DICT_FRAME_HEADER_SIZE> remoteHeader;
+
+		while (mStarted) {
+			net::read(mSocket, net::buffer(remoteHeader), errorCode);
+
+			if (errorCode) {
+				log::debug(TAG, "Receive frame header isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(remoteHeader);
+
+			if (header.has_error()) {
+				log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+				errorCode = header.error();
+				break;
+			}
+
+			DictFrame remoteFrame = { .header = *header, .payload = std::vector<std::byte>(header->payloadSize) };
+			net::read(mSocket, net::buffer(remoteFrame.payload), errorCode);
+
+			if (errorCode) {
+				log::error(TAG, "Receive frame payload isn't correct: %s", errorCode.message().c_str());
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock(mPendingMutex);
+			auto node = mPendingFrames.extract(remoteFrame.header.requestId);
+			lock.unlock();
+
+			if (node.empty()) {
+				log::error(TAG, "Receive frame %u without request", remoteFrame.header.requestId);
+				continue;
+			}
+
+			if (remoteFrame.header.status == DictStatus::FAILURE) {
+				const std::string message(reinterpret_cast<const char*>(remoteFrame.payload.data()), remoteFrame.payload.size());
+				log::error(TAG, "Server failed to process frame %u: %s", remoteFrame.header.requestId, message.c_str());
+				node.mapped()(std::make_error_code(std::errc::io_error));
+			} else {
+				node.mapped()(std::move(remoteFrame));
+			}
+		}
+
+		completeFrames(errorCode ? errorCode : boost::system::error_code(net::error::not_connected));
+	}
+
+	void PipelinedDictClient::completeFrames(boost::system::error_code errorCode) {
+		std::unordered_map<uint32_t, FrameCompletion> pendingFrames;
+
+		{
+			std::lock_guard<std::mutex> lock(mPendingMutex);
+			mStarted = false;
+			pendingFrames.swap(mPendingFrames);
+		}
+
+		for (auto& [requestId, completion] : pendingFrames) {
+			completion(errorCode);
+		}
+	}
+}
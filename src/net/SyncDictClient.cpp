@@ -27,21 +27,31 @@
 #include "common/DictCommand.hpp"
 #include "logging/Logging.hpp"
 
-#include <thread>
-
+#include <boost/asio/read.hpp>
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 
-static constexpr const char* const TAG = "SyncDictClient";
+#include <charconv>
+#include <limits>
 
-using namespace std::string_literals;
-using namespace std::chrono_literals;
+static constexpr const char* const TAG = "SyncDictClient";
 
 namespace lynx {
 
-	SyncDictClient::SyncDictClient(const std::string& host, uint64_t port)
+	SyncDictClient::SyncDictClient(const std::string& host, uint64_t port, DictProtocol protocol)
 		: mSocket(mContext)
-		, mEndpoint(net::ip::address::from_string(host), port)
+		, mEndpoint(net::ip::tcp::endpoint(net::ip::address::from_string(host), port))
+		, mProtocol(protocol)
+		, mLastRequestId(0)
+		, mStarted(false) {
+		log::info(TAG, "Create client");
+	}
+
+	SyncDictClient::SyncDictClient(const std::string& socketPath, DictProtocol protocol)
+		: mSocket(mContext)
+		, mEndpoint(toLocalEndpoint(socketPath))
+		, mProtocol(protocol)
+		, mLastRequestId(0)
 		, mStarted(false) {
 		log::info(TAG, "Create client");
 	}
@@ -67,6 +77,11 @@ namespace lynx {
 			mStarted = true;
 		} else {
 			log::error(TAG, "Can't connect to server: %s", errorCode.message().c_str());
+			return;
+		}
+
+		if (mProtocol == DictProtocol::BINARY) {
+			performNegotiation();
 		}
 	}
 
@@ -76,19 +91,47 @@ namespace lynx {
 	}
 
 	void SyncDictClient::performQuit() {
+		if (mProtocol == DictProtocol::BINARY) {
+			const DictFrame localFrame = makeFrame(DictOpcode::QUIT, ++mLastRequestId);
+			const auto localHeader = encodeFrameHeader(localFrame.header);
+
+			boost::system::error_code errorCode;
+			net::write(mSocket, net::buffer(localHeader), errorCode);
+
+			if (errorCode) {
+				log::error(TAG, "Can't send frame %s: %s", QUIT_COMMAND, errorCode.message().c_str());
+			}
+			return;
+		}
+
 		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(QUIT_COMMAND + "\n"s), errorCode);
+		errorCode = sendMessage(QUIT_COMMAND);
 
 		if (!errorCode) {
 			log::info(TAG, "Send message %s successfully", QUIT_COMMAND);
 		} else {
 			log::error(TAG, "Can't send message %s: %s", QUIT_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 		}
-
-		std::this_thread::sleep_for(1s);
 	}
 
 	void SyncDictClient::performInsert(const Word& word) {
+		if (mProtocol == DictProtocol::BINARY) {
+			boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeToBuffer(word);
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+				return;
+			}
+
+			boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::INSERT, std::move(*localData));
+
+			if (remoteFrame.has_value()) {
+				log::debug(TAG, "Receive frame %s success", INSERT_COMMAND);
+			}
+			return;
+		}
+
 		boost::system::error_code errorCode;
 		net::streambuf remoteBuffer;
 
@@ -99,26 +142,47 @@ namespace lynx {
 			return;
 		}
 
-		net::write(mSocket, net::buffer(INSERT_COMMAND + localData.value() + "\n"), errorCode);
+		errorCode = sendMessage(INSERT_COMMAND, *localData);
 
 		if (errorCode) {
 			log::error(TAG, "Can't send message %s: %s", INSERT_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 			return;
 		}
 
 		errorCode.clear();
 		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
 
-		std::string remoteData = toString(remoteBuffer);
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
 
 		if (!errorCode && remoteData.starts_with(INSERT_COMMAND)) {
-			log::debug(TAG, "Receive message: %s", remoteData.c_str());
+			log::debug(TAG, "Receive message: %.*s", static_cast<int>(remoteData.size()), remoteData.data());
 		} else {
 			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
 		}
 	}
 
 	void SyncDictClient::performUpdate(const Word& word) {
+		if (mProtocol == DictProtocol::BINARY) {
+			boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeToBuffer(word);
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+				return;
+			}
+
+			boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::UPDATE, std::move(*localData));
+
+			if (remoteFrame.has_value()) {
+				log::debug(TAG, "Receive frame %s success", UPDATE_COMMAND);
+			}
+			return;
+		}
+
 		boost::system::error_code errorCode;
 		net::streambuf remoteBuffer;
 
@@ -129,71 +193,126 @@ namespace lynx {
 			return;
 		}
 
-		net::write(mSocket, net::buffer(UPDATE_COMMAND + localData.value() + "\n"), errorCode);
+		errorCode = sendMessage(UPDATE_COMMAND, *localData);
 
 		if (errorCode) {
 			log::error(TAG, "Can't send message %s: %s", UPDATE_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 			return;
 		}
 
 		errorCode.clear();
 		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
 
-		std::string remoteData = toString(remoteBuffer);
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
 
 		if (!errorCode && remoteData.starts_with(UPDATE_COMMAND)) {
-			log::debug(TAG, "Receive message: %s", remoteData.c_str());
+			log::debug(TAG, "Receive message: %.*s", static_cast<int>(remoteData.size()), remoteData.data());
 		} else {
 			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
 		}
 	}
 
 	void SyncDictClient::performDelete(uint64_t id) {
+		if (mProtocol == DictProtocol::BINARY) {
+			boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeIdToBuffer(id);
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize word id error: %s", localData.error().message().c_str());
+				return;
+			}
+
+			boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::DELETE, std::move(*localData));
+
+			if (remoteFrame.has_value()) {
+				log::debug(TAG, "Receive frame %s success", DELETE_COMMAND);
+			}
+			return;
+		}
+
 		boost::system::error_code errorCode;
 		net::streambuf remoteBuffer;
 
-		net::write(mSocket, net::buffer(DELETE_COMMAND + std::to_string(id) + "\n"), errorCode);
+		errorCode = sendMessage(DELETE_COMMAND, id);
 
 		if (errorCode) {
 			log::error(TAG, "Can't send message %s: %s", DELETE_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 			return;
 		}
 
 		errorCode.clear();
 		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
 
-		std::string remoteData = toString(remoteBuffer);
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
 
 		if (!errorCode && remoteData.starts_with(DELETE_COMMAND)) {
-			log::debug(TAG, "Receive message: %s", remoteData.c_str());
+			log::debug(TAG, "Receive message: %.*s", static_cast<int>(remoteData.size()), remoteData.data());
 		} else {
 			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
 		}
 	}
 
 	auto SyncDictClient::performGetById(uint64_t id) -> Word {
+		if (mProtocol == DictProtocol::BINARY) {
+			boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeIdToBuffer(id);
+
+			if (localData.has_error()) {
+				log::error(TAG, "Serialize word id error: %s", localData.error().message().c_str());
+				return {};
+			}
+
+			boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::GET_BY_ID, std::move(*localData));
+
+			if (remoteFrame.has_error()) {
+				return {};
+			}
+
+			boost::system::result<Word> remoteWord = mBinaryParser.deserializeFromBuffer(remoteFrame->payload);
+
+			if (remoteWord.has_value()) {
+				return *remoteWord;
+			} else {
+				log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+				return {};
+			}
+		}
+
 		boost::system::error_code errorCode;
 		net::streambuf remoteBuffer;
 
-		net::write(mSocket, net::buffer(GET_BY_ID_COMMAND + std::to_string(id) + "\n"), errorCode);
+		errorCode = sendMessage(GET_BY_ID_COMMAND, id);
 
 		if (errorCode) {
 			log::error(TAG, "Can't send message %s: %s", GET_BY_ID_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 			return {};
 		}
 
 		errorCode.clear();
 		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
 
-		std::string remoteData = toString(remoteBuffer);
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
 
 		if (!errorCode && remoteData.starts_with(GET_BY_ID_COMMAND)) {
-			log::debug(TAG, "Receive message: %s", remoteData.c_str());
+			log::debug(TAG, "Receive message: %.*s", static_cast<int>(remoteData.size()), remoteData.data());
 		} else {
 			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
 		}
 
-		std::string rawRemoteData = remoteData.substr(std::strlen(GET_BY_ID_COMMAND));
+		const std::string_view rawRemoteData = remoteData.substr(std::strlen(GET_BY_ID_COMMAND));
 		boost::system::result<Word> remoteWord = mParser.deserializeFromText(rawRemoteData);
 
 		if (remoteWord.has_value()) {
@@ -205,28 +324,50 @@ namespace lynx {
 	}
 
 	auto SyncDictClient::performGetAll() -> std::vector<Word> {
+		if (mProtocol == DictProtocol::BINARY) {
+			boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::GET_ALL);
+
+			if (remoteFrame.has_error()) {
+				return {};
+			}
+
+			boost::system::result<std::vector<Word>> remoteWords = mBinaryParser.deserializeWordsFromBuffer(remoteFrame->payload);
+
+			if (remoteWords.has_value()) {
+				return *remoteWords;
+			} else {
+				log::error(TAG, "Deserialize words error: %s", remoteWords.error().message().c_str());
+				return {};
+			}
+		}
+
 		boost::system::error_code errorCode;
 		net::streambuf remoteBuffer;
 
-		net::write(mSocket, net::buffer(GET_ALL_COMMAND + "\n"s), errorCode);
+		errorCode = sendMessage(GET_ALL_COMMAND);
 
 		if (errorCode) {
 			log::error(TAG, "Can't send message %s: %s", GET_ALL_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 			return {};
 		}
 
 		errorCode.clear();
 		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
 
-		std::string remoteData = toString(remoteBuffer);
+		if (errorCode) {
+			mStarted = false;
+		}
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
 
 		if (!errorCode && remoteData.starts_with(GET_ALL_COMMAND)) {
-			log::debug(TAG, "Receive message: %s", remoteData.c_str());
+			log::debug(TAG, "Receive message: %.*s", static_cast<int>(remoteData.size()), remoteData.data());
 		} else {
 			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
 		}
 
-		std::string rawRemoteData = remoteData.substr(std::strlen(GET_ALL_COMMAND));
+		const std::string_view rawRemoteData = remoteData.substr(std::strlen(GET_ALL_COMMAND));
 		boost::system::result<std::vector<Word>> remoteWords = mParser.deserializeWordsFromText(rawRemoteData);
 
 		if (remoteWords.has_value()) {
@@ -236,4 +377,168 @@ namespace lynx {
 			return {};
 		}
 	}
+
+	auto SyncDictClient::performGetAll(const std::function<void(std::vector<Word>&&)>& consumeWords) -> boost::system::result<void> {
+		if (mProtocol != DictProtocol::BINARY) {
+			log::error(TAG, "Message %s requires %s", GET_ALL_STREAM_COMMAND, PROTOCOL_V2_COMMAND);
+			return std::make_error_code(std::errc::operation_not_supported);
+		}
+
+		boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::GET_ALL_STREAM);
+
+		/* only one chunk is kept in memory, next is read after consumer returns */
+		while (remoteFrame.has_value()) {
+			if (remoteFrame->header.flags & DICT_FRAME_FLAG_MORE) {
+				boost::system::result<std::vector<Word>> remoteWords = mBinaryParser.deserializeWordsFromBuffer(remoteFrame->payload);
+
+				if (remoteWords.has_error()) {
+					log::error(TAG, "Deserialize words error: %s", remoteWords.error().message().c_str());
+					return remoteWords.error();
+				}
+
+				consumeWords(std::move(*remoteWords));
+			} else {
+				log::debug(TAG, "Receive frame %s success", GET_ALL_STREAM_COMMAND);
+				return {};
+			}
+
+			remoteFrame = receiveFrame(DictOpcode::GET_ALL_STREAM, remoteFrame->header.requestId);
+		}
+
+		return remoteFrame.error();
+	}
+
+	bool SyncDictClient::performPing() {
+		if (mProtocol == DictProtocol::BINARY) {
+			return performFrame(DictOpcode::PING).has_value();
+		}
+
+		boost::system::error_code errorCode;
+		net::streambuf remoteBuffer;
+
+		errorCode = sendMessage(PING_COMMAND);
+
+		if (errorCode) {
+			log::error(TAG, "Can't send message %s: %s", PING_COMMAND, errorCode.message().c_str());
+			mStarted = false;
+			return false;
+		}
+
+		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Receive message isn't correct: %s", errorCode.message().c_str());
+			mStarted = false;
+			return false;
+		}
+
+		return toStringView(remoteBuffer).starts_with(PING_COMMAND);
+	}
+
+	void SyncDictClient::performNegotiation() {
+		boost::system::error_code errorCode;
+		net::streambuf remoteBuffer;
+
+		errorCode = sendMessage(PROTOCOL_V2_COMMAND);
+
+		if (errorCode) {
+			log::error(TAG, "Can't send message %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+			mStarted = false;
+			return;
+		}
+
+		net::read_until(mSocket, remoteBuffer, "\n", errorCode);
+
+		const std::string_view remoteData = toStringView(remoteBuffer);
+
+		if (!errorCode && remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+			log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+		} else {
+			log::error(TAG, "Server doesn't support %s: %s", PROTOCOL_V2_COMMAND, errorCode.message().c_str());
+			mStarted = false;
+		}
+	}
+
+	auto SyncDictClient::sendMessage(std::string_view command, std::string_view payload) -> boost::system::error_code {
+		boost::system::error_code errorCode;
+
+		/* message is never concatenated, command, payload and terminator go out with one gather write */
+		const std::array<net::const_buffer, 3> localBuffers = {
+			net::buffer(command), net::buffer(payload), net::buffer("\n", 1)
+		};
+		net::write(mSocket, localBuffers, errorCode);
+
+		return errorCode;
+	}
+
+	auto SyncDictClient::sendMessage(std::string_view command, uint64_t id) -> boost::system::error_code {
+		std::array<char, std::numeric_limits<uint64_t>::digits10 + 1> localId;
+		const std::to_chars_result localIdEnd = std::to_chars(localId.data(), localId.data() + localId.size(), id);
+
+		return sendMessage(command, std::string_view(localId.data(), localIdEnd.ptr));
+	}
+
+	auto SyncDictClient::performFrame(DictOpcode opcode, std::vector<std::byte>&& payload) -> boost::system::result<DictFrame> {
+		boost::system::error_code errorCode;
+
+		const DictFrame localFrame = makeFrame(opcode, ++mLastRequestId, std::move(payload));
+		const auto localHeader = encodeFrameHeader(localFrame.header);
+		const std::array<net::const_buffer, 2> localBuffers = {
+			net::buffer(localHeader), net::buffer(localFrame.payload)
+		};
+
+		net::write(mSocket, localBuffers, errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't send frame %u: %s", localFrame.header.requestId, errorCode.message().c_str());
+			mStarted = false;
+			return errorCode;
+		}
+
+		return receiveFrame(opcode, localFrame.header.requestId);
+	}
+
+	auto SyncDictClient::receiveFrame(DictOpcode opcode, uint32_t requestId) -> boost::system::result<DictFrame> {
+		boost::system::error_code errorCode;
+
+		std::array<std::byte, DICT_FRAME_HEADER_SIZE> remoteHeader;
+		net::read(mSocket, net::buffer(remoteHeader), errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Receive frame header isn't correct: %s", errorCode.message().c_str());
+			mStarted = false;
+			return errorCode;
+		}
+
+		boost::system::result<DictFrameHeader> header = decodeFrameHeader(remoteHeader);
+
+		if (header.has_error()) {
+			log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+			mStarted = false;
+			return header.error();
+		}
+
+		DictFrame remoteFrame = { .header = *header, .payload = std::vector<std::byte>(header->payloadSize) };
+		net::read(mSocket, net::buffer(remoteFrame.payload), errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Receive frame payload isn't correct: %s", errorCode.message().c_str());
+			mStarted = false;
+			return errorCode;
+		}
+
+		if (remoteFrame.header.requestId != requestId || remoteFrame.header.opcode != opcode) {
+			log::error(TAG, "Receive frame %u doesn't match request %u", remoteFrame.header.requestId, requestId);
+			mStarted = false;
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		if (remoteFrame.header.status == DictStatus::FAILURE) {
+			const std::string message(reinterpret_cast<const char*>(remoteFrame.payload.data()), remoteFrame.payload.size());
+			log::error(TAG, "Server failed to process frame %u: %s", remoteFrame.header.requestId, message.c_str());
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		return remoteFrame;
+	}
 }
@@ -27,28 +27,41 @@
 #include "common/DictCommand.hpp"
 #include "logging/Logging.hpp"
 
-#include <thread>
-#include <charconv>
-
+#include <boost/asio/read.hpp>
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 
 static constexpr const char* const TAG = "SyncDictServer";
 
-using namespace std::string_literals;
-using namespace std::chrono_literals;
-
 namespace lynx {
 
-	SyncDictServer::SyncDictServer(const std::string& host, uint64_t port)
+	SyncDictServer::SyncDictServer(const std::string& host, uint64_t port, const SessionLimits& limits)
 		: mSocket(mContext)
-		, mEndpoint(net::ip::tcp::v4(), port)
-		, mAcceptor(mContext, mEndpoint)
+		, mAcceptor(mContext, net::generic::stream_protocol::endpoint(net::ip::tcp::endpoint(net::ip::tcp::v4(), port)))
 		, dictDao(host)
+		, mHandler(dictDao, mDictDaoMutex)
+		, mLimits(limits)
 		, mStarted(false) {
 		log::info(TAG, "Create server");
 	}
 
+	SyncDictServer::SyncDictServer(const std::string& host, const std::string& socketPath, const SessionLimits& limits)
+		: mSocket(mContext)
+		, mAcceptor(mContext)
+		, dictDao(host)
+		, mHandler(dictDao, mDictDaoMutex)
+		, mLimits(limits)
+		, mStarted(false) {
+		const net::generic::stream_protocol::endpoint endpoint = toLocalEndpoint(socketPath);
+
+		removeLocalSocket(socketPath);
+		mAcceptor.open(endpoint.protocol());
+		mAcceptor.bind(endpoint);
+		mAcceptor.listen();
+
+		log::info(TAG, "Create server on %s", socketPath.c_str());
+	}
+
 	SyncDictServer::~SyncDictServer() {
 		if (mSocket.is_open()) {
 			mSocket.close();
@@ -66,10 +79,18 @@ namespace lynx {
 		boost::system::error_code errorCode;
 		mAcceptor.accept(mSocket, errorCode);
 
+		if (!errorCode) {
+			mSocket.non_blocking(true, errorCode);
+		}
+
 		if (!errorCode) {
 			mStarted = true;
 			dictDao.start();
 			processMessages();
+
+			/* session closed by limit has to release peer too */
+			mSocket.shutdown(net::socket_base::shutdown_both, errorCode);
+			mSocket.close(errorCode);
 		} else {
 			log::error(TAG, "Can't accept client: %s", errorCode.message().c_str());
 		}
@@ -83,197 +104,299 @@ namespace lynx {
 
 	void SyncDictServer::processMessages() {
 		boost::system::error_code errorCode;
-		net::streambuf remoteBuffer;
+		std::string remoteBuffer;
 
 		while (mStarted) {
-			net::read_until(mSocket, remoteBuffer, "\n", errorCode);
+			/* waits only when there is no complete line in buffer */
+			boost::system::result<std::size_t> receivedSize = receiveMessage(remoteBuffer);
 
-			if (errorCode) {
-				log::error(TAG, "Receive data isn't correct: %s", errorCode.message().c_str());
+			if (receivedSize.has_error()) {
+				log::error(TAG, "Receive data isn't correct: %s", receivedSize.error().message().c_str());
 				return;
 			}
 
-			std::string remoteData = toString(remoteBuffer);
-
-			if (remoteData.starts_with(INSERT_COMMAND)) {
-				processInsert(remoteData);
-			} else if (remoteData.starts_with(UPDATE_COMMAND)) {
-				processUpdate(remoteData);
-			} else if (remoteData.starts_with(DELETE_COMMAND)) {
-				processDelete(remoteData);
-			} else if (remoteData.starts_with(GET_BY_ID_COMMAND)) {
-				processGetById(remoteData);
-			} else if (remoteData.starts_with(GET_ALL_COMMAND)) {
-				processGetAll(remoteData);
-			} else if (remoteData.starts_with(QUIT_COMMAND)) {
-				log::error(TAG, "Process %s message", QUIT_COMMAND);
-				mStarted = false;
-			} else {
-				log::error(TAG, "Process unknown message");
+			std::size_t messageSize = *receivedSize;
+			std::size_t offset = 0;
+			uint32_t inFlightCount = 0;
+
+			while (mStarted && messageSize != 0) {
+				const std::string_view remoteData(remoteBuffer.data() + offset, messageSize);
+				offset += messageSize;
+
+				if (remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+					remoteBuffer.erase(0, offset);
+					processNegotiation();
+					processFrames(remoteBuffer);
+					return;
+				}
+
+				processMessage(remoteData);
+
+				/* replies of long pipeline are flushed in parts, so reply buffer stays bounded */
+				if (mLimits.maxInFlightCount != 0 && ++inFlightCount == mLimits.maxInFlightCount) {
+					inFlightCount = 0;
+
+					if (!flushMessages()) {
+						return;
+					}
+				}
+
+				const std::size_t delimiter = remoteBuffer.find('\n', offset);
+				messageSize = (delimiter != std::string::npos) ? delimiter - offset + 1 : 0;
 			}
 
-			std::this_thread::sleep_for(500ms);
+			remoteBuffer.erase(0, offset);
+
+			/* replies of all messages received by one read go out with one write */
+			flushMessages();
 		}
 	}
 
-	void SyncDictServer::processInsert(const std::string& message) {
-		log::debug(TAG, "Process %s message", INSERT_COMMAND);
-
-		std::string remoteData = message.substr(std::strlen(INSERT_COMMAND));
+	void SyncDictServer::processMessage(std::string_view message) {
+		if (!mHandler.processMessage(message, mLocalBuffer)) {
+			log::debug(TAG, "Process %s message", QUIT_COMMAND);
+			mStarted = false;
+		}
+	}
 
-		boost::system::result<Word> remoteWord = mParser.deserializeFromText(remoteData);
+	bool SyncDictServer::flushMessages() {
+		boost::system::error_code errorCode;
 
-		if (remoteWord.has_error()) {
-			net::write(mSocket, net::buffer("Deserialize word error"s + "\n"));
-			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
-			return;
+		if (mLocalBuffer.empty()) {
+			return true;
 		}
 
-		boost::system::result<void> operationStatus = dictDao.insert(remoteWord.value());
+		std::array<net::const_buffer, 1> localBuffers = { net::buffer(mLocalBuffer) };
+		errorCode = sendBuffers(localBuffers);
+		mLocalBuffer.clear();
 
-		if (operationStatus.has_error()) {
-			net::write(mSocket, net::buffer("Db insert word error"s + "\n"));
-			log::error(TAG, "Db insert word error: %s", remoteWord.error().message().c_str());
-			return;
+		if (!errorCode) {
+			log::debug(TAG, "Send reply success");
+		} else {
+			log::error(TAG, "Can't send reply: %s", errorCode.message().c_str());
 		}
+		return !errorCode;
+	}
 
-		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(INSERT_COMMAND + " processed success"s + "\n"), errorCode);
+	void SyncDictServer::processNegotiation() {
+		mLocalBuffer.append(PROTOCOL_V2_COMMAND).append(" processed success\n");
 
-		if (!errorCode) {
-			log::info(TAG, "Send message: %s", INSERT_COMMAND);
+		if (flushMessages()) {
+			log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
 		} else {
-			log::error(TAG, "Can't send %s message: %s", INSERT_COMMAND, errorCode.message().c_str());
+			mStarted = false;
 		}
 	}
 
-	void SyncDictServer::processUpdate(const std::string& message) {
-		log::debug(TAG, "Process %s message", UPDATE_COMMAND);
+	void SyncDictServer::processFrames(std::string& remoteBuffer) {
+		boost::system::error_code errorCode;
+		std::vector<DictFrame> localFrames;
+		std::vector<std::array<std::byte, DICT_FRAME_HEADER_SIZE>> localHeaders;
+		std::vector<net::const_buffer> localBuffers;
+		const std::size_t flushCount = (mLimits.maxInFlightCount == 0) ? DICT_FRAME_MAX_FLUSH_COUNT
+				: std::min<std::size_t>(DICT_FRAME_MAX_FLUSH_COUNT, mLimits.maxInFlightCount);
+
+		/* reads at least missing bytes of frame, frames pipelined behind it stay in buffer */
+		auto receiveFrameData = [this, &remoteBuffer, &errorCode](std::size_t size, std::chrono::milliseconds timeout) {
+			errorCode = receiveAtLeast(remoteBuffer, size, std::chrono::steady_clock::now() + timeout);
+			return !errorCode;
+		};
+
+		auto hasBufferedFrame = [&remoteBuffer]() {
+			if (remoteBuffer.size() < DICT_FRAME_HEADER_SIZE) {
+				return false;
+			}
 
-		std::string remoteData = message.substr(std::strlen(UPDATE_COMMAND));
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(
+					std::as_bytes(std::span(remoteBuffer.data(), DICT_FRAME_HEADER_SIZE)));
+			return header.has_value() && remoteBuffer.size() >= DICT_FRAME_HEADER_SIZE + header->payloadSize;
+		};
 
-		boost::system::result<Word> remoteWord = mParser.deserializeFromText(remoteData);
+		/* replies are kept until no complete frame is left in buffer and then written with one gather write */
+		auto flushFrames = [this, &errorCode, &localFrames, &localHeaders, &localBuffers]() {
+			localHeaders.reserve(localFrames.size());
 
-		if (remoteWord.has_error()) {
-			net::write(mSocket, net::buffer("Deserialize word error"s + "\n"));
-			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
-			return;
-		}
+			for (const DictFrame& localFrame : localFrames) {
+				localHeaders.push_back(encodeFrameHeader(localFrame.header));
+				localBuffers.push_back(net::buffer(localHeaders.back()));
+				localBuffers.push_back(net::buffer(localFrame.payload));
+			}
 
-		boost::system::result<void> operationStatus = dictDao.update(remoteWord.value());
+			errorCode = sendBuffers(localBuffers);
 
-		if (operationStatus.has_error()) {
-			net::write(mSocket, net::buffer("Db update word error"s + "\n"));
-			log::error(TAG, "Db update word error: %s", remoteWord.error().message().c_str());
-			return;
-		}
+			if (!errorCode) {
+				log::debug(TAG, "Send %zu frames success", localFrames.size());
+			} else {
+				log::error(TAG, "Can't send frames: %s", errorCode.message().c_str());
+			}
 
-		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(UPDATE_COMMAND + " processed success"s + "\n"), errorCode);
+			localFrames.clear();
+			localHeaders.clear();
+			localBuffers.clear();
+			return !errorCode;
+		};
 
-		if (!errorCode) {
-			log::info(TAG, "Send message: %s", UPDATE_COMMAND);
-		} else {
-			log::error(TAG, "Can't send %s message: %s", UPDATE_COMMAND, errorCode.message().c_str());
-		}
-	}
+		/* blocking write is backpressure of streamed reply, next chunk isn't read from db until peer takes this one */
+		auto sendFrame = [&localFrames, &flushFrames](DictFrame&& localFrame) {
+			localFrames.push_back(std::move(localFrame));
+			return flushFrames();
+		};
 
-	void SyncDictServer::processDelete(const std::string& message) {
-		log::debug(TAG, "Process %s message", DELETE_COMMAND);
+		while (mStarted) {
+			/* idle timeout runs until next frame is started, read timeout after that */
+			if (!receiveFrameData(DICT_FRAME_HEADER_SIZE, remoteBuffer.empty() ? mLimits.idleTimeout : mLimits.readTimeout)) {
+				log::error(TAG, "Receive frame header isn't correct: %s", errorCode.message().c_str());
+				return;
+			}
 
-		uint64_t wordId = 0;
-		std::string remoteData = message.substr(std::strlen(DELETE_COMMAND));
-		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(
+					std::as_bytes(std::span(remoteBuffer.data(), DICT_FRAME_HEADER_SIZE)));
 
-		if (remoteWordId.ec != std::errc{}) {
-			net::write(mSocket, net::buffer("Parse word id error"s + "\n"));
-			log::error(TAG, "Parse word id error: %s", std::make_error_code(remoteWordId.ec).message().c_str());
-			return;
-		}
+			if (header.has_error()) {
+				log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+				return;
+			}
+
+			if (header->payloadSize > mLimits.maxMessageSize) {
+				log::error(TAG, "Frame %u of %u bytes exceeds limit", header->requestId, header->payloadSize);
+				localFrames.push_back(makeErrorFrame(header->opcode, header->requestId, "Frame exceeds message size limit"));
+				flushFrames();
+				return;
+			}
 
-		boost::system::result<void> operationStatus = dictDao.remove(wordId);
+			if (!receiveFrameData(DICT_FRAME_HEADER_SIZE + header->payloadSize, mLimits.readTimeout)) {
+				log::error(TAG, "Receive frame payload isn't correct: %s", errorCode.message().c_str());
+				return;
+			}
 
-		if (operationStatus.has_error()) {
-			net::write(mSocket, net::buffer("Db delete word error"s + "\n"));
-			log::error(TAG, "Db delete word error: %s", operationStatus.error().message().c_str());
-			return;
-		}
+			if (header->opcode == DictOpcode::GET_ALL_STREAM) {
+				remoteBuffer.erase(0, DICT_FRAME_HEADER_SIZE + header->payloadSize);
 
-		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(DELETE_COMMAND + " processed success"s + "\n"), errorCode);
+				if (!localFrames.empty() && !flushFrames()) {
+					return;
+				}
 
-		if (!errorCode) {
-			log::info(TAG, "Send message: %s", DELETE_COMMAND);
-		} else {
-			log::error(TAG, "Can't send %s message: %s", DELETE_COMMAND, errorCode.message().c_str());
-		}
-	}
+				/* every chunk is sent before next page is read, so dao isn't locked while peer is slow */
+				DictStreamCursor cursor{ .header = *header };
+
+				while (!cursor.finished) {
+					if (!sendFrame(mHandler.processStreamFrame(cursor))) {
+						return;
+					}
+				}
+				continue;
+			}
 
-	void SyncDictServer::processGetById(const std::string& message) {
-		log::debug(TAG, "Process %s message", GET_BY_ID_COMMAND);
+			/* payload is parsed in place, frame is consumed after reply is built */
+			const auto payload = std::as_bytes(std::span(remoteBuffer.data() + DICT_FRAME_HEADER_SIZE, header->payloadSize));
+			std::optional<DictFrame> localFrame = mHandler.processFrame(*header, payload);
+			remoteBuffer.erase(0, DICT_FRAME_HEADER_SIZE + header->payloadSize);
 
-		uint64_t wordId = 0;
-		std::string remoteData = message.substr(std::strlen(GET_BY_ID_COMMAND));
-		auto remoteWordId = std::from_chars(remoteData.data(), remoteData.data() + remoteData.size(), wordId);
+			if (!localFrame.has_value()) {
+				log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+				mStarted = false;
 
-		if (remoteWordId.ec != std::errc{}) {
-			net::write(mSocket, net::buffer("Parse word id error"s + "\n"));
-			log::error(TAG, "Parse word id error: %s", std::make_error_code(remoteWordId.ec).message().c_str());
-			return;
-		}
+				if (!localFrames.empty()) {
+					flushFrames();
+				}
+				return;
+			}
 
-		boost::system::result<Word> localWord = dictDao.getById(wordId);
+			localFrames.push_back(std::move(*localFrame));
+
+			if (localFrames.size() < flushCount && hasBufferedFrame()) {
+				continue;
+			}
 
-		if (localWord.has_error()) {
-			net::write(mSocket, net::buffer("Db get word by id error"s + "\n"));
-			log::error(TAG, "Db get word by id error: %s", localWord.error().message().c_str());
-			return;
+			if (!flushFrames()) {
+				return;
+			}
 		}
+	}
 
-		boost::system::result<std::string> localData = mParser.serializeToText(*localWord);
+	auto SyncDictServer::receiveMessage(std::string& remoteBuffer) -> boost::system::result<std::size_t> {
+		std::size_t delimiter = remoteBuffer.find('\n');
+		auto deadline = std::chrono::steady_clock::now() + (remoteBuffer.empty() ? mLimits.idleTimeout : mLimits.readTimeout);
 
-		if (localData.has_error()) {
-			net::write(mSocket, net::buffer("Serialize word error"s + "\n"));
-			log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
-			return;
-		}
+		while (delimiter == std::string::npos) {
+			if (remoteBuffer.size() >= mLimits.maxMessageSize) {
+				log::error(TAG, "Message exceeds %zu bytes", mLimits.maxMessageSize);
+				return boost::system::errc::make_error_code(boost::system::errc::message_size);
+			}
 
-		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(GET_BY_ID_COMMAND + localData.value() + "\n"), errorCode);
+			const std::size_t offset = remoteBuffer.size();
+			boost::system::error_code errorCode = receiveAtLeast(remoteBuffer, offset + 1, deadline);
 
-		if (!errorCode) {
-			log::info(TAG, "Send message: %s", GET_BY_ID_COMMAND);
-		} else {
-			log::error(TAG, "Can't send %s message: %s", GET_BY_ID_COMMAND, errorCode.message().c_str());
+			if (errorCode) {
+				return errorCode;
+			}
+
+			/* message is started, so slow peer has read timeout to complete it */
+			if (offset == 0) {
+				deadline = std::chrono::steady_clock::now() + mLimits.readTimeout;
+			}
+
+			delimiter = remoteBuffer.find('\n', offset);
 		}
+
+		return delimiter + 1;
 	}
 
-	void SyncDictServer::processGetAll(const std::string& message) {
-		log::debug(TAG, "Process %s message", GET_ALL_COMMAND);
+	auto SyncDictServer::receiveAtLeast(std::string& remoteBuffer, std::size_t size, std::chrono::steady_clock::time_point deadline)
+		-> boost::system::error_code {
+		boost::system::error_code errorCode;
 
-		boost::system::result<std::vector<Word>> localWords = dictDao.getAll();
+		/* buffer never grows beyond one message of maximum size, whatever peer sends */
+		const std::size_t maxBufferSize = DICT_FRAME_HEADER_SIZE + mLimits.maxMessageSize;
 
-		if (localWords.has_error()) {
-			net::write(mSocket, net::buffer("Db get all words error"s + "\n"));
-			log::error(TAG, "Db get all words error: %s", localWords.error().message().c_str());
-			return;
-		}
+		while (remoteBuffer.size() < size) {
+			net::read(mSocket, net::dynamic_buffer(remoteBuffer, maxBufferSize), net::transfer_at_least(size - remoteBuffer.size()), errorCode);
 
-		boost::system::result<std::string> localData = mParser.serializeWordsToText(*localWords);
+			if (!errorCode && remoteBuffer.size() < size) {
+				return boost::system::errc::make_error_code(boost::system::errc::message_size);
+			}
+
+			if (errorCode != net::error::would_block) {
+				return errorCode;
+			}
 
-		if (localData.has_error()) {
-			net::write(mSocket, net::buffer("Serialize words error"s + "\n"));
-			log::error(TAG, "Serialize words error: %s", localData.error().message().c_str());
-			return;
+			errorCode = waitReadable(mSocket.native_handle(), deadline);
+
+			if (errorCode) {
+				return errorCode;
+			}
 		}
 
+		return {};
+	}
+
+	auto SyncDictServer::sendBuffers(std::span<net::const_buffer> localBuffers) -> boost::system::error_code {
 		boost::system::error_code errorCode;
-		net::write(mSocket, net::buffer(GET_ALL_COMMAND + localData.value() + "\n"), errorCode);
+		const auto deadline = std::chrono::steady_clock::now() + mLimits.writeTimeout;
 
-		if (!errorCode) {
-			log::info(TAG, "Send message: %s", GET_ALL_COMMAND);
-		} else {
-			log::error(TAG, "Can't send %s message: %s", GET_ALL_COMMAND, errorCode.message().c_str());
+		while (true) {
+			std::size_t size = net::write(mSocket, localBuffers, errorCode);
+
+			if (errorCode != net::error::would_block) {
+				return errorCode;
+			}
+
+			/* written part is dropped, rest goes out once peer opens its receive window */
+			while (size != 0 || (!localBuffers.empty() && localBuffers.front().size() == 0)) {
+				const std::size_t consumedSize = std::min(size, localBuffers.front().size());
+				localBuffers.front() += consumedSize;
+				size -= consumedSize;
+
+				if (localBuffers.front().size() == 0) {
+					localBuffers = localBuffers.subspan(1);
+				}
+			}
+
+			errorCode = waitWritable(mSocket.native_handle(), deadline);
+
+			if (errorCode) {
+				return errorCode;
+			}
 		}
 	}
 }
@@ -0,0 +1,465 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/EpollDictServer.hpp"
+#include "net/DictRequestHandler.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <optional>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static constexpr const char* const TAG = "EpollDictServer";
+static constexpr std::size_t MAX_EVENT_COUNT = 256;
+static constexpr std::size_t RECEIVE_CHUNK_SIZE = 64 * 1024;
+
+namespace lynx {
+
+	static auto lastError() -> std::error_code {
+		return std::error_code(errno, std::system_category());
+	}
+
+	struct EpollDictServer::Connection final {
+		Connection(int socketFd, SyncDictDao& dictDao, std::mutex& dictDaoMutex)
+			: socketFd(socketFd)
+			, handler(dictDao, dictDaoMutex)
+			, protocol(DictProtocol::TEXT)
+			, outputOffset(0)
+			, closing(false) {
+		}
+
+		~Connection() {
+			::close(socketFd);
+		}
+
+		[[nodiscard]] bool isOutputFull() const {
+			return output.size() - outputOffset >= DICT_OUTPUT_HIGH_WATER_MARK;
+		}
+
+		int socketFd;
+		DictRequestHandler handler;
+		DictProtocol protocol;
+
+		std::string input;
+		std::string output;
+		std::size_t outputOffset;
+		/* stream in progress, frames after it wait in input until it ends */
+		std::optional<DictStreamCursor> stream;
+		bool closing;
+	};
+
+	struct EpollDictServer::EventLoop final {
+		~EventLoop() {
+			connections.clear();
+
+			for (int fd : {epollFd, listenFd, wakeupFd}) {
+				if (fd >= 0) {
+					::close(fd);
+				}
+			}
+		}
+
+		int epollFd = -1;
+		int listenFd = -1;
+		int wakeupFd = -1;
+		std::unordered_map<int, std::unique_ptr<Connection>> connections;
+	};
+
+	EpollDictServer::EpollDictServer(const std::string& host, uint16_t port, uint32_t threadCount, const SessionLimits& limits)
+		: mPort(port)
+		, mThreadCount(std::max(threadCount, 1u))
+		, mLimits(limits)
+		, mDictDao(host)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+	}
+
+	EpollDictServer::~EpollDictServer() {
+		stop();
+		log::info(TAG, "Destroy server");
+	}
+
+	bool EpollDictServer::isStarted() const { return mStarted; }
+
+	void EpollDictServer::start() {
+		log::info(TAG, "Start server with %u event loops", mThreadCount);
+
+		mDictDao.start();
+
+		{
+			std::lock_guard<std::mutex> lock(mLoopsMutex);
+
+			for (uint32_t i = 0; i < mThreadCount; ++i) {
+				boost::system::result<std::unique_ptr<EventLoop>> loop = openLoop();
+
+				if (loop.has_error()) {
+					log::error(TAG, "Can't open event loop on port %u: %s", mPort, loop.error().message().c_str());
+					mLoops.clear();
+					return;
+				}
+
+				mLoops.push_back(std::move(*loop));
+			}
+
+			mStarted = true;
+		}
+
+		for (uint32_t i = 1; i < mThreadCount; ++i) {
+			mThreads.emplace_back(&EpollDictServer::runLoop, this, std::ref(*mLoops[i]));
+		}
+		runLoop(*mLoops[0]);
+
+		for (std::thread& thread : mThreads) {
+			thread.join();
+		}
+
+		std::lock_guard<std::mutex> lock(mLoopsMutex);
+		mThreads.clear();
+		mLoops.clear();
+	}
+
+	void EpollDictServer::stop() {
+		{
+			std::lock_guard<std::mutex> lock(mLoopsMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+
+			/* wakes every loop blocked in epoll_wait, loops see mStarted and return, eventfd keeps wakeup of loop not waiting yet */
+			for (const std::unique_ptr<EventLoop>& loop : mLoops) {
+				const uint64_t value = 1;
+
+				if (::write(loop->wakeupFd, &value, sizeof(value)) < 0) {
+					log::error(TAG, "Can't wake up event loop: %s", lastError().message().c_str());
+				}
+			}
+		}
+
+		mDictDao.stop();
+		log::info(TAG, "Stop server");
+	}
+
+	auto EpollDictServer::openLoop() -> boost::system::result<std::unique_ptr<EventLoop>> {
+		auto loop = std::make_unique<EventLoop>();
+		const int enable = 1;
+
+		loop->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+		loop->wakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		loop->listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+		if (loop->epollFd < 0 || loop->wakeupFd < 0 || loop->listenFd < 0) {
+			return lastError();
+		}
+
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(mPort);
+		address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+		if (::setsockopt(loop->listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0
+				|| ::setsockopt(loop->listenFd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0
+				|| ::bind(loop->listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+				|| ::listen(loop->listenFd, SOMAXCONN) < 0) {
+			return lastError();
+		}
+
+		epoll_event listenEvent = { .events = EPOLLIN | EPOLLET, .data = { .fd = loop->listenFd } };
+		epoll_event wakeupEvent = { .events = EPOLLIN, .data = { .fd = loop->wakeupFd } };
+
+		if (::epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->listenFd, &listenEvent) < 0
+				|| ::epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->wakeupFd, &wakeupEvent) < 0) {
+			return lastError();
+		}
+
+		return loop;
+	}
+
+	void EpollDictServer::runLoop(EventLoop& loop) {
+		std::array<epoll_event, MAX_EVENT_COUNT> events;
+
+		while (mStarted) {
+			const int eventCount = ::epoll_wait(loop.epollFd, events.data(), static_cast<int>(events.size()), -1);
+
+			if (eventCount < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+
+				log::error(TAG, "Can't wait for events: %s", lastError().message().c_str());
+				return;
+			}
+
+			for (int i = 0; i < eventCount; ++i) {
+				const int fd = events[i].data.fd;
+				const uint32_t flags = events[i].events;
+
+				if (fd == loop.wakeupFd) {
+					continue;
+				} else if (fd == loop.listenFd) {
+					acceptClients(loop);
+					continue;
+				}
+
+				auto connection = loop.connections.find(fd);
+
+				if (connection == loop.connections.end()) {
+					continue;
+				}
+
+				/* drained output may let parked input and stream go on, so both readiness changes serve whole client */
+				const bool keeping = (flags & EPOLLERR) == 0 && serveClient(*connection->second);
+
+				if (!keeping) {
+					closeClient(loop, fd);
+				}
+			}
+		}
+	}
+
+	void EpollDictServer::acceptClients(EventLoop& loop) {
+		const int enable = 1;
+
+		while (true) {
+			const int socketFd = ::accept4(loop.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+			if (socketFd < 0) {
+				if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+					log::error(TAG, "Can't accept client: %s", lastError().message().c_str());
+				}
+
+				if (errno == EINTR) {
+					continue;
+				}
+				return;
+			}
+
+			::setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+			auto connection = std::make_unique<Connection>(socketFd, mDictDao, mDictDaoMutex);
+			epoll_event clientEvent = {
+				.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET,
+				.data = { .fd = socketFd }
+			};
+
+			if (::epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, socketFd, &clientEvent) < 0) {
+				log::error(TAG, "Can't watch client: %s", lastError().message().c_str());
+				continue;
+			}
+
+			log::debug(TAG, "Accept client %d", socketFd);
+			loop.connections.emplace(socketFd, std::move(connection));
+		}
+	}
+
+	void EpollDictServer::closeClient(EventLoop& loop, int socketFd) {
+		log::debug(TAG, "Close client %d", socketFd);
+
+		::epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, socketFd, nullptr);
+		loop.connections.erase(socketFd);
+	}
+
+	bool EpollDictServer::serveClient(Connection& connection) {
+		/* edge-triggered, so loop repeats while it was parked by output which socket then took whole */
+		while (true) {
+			const bool receiving = receiveData(connection);
+
+			if (!processData(connection)) {
+				return false;
+			}
+
+			const bool parking = connection.isOutputFull();
+
+			if (!sendData(connection) || !receiving) {
+				return false;
+			}
+
+			if (!parking || !connection.output.empty()) {
+				return true;
+			}
+		}
+	}
+
+	bool EpollDictServer::receiveData(Connection& connection) {
+		std::array<char, RECEIVE_CHUNK_SIZE> remoteBuffer;
+
+		/* client which doesn't read replies isn't read either, rest of its data waits in socket */
+		while (!connection.isOutputFull()) {
+			const ssize_t receivedSize = ::recv(connection.socketFd, remoteBuffer.data(), remoteBuffer.size(), 0);
+
+			if (receivedSize > 0) {
+				connection.input.append(remoteBuffer.data(), receivedSize);
+
+				/* complete messages are answered early, what is left is one unfinished message which can't pass limit */
+				if (connection.input.size() > mLimits.maxMessageSize + DICT_FRAME_HEADER_SIZE
+						&& (!processData(connection) || (connection.input.size() > mLimits.maxMessageSize + DICT_FRAME_HEADER_SIZE
+														 && !connection.isOutputFull()))) {
+					log::error(TAG, "Received message exceeds %zu bytes", mLimits.maxMessageSize);
+					return false;
+				}
+				continue;
+			} else if (receivedSize == 0) {
+				log::debug(TAG, "Client closed connection");
+				return false;
+			} else if (errno == EINTR) {
+				continue;
+			} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				return true;
+			}
+
+			log::error(TAG, "Receive data isn't correct: %s", lastError().message().c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	bool EpollDictServer::processData(Connection& connection) {
+		if (connection.protocol == DictProtocol::TEXT && !processMessages(connection)) {
+			return false;
+		}
+
+		if (connection.protocol == DictProtocol::BINARY && !processFrames(connection)) {
+			return false;
+		}
+
+		return true;
+	}
+
+	bool EpollDictServer::processMessages(Connection& connection) {
+		std::size_t offset = 0;
+		std::size_t delimiter = 0;
+
+		while (!connection.closing && !connection.isOutputFull()
+				&& (delimiter = connection.input.find('\n', offset)) != std::string::npos) {
+			const std::string_view remoteData(connection.input.data() + offset, delimiter - offset + 1);
+			offset = delimiter + 1;
+
+			if (remoteData.starts_with(PROTOCOL_V2_COMMAND)) {
+				log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+				connection.output.append(PROTOCOL_V2_COMMAND).append(" processed success\n");
+				connection.protocol = DictProtocol::BINARY;
+				break;
+			}
+
+			if (!connection.handler.processMessage(remoteData, connection.output)) {
+				log::debug(TAG, "Process %s message", QUIT_COMMAND);
+				connection.closing = true;
+			}
+		}
+
+		connection.input.erase(0, offset);
+		return true;
+	}
+
+	bool EpollDictServer::processFrames(Connection& connection) {
+		std::size_t offset = 0;
+
+		processStream(connection);
+
+		/* frames are parsed only while no stream runs and output is below high water mark */
+		while (!connection.closing && !connection.stream.has_value() && !connection.isOutputFull()
+				&& connection.input.size() - offset >= DICT_FRAME_HEADER_SIZE) {
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(
+					std::as_bytes(std::span(connection.input.data() + offset, DICT_FRAME_HEADER_SIZE)));
+
+			if (header.has_error()) {
+				log::error(TAG, "Decode frame header error: %s", header.error().message().c_str());
+				return false;
+			}
+
+			if (connection.input.size() - offset < DICT_FRAME_HEADER_SIZE + header->payloadSize) {
+				break;
+			}
+
+			const auto payload = std::as_bytes(std::span(connection.input.data() + offset + DICT_FRAME_HEADER_SIZE, header->payloadSize));
+			offset += DICT_FRAME_HEADER_SIZE + header->payloadSize;
+
+			/* loop can't block for backpressure, so chunks of stream are read as socket drains output */
+			if (header->opcode == DictOpcode::GET_ALL_STREAM) {
+				connection.stream = DictStreamCursor{ .header = *header };
+				processStream(connection);
+				continue;
+			}
+
+			std::optional<DictFrame> localFrame = connection.handler.processFrame(*header, payload);
+
+			if (!localFrame.has_value()) {
+				log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+				connection.closing = true;
+				break;
+			}
+
+			appendFrame(connection.output, *localFrame);
+		}
+
+		connection.input.erase(0, offset);
+		return true;
+	}
+
+	void EpollDictServer::processStream(Connection& connection) {
+		while (connection.stream.has_value() && !connection.isOutputFull()) {
+			appendFrame(connection.output, connection.handler.processStreamFrame(*connection.stream));
+
+			if (connection.stream->finished) {
+				connection.stream.reset();
+			}
+		}
+	}
+
+	bool EpollDictServer::sendData(Connection& connection) {
+		while (connection.outputOffset < connection.output.size()) {
+			const ssize_t sentSize = ::send(connection.socketFd, connection.output.data() + connection.outputOffset,
+					connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+
+			if (sentSize >= 0) {
+				connection.outputOffset += sentSize;
+			} else if (errno == EINTR) {
+				continue;
+			} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				/* rest is sent when EPOLLOUT reports free space in socket buffer */
+				return true;
+			} else {
+				log::error(TAG, "Can't send reply: %s", lastError().message().c_str());
+				return false;
+			}
+		}
+
+		connection.output.clear();
+		connection.outputOffset = 0;
+
+		return !connection.closing;
+	}
+}
@@ -0,0 +1,258 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/IoUring.hpp"
+#include "logging/Logging.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static constexpr const char* const TAG = "IoUring";
+
+namespace lynx {
+
+	static auto lastError() -> std::error_code {
+		return std::error_code(errno, std::system_category());
+	}
+
+	static auto setupRing(uint32_t entryCount, io_uring_params& params) -> int {
+		return static_cast<int>(::syscall(__NR_io_uring_setup, entryCount, &params));
+	}
+
+	static auto enterRing(int ringFd, uint32_t submitCount, uint32_t waitCount, uint32_t flags) -> int {
+		return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, submitCount, waitCount, flags, nullptr, 0));
+	}
+
+	static auto registerRing(int ringFd, uint32_t opcode, void* argument, uint32_t argumentCount) -> int {
+		return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, argument, argumentCount));
+	}
+
+	template<typename T>
+	static auto offsetPointer(void* memory, uint32_t offset) -> T* {
+		return reinterpret_cast<T*>(static_cast<char*>(memory) + offset);
+	}
+
+	IoUring::IoUring()
+		: mRingFd(-1)
+		, mEntryCount(0)
+		, mRingMemory(MAP_FAILED)
+		, mRingSize(0)
+		, mSqes(nullptr)
+		, mSqesSize(0)
+		, mSqHead(nullptr)
+		, mSqTail(nullptr)
+		, mSqMask(nullptr)
+		, mSqLocalTail(0)
+		, mCqHead(nullptr)
+		, mCqTail(nullptr)
+		, mCqMask(nullptr)
+		, mCqes(nullptr)
+		, mBufferRing(nullptr)
+		, mBufferRingSize(0)
+		, mBuffers(nullptr)
+		, mBuffersSize(0)
+		, mBufferCount(0)
+		, mBufferSize(0)
+		, mBufferTail(0) {
+	}
+
+	IoUring::~IoUring() {
+		/* closing ring cancels requests in flight before memory they may use is unmapped */
+		if (mRingFd >= 0) {
+			::close(mRingFd);
+		}
+
+		if (mSqes != nullptr) {
+			::munmap(mSqes, mSqesSize);
+		}
+
+		if (mRingMemory != MAP_FAILED) {
+			::munmap(mRingMemory, mRingSize);
+		}
+
+		if (mBufferRing != nullptr) {
+			::munmap(mBufferRing, mBufferRingSize);
+		}
+
+		if (mBuffers != nullptr) {
+			::munmap(mBuffers, mBuffersSize);
+		}
+	}
+
+	auto IoUring::open(uint32_t entryCount) -> boost::system::result<void> {
+		io_uring_params params = {};
+		params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+
+		mRingFd = setupRing(entryCount, params);
+
+		if (mRingFd < 0 && errno == EINVAL) {
+			log::debug(TAG, "Setup flags aren't supported, use defaults");
+
+			params = {};
+			mRingFd = setupRing(entryCount, params);
+		}
+
+		if (mRingFd < 0) {
+			return lastError();
+		}
+
+		/* both queues share one mapping since 5.4, older kernels aren't worth separate path */
+		if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_NODROP) == 0) {
+			return std::make_error_code(std::errc::function_not_supported);
+		}
+
+		mEntryCount = params.sq_entries;
+		mRingSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+				params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+		mRingMemory = ::mmap(nullptr, mRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQ_RING);
+
+		if (mRingMemory == MAP_FAILED) {
+			return lastError();
+		}
+
+		mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = ::mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQES);
+
+		if (sqes == MAP_FAILED) {
+			return lastError();
+		}
+
+		mSqes = static_cast<io_uring_sqe*>(sqes);
+		mSqHead = offsetPointer<uint32_t>(mRingMemory, params.sq_off.head);
+		mSqTail = offsetPointer<uint32_t>(mRingMemory, params.sq_off.tail);
+		mSqMask = offsetPointer<uint32_t>(mRingMemory, params.sq_off.ring_mask);
+		mSqLocalTail = *mSqTail;
+
+		mCqHead = offsetPointer<uint32_t>(mRingMemory, params.cq_off.head);
+		mCqTail = offsetPointer<uint32_t>(mRingMemory, params.cq_off.tail);
+		mCqMask = offsetPointer<uint32_t>(mRingMemory, params.cq_off.ring_mask);
+		mCqes = offsetPointer<io_uring_cqe>(mRingMemory, params.cq_off.cqes);
+
+		/* submission slots map one to one on entries, so index array is filled once */
+		uint32_t* sqArray = offsetPointer<uint32_t>(mRingMemory, params.sq_off.array);
+
+		for (uint32_t i = 0; i < params.sq_entries; ++i) {
+			sqArray[i] = i;
+		}
+
+		std::vector<char> probeMemory(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op));
+		auto* probe = reinterpret_cast<io_uring_probe*>(probeMemory.data());
+
+		if (registerRing(mRingFd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+			return lastError();
+		}
+
+		for (uint32_t i = 0; i < probe->ops_len; ++i) {
+			mSupportedOps[probe->ops[i].op] = (probe->ops[i].flags & IO_URING_OP_SUPPORTED) != 0;
+		}
+
+		return {};
+	}
+
+	bool IoUring::isSupported(uint8_t opcode) const {
+		return mSupportedOps[opcode];
+	}
+
+	auto IoUring::registerBuffers(uint16_t groupId, uint16_t bufferCount, uint32_t bufferSize) -> boost::system::result<void> {
+		mBufferRingSize = bufferCount * sizeof(io_uring_buf);
+		void* bufferRing = ::mmap(nullptr, mBufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (bufferRing == MAP_FAILED) {
+			return lastError();
+		}
+
+		mBufferRing = static_cast<io_uring_buf_ring*>(bufferRing);
+		mBuffersSize = static_cast<std::size_t>(bufferCount) * bufferSize;
+		void* buffers = ::mmap(nullptr, mBuffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (buffers == MAP_FAILED) {
+			return lastError();
+		}
+
+		mBuffers = static_cast<char*>(buffers);
+		mBufferCount = bufferCount;
+		mBufferSize = bufferSize;
+
+		io_uring_buf_reg registration = {};
+		registration.ring_addr = reinterpret_cast<uint64_t>(mBufferRing);
+		registration.ring_entries = bufferCount;
+		registration.bgid = groupId;
+
+		if (registerRing(mRingFd, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+			return lastError();
+		}
+
+		for (uint16_t i = 0; i < bufferCount; ++i) {
+			recycleBuffer(i);
+		}
+
+		return {};
+	}
+
+	auto IoUring::getBuffer(uint16_t bufferId, std::size_t size) -> std::span<const char> {
+		return { mBuffers + static_cast<std::size_t>(bufferId) * mBufferSize, size };
+	}
+
+	void IoUring::recycleBuffer(uint16_t bufferId) {
+		/* C++ gives empty member of flexible array wrapper non-zero size, so bufs can't be used to index ring */
+		io_uring_buf& buffer = reinterpret_cast<io_uring_buf*>(mBufferRing)[mBufferTail & (mBufferCount - 1)];
+		buffer.addr = reinterpret_cast<uint64_t>(mBuffers + static_cast<std::size_t>(bufferId) * mBufferSize);
+		buffer.len = mBufferSize;
+		buffer.bid = bufferId;
+
+		std::atomic_ref(mBufferRing->tail).store(++mBufferTail, std::memory_order_release);
+	}
+
+	auto IoUring::prepare() -> io_uring_sqe* {
+		if (mSqLocalTail - std::atomic_ref(*mSqHead).load(std::memory_order_acquire) >= mEntryCount) {
+			if (boost::system::result<uint32_t> result = submit(0); result.has_error()) {
+				log::error(TAG, "Can't flush submission queue: %s", result.error().message().c_str());
+			}
+		}
+
+		io_uring_sqe* sqe = &mSqes[mSqLocalTail & *mSqMask];
+		std::memset(sqe, 0, sizeof(io_uring_sqe));
+		++mSqLocalTail;
+
+		return sqe;
+	}
+
+	auto IoUring::submit(uint32_t waitCount) -> boost::system::result<uint32_t> {
+		std::atomic_ref(*mSqTail).store(mSqLocalTail, std::memory_order_release);
+
+		const uint32_t submitCount = mSqLocalTail - std::atomic_ref(*mSqHead).load(std::memory_order_acquire);
+		const int result = enterRing(mRingFd, submitCount, waitCount, waitCount > 0 ? IORING_ENTER_GETEVENTS : 0);
+
+		if (result < 0) {
+			return lastError();
+		}
+
+		return static_cast<uint32_t>(result);
+	}
+}
@@ -0,0 +1,293 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/SharedMemoryDictClient.hpp"
+#include "net/NetworkUtils.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <cstring>
+
+#include <sys/socket.h>
+
+static constexpr const char* const TAG = "SharedMemoryDictClient";
+static constexpr std::chrono::milliseconds FRAME_POLL_TIMEOUT(100);
+
+namespace lynx {
+
+	SharedMemoryDictClient::SharedMemoryDictClient(const std::string& socketPath)
+		: mSocket(mContext)
+		, mEndpoint(toLocalEndpoint(socketPath))
+		, mLastRequestId(0)
+		, mStarted(false) {
+		log::info(TAG, "Create client");
+	}
+
+	SharedMemoryDictClient::~SharedMemoryDictClient() {
+		if (mSocket.is_open()) {
+			mSocket.close();
+		}
+		mStarted = false;
+
+		log::info(TAG, "Destroy client");
+	}
+
+	bool SharedMemoryDictClient::isStarted() const { return mStarted; }
+
+	void SharedMemoryDictClient::start() {
+		log::info(TAG, "Start client");
+
+		boost::system::error_code errorCode;
+		mSocket.connect(mEndpoint, errorCode);
+
+		if (errorCode) {
+			log::error(TAG, "Can't connect to server: %s", errorCode.message().c_str());
+			return;
+		}
+
+		boost::system::result<SharedMemoryRegion> region = receiveRegion();
+
+		if (region.has_error()) {
+			log::error(TAG, "Can't receive shared memory: %s", region.error().message().c_str());
+			mSocket.close(errorCode);
+			return;
+		}
+
+		const uint32_t ringCapacity = SharedMemoryRing::getCapacityFor(region->getSize() / 2);
+
+		if (ringCapacity == 0) {
+			log::error(TAG, "Shared memory of %zu bytes doesn't hold rings", region->getSize());
+			mSocket.close(errorCode);
+			return;
+		}
+
+		mRegion.emplace(std::move(*region));
+		mRequestRing.emplace(mRegion->getData(), ringCapacity);
+		mResponseRing.emplace(mRegion->getData() + mRegion->getSize() / 2, ringCapacity);
+		mStarted = true;
+	}
+
+	void SharedMemoryDictClient::stop() {
+		mStarted = false;
+		log::info(TAG, "Stop client");
+	}
+
+	void SharedMemoryDictClient::performQuit() {
+		if (!mStarted) {
+			return;
+		}
+
+		const DictFrame localFrame = makeFrame(DictOpcode::QUIT, ++mLastRequestId);
+		boost::system::result<void> status = mRequestRing->write(localFrame, FRAME_POLL_TIMEOUT);
+
+		if (status.has_error()) {
+			log::error(TAG, "Can't send frame %s: %s", QUIT_COMMAND, status.error().message().c_str());
+		}
+	}
+
+	void SharedMemoryDictClient::performInsert(const Word& word) {
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeToBuffer(word);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+			return;
+		}
+
+		if (performFrame(DictOpcode::INSERT, std::move(*localData)).has_value()) {
+			log::debug(TAG, "Receive frame %s success", INSERT_COMMAND);
+		}
+	}
+
+	void SharedMemoryDictClient::performUpdate(const Word& word) {
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeToBuffer(word);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word error: %s", localData.error().message().c_str());
+			return;
+		}
+
+		if (performFrame(DictOpcode::UPDATE, std::move(*localData)).has_value()) {
+			log::debug(TAG, "Receive frame %s success", UPDATE_COMMAND);
+		}
+	}
+
+	void SharedMemoryDictClient::performDelete(uint64_t id) {
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeIdToBuffer(id);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word id error: %s", localData.error().message().c_str());
+			return;
+		}
+
+		if (performFrame(DictOpcode::DELETE, std::move(*localData)).has_value()) {
+			log::debug(TAG, "Receive frame %s success", DELETE_COMMAND);
+		}
+	}
+
+	auto SharedMemoryDictClient::performGetById(uint64_t id) -> Word {
+		boost::system::result<std::vector<std::byte>> localData = mBinaryParser.serializeIdToBuffer(id);
+
+		if (localData.has_error()) {
+			log::error(TAG, "Serialize word id error: %s", localData.error().message().c_str());
+			return {};
+		}
+
+		boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::GET_BY_ID, std::move(*localData));
+
+		if (remoteFrame.has_error()) {
+			return {};
+		}
+
+		boost::system::result<Word> remoteWord = mBinaryParser.deserializeFromBuffer(remoteFrame->payload);
+
+		if (remoteWord.has_value()) {
+			return *remoteWord;
+		} else {
+			log::error(TAG, "Deserialize word error: %s", remoteWord.error().message().c_str());
+			return {};
+		}
+	}
+
+	auto SharedMemoryDictClient::performGetAll() -> std::vector<Word> {
+		std::vector<Word> words;
+
+		/* whole dictionary may not fit into ring, so it is always collected from stream chunks */
+		boost::system::result<void> status = performGetAll([&words](std::vector<Word>&& chunk) {
+			words.insert(words.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+		});
+
+		if (status.has_error()) {
+			return {};
+		}
+
+		return words;
+	}
+
+	auto SharedMemoryDictClient::performGetAll(const std::function<void(std::vector<Word>&&)>& consumeWords) -> boost::system::result<void> {
+		boost::system::result<DictFrame> remoteFrame = performFrame(DictOpcode::GET_ALL_STREAM);
+
+		while (remoteFrame.has_value()) {
+			if (remoteFrame->header.flags & DICT_FRAME_FLAG_MORE) {
+				boost::system::result<std::vector<Word>> remoteWords = mBinaryParser.deserializeWordsFromBuffer(remoteFrame->payload);
+
+				if (remoteWords.has_error()) {
+					log::error(TAG, "Deserialize words error: %s", remoteWords.error().message().c_str());
+					return remoteWords.error();
+				}
+
+				consumeWords(std::move(*remoteWords));
+			} else {
+				log::debug(TAG, "Receive frame %s success", GET_ALL_STREAM_COMMAND);
+				return {};
+			}
+
+			remoteFrame = receiveFrame(DictOpcode::GET_ALL_STREAM, remoteFrame->header.requestId);
+		}
+
+		return remoteFrame.error();
+	}
+
+	bool SharedMemoryDictClient::performPing() {
+		return performFrame(DictOpcode::PING).has_value();
+	}
+
+	auto SharedMemoryDictClient::receiveRegion() -> boost::system::result<SharedMemoryRegion> {
+		int fd = -1;
+		char marker = 0;
+		iovec localData = { .iov_base = &marker, .iov_len = sizeof(marker) };
+
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fd))] = {};
+		msghdr message = {};
+		message.msg_iov = &localData;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+
+		const ssize_t size = ::recvmsg(mSocket.native_handle(), &message, MSG_CMSG_CLOEXEC);
+
+		if (size < 0) {
+			return boost::system::error_code(errno, boost::system::system_category());
+		}
+
+		const cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+
+		if (size == 0 || controlMessage == nullptr || controlMessage->cmsg_level != SOL_SOCKET || controlMessage->cmsg_type != SCM_RIGHTS) {
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		std::memcpy(&fd, CMSG_DATA(controlMessage), sizeof(fd));
+		return SharedMemoryRegion::attach(fd);
+	}
+
+	auto SharedMemoryDictClient::performFrame(DictOpcode opcode, std::vector<std::byte>&& payload) -> boost::system::result<DictFrame> {
+		if (!mStarted) {
+			return std::make_error_code(std::errc::not_connected);
+		}
+
+		const DictFrame localFrame = makeFrame(opcode, ++mLastRequestId, std::move(payload));
+		boost::system::result<void> status = mRequestRing->write(localFrame, FRAME_POLL_TIMEOUT);
+
+		while (status.has_error() && status.error() == std::errc::timed_out && !isPeerClosed(mSocket.native_handle())) {
+			status = mRequestRing->write(localFrame, FRAME_POLL_TIMEOUT);
+		}
+
+		if (status.has_error()) {
+			log::error(TAG, "Can't send frame %u: %s", localFrame.header.requestId, status.error().message().c_str());
+			if (status.error() != std::errc::message_size) {
+				mStarted = false;
+			}
+			return status.error();
+		}
+
+		return receiveFrame(opcode, localFrame.header.requestId);
+	}
+
+	auto SharedMemoryDictClient::receiveFrame(DictOpcode opcode, uint32_t requestId) -> boost::system::result<DictFrame> {
+		boost::system::result<DictFrame> remoteFrame = mResponseRing->read(FRAME_POLL_TIMEOUT);
+
+		while (remoteFrame.has_error() && remoteFrame.error() == std::errc::timed_out && !isPeerClosed(mSocket.native_handle())) {
+			remoteFrame = mResponseRing->read(FRAME_POLL_TIMEOUT);
+		}
+
+		if (remoteFrame.has_error()) {
+			log::error(TAG, "Receive frame isn't correct: %s", remoteFrame.error().message().c_str());
+			mStarted = false;
+			return remoteFrame.error();
+		}
+
+		if (remoteFrame->header.requestId != requestId || remoteFrame->header.opcode != opcode) {
+			log::error(TAG, "Receive frame %u doesn't match request %u", remoteFrame->header.requestId, requestId);
+			mStarted = false;
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		if (remoteFrame->header.status == DictStatus::FAILURE) {
+			const std::string message(reinterpret_cast<const char*>(remoteFrame->payload.data()), remoteFrame->payload.size());
+			log::error(TAG, "Server failed to process frame %u: %s", remoteFrame->header.requestId, message.c_str());
+			return std::make_error_code(std::errc::io_error);
+		}
+
+		return remoteFrame;
+	}
+}
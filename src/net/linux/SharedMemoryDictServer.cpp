@@ -0,0 +1,246 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/SharedMemoryDictServer.hpp"
+#include "net/DictRequestHandler.hpp"
+#include "net/NetworkUtils.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <bit>
+#include <cstring>
+
+#include <sys/socket.h>
+
+static constexpr const char* const TAG = "SharedMemoryDictServer";
+static constexpr std::chrono::milliseconds SESSION_POLL_TIMEOUT(100);
+
+namespace lynx {
+
+	SharedMemoryDictServer::SharedMemoryDictServer(const std::string& host, const std::string& socketPath, uint32_t ringCapacity)
+		: mSocketPath(socketPath)
+		, mRingCapacity(std::bit_ceil(ringCapacity))
+		, mAcceptor(mContext)
+		, mDictDao(host)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+	}
+
+	SharedMemoryDictServer::~SharedMemoryDictServer() {
+		stop();
+		log::info(TAG, "Destroy server");
+	}
+
+	bool SharedMemoryDictServer::isStarted() const { return mStarted; }
+
+	void SharedMemoryDictServer::start() {
+		log::info(TAG, "Start server on %s", mSocketPath.c_str());
+
+		boost::system::error_code errorCode;
+		const net::local::stream_protocol::endpoint endpoint = toLocalEndpoint(mSocketPath);
+
+		removeLocalSocket(mSocketPath);
+		mAcceptor.open(endpoint.protocol(), errorCode);
+
+		if (!errorCode) {
+			mAcceptor.bind(endpoint, errorCode);
+		}
+
+		if (!errorCode) {
+			mAcceptor.listen(net::socket_base::max_listen_connections, errorCode);
+		}
+
+		if (errorCode) {
+			log::error(TAG, "Can't listen on %s: %s", mSocketPath.c_str(), errorCode.message().c_str());
+			return;
+		}
+
+		mStarted = true;
+		mDictDao.start();
+
+		acceptClients();
+
+		for (std::thread& sessionThread : mSessionThreads) {
+			sessionThread.join();
+		}
+
+		mSessionThreads.clear();
+		mAcceptor.close(errorCode);
+		mDictDao.stop();
+	}
+
+	void SharedMemoryDictServer::stop() {
+		if (!mStarted.exchange(false)) {
+			return;
+		}
+
+		/* unlike close, shutdown wakes thread blocked in accept */
+		::shutdown(mAcceptor.native_handle(), SHUT_RDWR);
+		log::info(TAG, "Stop server");
+	}
+
+	void SharedMemoryDictServer::acceptClients() {
+		boost::system::error_code errorCode;
+
+		while (mStarted) {
+			net::local::stream_protocol::socket socket(mContext);
+			mAcceptor.accept(socket, errorCode);
+
+			if (errorCode) {
+				if (mStarted) {
+					log::error(TAG, "Can't accept client: %s", errorCode.message().c_str());
+				}
+				return;
+			}
+
+			boost::system::result<SharedMemoryRegion> region = openRegion();
+
+			if (region.has_error()) {
+				log::error(TAG, "Can't create shared memory: %s", region.error().message().c_str());
+				continue;
+			}
+
+			errorCode = sendRegion(socket, *region);
+
+			if (errorCode) {
+				log::error(TAG, "Can't pass shared memory to client: %s", errorCode.message().c_str());
+				continue;
+			}
+
+			log::debug(TAG, "Accept client %d", socket.native_handle());
+			mSessionThreads.emplace_back(&SharedMemoryDictServer::processSession, this, std::move(socket), std::move(*region));
+		}
+	}
+
+	auto SharedMemoryDictServer::openRegion() -> boost::system::result<SharedMemoryRegion> {
+		const std::size_t ringSize = SharedMemoryRing::getRequiredSize(mRingCapacity);
+		boost::system::result<SharedMemoryRegion> region = SharedMemoryRegion::create(2 * ringSize);
+
+		if (region.has_value()) {
+			SharedMemoryRing::initialize(region->getData(), mRingCapacity);
+			SharedMemoryRing::initialize(region->getData() + ringSize, mRingCapacity);
+		}
+
+		return region;
+	}
+
+	auto SharedMemoryDictServer::sendRegion(net::local::stream_protocol::socket& socket, const SharedMemoryRegion& region) -> boost::system::error_code {
+		const int fd = region.getFd();
+		char marker = 0;
+		iovec localData = { .iov_base = &marker, .iov_len = sizeof(marker) };
+
+		alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fd))] = {};
+		msghdr message = {};
+		message.msg_iov = &localData;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+
+		cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+		controlMessage->cmsg_level = SOL_SOCKET;
+		controlMessage->cmsg_type = SCM_RIGHTS;
+		controlMessage->cmsg_len = CMSG_LEN(sizeof(fd));
+		std::memcpy(CMSG_DATA(controlMessage), &fd, sizeof(fd));
+
+		if (::sendmsg(socket.native_handle(), &message, MSG_NOSIGNAL) < 0) {
+			return boost::system::error_code(errno, boost::system::system_category());
+		}
+
+		return {};
+	}
+
+	void SharedMemoryDictServer::processSession(net::local::stream_protocol::socket socket, SharedMemoryRegion region) {
+		SharedMemoryRing requestRing(region.getData(), mRingCapacity);
+		SharedMemoryRing responseRing(region.getData() + region.getSize() / 2, mRingCapacity);
+		DictRequestHandler handler(mDictDao, mDictDaoMutex);
+
+		while (mStarted) {
+			boost::system::result<DictFrame> request = requestRing.read(SESSION_POLL_TIMEOUT);
+
+			if (request.has_error()) {
+				if (request.error() == std::errc::timed_out && !isPeerClosed(socket.native_handle())) {
+					continue;
+				}
+
+				if (request.error() == std::errc::protocol_error) {
+					log::error(TAG, "Client %d corrupted request ring", socket.native_handle());
+				}
+
+				log::debug(TAG, "Client is gone: %s", request.error().message().c_str());
+				break;
+			}
+
+			/* ring blocks writer while client is behind, so stream has backpressure of its own */
+			if (request->header.opcode == DictOpcode::GET_ALL_STREAM) {
+				DictStreamCursor cursor{ .header = request->header };
+				bool sending = true;
+
+				while (sending && !cursor.finished) {
+					sending = sendFrame(responseRing, socket, handler.processStreamFrame(cursor));
+				}
+
+				if (!sending) {
+					break;
+				}
+				continue;
+			}
+
+			std::optional<DictFrame> reply = handler.processFrame(request->header, request->payload);
+
+			if (!reply.has_value()) {
+				log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+				break;
+			}
+
+			if (!sendFrame(responseRing, socket, *reply)) {
+				break;
+			}
+		}
+
+		log::debug(TAG, "Close client %d", socket.native_handle());
+	}
+
+	bool SharedMemoryDictServer::sendFrame(SharedMemoryRing& ring, const net::local::stream_protocol::socket& socket, const DictFrame& frame) {
+		while (mStarted) {
+			boost::system::result<void> status = ring.write(frame, SESSION_POLL_TIMEOUT);
+
+			if (status.has_value()) {
+				return true;
+			}
+
+			if (status.error() == std::errc::message_size) {
+				log::error(TAG, "Reply of %u bytes exceeds shared memory ring", frame.header.payloadSize);
+				return sendFrame(ring, socket, makeErrorFrame(frame.header.opcode, frame.header.requestId,
+						"Reply exceeds shared memory ring, use stream"));
+			}
+
+			if (status.error() != std::errc::timed_out || isPeerClosed(const_cast<net::local::stream_protocol::socket&>(socket).native_handle())) {
+				log::debug(TAG, "Client is gone: %s", status.error().message().c_str());
+				return false;
+			}
+		}
+
+		return false;
+	}
+}
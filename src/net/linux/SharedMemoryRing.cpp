@@ -0,0 +1,326 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/SharedMemoryRing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static constexpr uint32_t SPIN_COUNT = 256;
+
+namespace lynx {
+
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring counters are shared between processes");
+
+	static auto lastError() -> std::error_code {
+		return std::error_code(errno, std::system_category());
+	}
+
+	static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	/* std::atomic wait/notify use process private futexes, peer in other process wouldn't be woken */
+	static void waitFutex(std::atomic<uint32_t>& counter, uint32_t expected, std::chrono::nanoseconds timeout) {
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+		const timespec relativeTimeout = {
+			.tv_sec = static_cast<time_t>(seconds.count()),
+			.tv_nsec = static_cast<long>((timeout - seconds).count())
+		};
+
+		::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT, expected, &relativeTimeout, nullptr, 0);
+	}
+
+	static void wakeFutex(std::atomic<uint32_t>& counter) {
+		::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	auto SharedMemoryRegion::create(std::size_t size) -> boost::system::result<SharedMemoryRegion> {
+		const int fd = ::memfd_create("lynx_dict", MFD_CLOEXEC);
+
+		if (fd < 0) {
+			return lastError();
+		}
+
+		if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+			const std::error_code errorCode = lastError();
+			::close(fd);
+			return errorCode;
+		}
+
+		void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (data == MAP_FAILED) {
+			const std::error_code errorCode = lastError();
+			::close(fd);
+			return errorCode;
+		}
+
+		return SharedMemoryRegion(fd, static_cast<std::byte*>(data), size);
+	}
+
+	auto SharedMemoryRegion::attach(int fd) -> boost::system::result<SharedMemoryRegion> {
+		struct stat status = {};
+
+		if (::fstat(fd, &status) < 0) {
+			const std::error_code errorCode = lastError();
+			::close(fd);
+			return errorCode;
+		}
+
+		const auto size = static_cast<std::size_t>(status.st_size);
+		void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (data == MAP_FAILED) {
+			const std::error_code errorCode = lastError();
+			::close(fd);
+			return errorCode;
+		}
+
+		return SharedMemoryRegion(fd, static_cast<std::byte*>(data), size);
+	}
+
+	SharedMemoryRegion::SharedMemoryRegion(int fd, std::byte* data, std::size_t size)
+		: mFd(fd)
+		, mData(data)
+		, mSize(size) {
+	}
+
+	SharedMemoryRegion::SharedMemoryRegion(SharedMemoryRegion&& other) noexcept
+		: mFd(std::exchange(other.mFd, -1))
+		, mData(std::exchange(other.mData, nullptr))
+		, mSize(std::exchange(other.mSize, 0)) {
+	}
+
+	SharedMemoryRegion& SharedMemoryRegion::operator=(SharedMemoryRegion&& other) noexcept {
+		if (this != &other) {
+			std::swap(mFd, other.mFd);
+			std::swap(mData, other.mData);
+			std::swap(mSize, other.mSize);
+		}
+
+		return *this;
+	}
+
+	SharedMemoryRegion::~SharedMemoryRegion() {
+		if (mData != nullptr) {
+			::munmap(mData, mSize);
+		}
+
+		if (mFd >= 0) {
+			::close(mFd);
+		}
+	}
+
+	auto SharedMemoryRegion::getFd() const -> int { return mFd; }
+
+	auto SharedMemoryRegion::getData() const -> std::byte* { return mData; }
+
+	auto SharedMemoryRegion::getSize() const -> std::size_t { return mSize; }
+
+	/* counters of both sides live on own cache lines, so producer and consumer don't invalidate each other */
+	struct SharedMemoryRing::Header final {
+		alignas(64) std::atomic<uint32_t> head;
+		std::atomic<uint32_t> headWaiterCount;
+		alignas(64) std::atomic<uint32_t> tail;
+		std::atomic<uint32_t> tailWaiterCount;
+		alignas(64) uint32_t capacity;
+	};
+
+	auto SharedMemoryRing::getRequiredSize(uint32_t capacity) -> std::size_t {
+		return sizeof(Header) + capacity;
+	}
+
+	void SharedMemoryRing::initialize(std::byte* memory, uint32_t capacity) {
+		Header* header = new (memory) Header();
+		header->capacity = capacity;
+	}
+
+	auto SharedMemoryRing::getCapacityFor(std::size_t size) -> uint32_t {
+		if (size <= sizeof(Header) || size - sizeof(Header) > UINT32_MAX) {
+			return 0;
+		}
+
+		const auto capacity = static_cast<uint32_t>(size - sizeof(Header));
+		return std::has_single_bit(capacity) && capacity > DICT_FRAME_HEADER_SIZE ? capacity : 0;
+	}
+
+	SharedMemoryRing::SharedMemoryRing(std::byte* memory, uint32_t capacity)
+		: mHeader(std::launder(reinterpret_cast<Header*>(memory)))
+		, mData(memory + sizeof(Header))
+		, mCapacity(capacity)
+		, mMask(capacity - 1) {
+	}
+
+	auto SharedMemoryRing::getCapacity() const -> uint32_t { return mCapacity; }
+
+	auto SharedMemoryRing::write(const DictFrame& frame, std::chrono::milliseconds timeout) -> boost::system::result<void> {
+		if (frame.payload.size() > mCapacity - DICT_FRAME_HEADER_SIZE) {
+			return std::make_error_code(std::errc::message_size);
+		}
+
+		const auto frameSize = static_cast<uint32_t>(DICT_FRAME_HEADER_SIZE + frame.payload.size());
+		const uint32_t tail = mHeader->tail.load(std::memory_order_relaxed);
+
+		/* counters beyond capacity apart end waiting too, they are rejected below */
+		const auto hasSpace = [this, tail, frameSize]() {
+			const uint32_t used = tail - mHeader->head.load(std::memory_order_acquire);
+			return used > mCapacity || mCapacity - used >= frameSize;
+		};
+
+		if (boost::system::result<void> status = waitUntil(mHeader->head, mHeader->headWaiterCount, hasSpace, timeout); status.has_error()) {
+			return status.error();
+		}
+
+		if (tail - mHeader->head.load(std::memory_order_acquire) > mCapacity) {
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		copyIn(tail, encodeFrameHeader(frame.header));
+		copyIn(tail + DICT_FRAME_HEADER_SIZE, frame.payload);
+
+		mHeader->tail.store(tail + frameSize, std::memory_order_seq_cst);
+		wakeUp(mHeader->tail, mHeader->tailWaiterCount);
+
+		return {};
+	}
+
+	auto SharedMemoryRing::read(std::chrono::milliseconds timeout) -> boost::system::result<DictFrame> {
+		const uint32_t head = mHeader->head.load(std::memory_order_relaxed);
+
+		const auto hasFrame = [this, head]() {
+			return mHeader->tail.load(std::memory_order_acquire) != head;
+		};
+
+		if (boost::system::result<void> status = waitUntil(mHeader->tail, mHeader->tailWaiterCount, hasFrame, timeout); status.has_error()) {
+			return status.error();
+		}
+
+		/* writer publishes whole frame at once, so payload is there as soon as header is */
+		const uint32_t available = mHeader->tail.load(std::memory_order_acquire) - head;
+
+		if (available > mCapacity || available < DICT_FRAME_HEADER_SIZE) {
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		std::array<std::byte, DICT_FRAME_HEADER_SIZE> remoteHeader;
+		copyOut(head, remoteHeader);
+
+		boost::system::result<DictFrameHeader> header = decodeFrameHeader(remoteHeader);
+
+		if (header.has_error()) {
+			return header.error();
+		}
+
+		if (header->payloadSize > available - DICT_FRAME_HEADER_SIZE || header->payloadSize > DICT_FRAME_MAX_PAYLOAD_SIZE) {
+			return std::make_error_code(std::errc::protocol_error);
+		}
+
+		DictFrame frame = { .header = *header, .payload = std::vector<std::byte>(header->payloadSize) };
+		copyOut(head + DICT_FRAME_HEADER_SIZE, frame.payload);
+
+		mHeader->head.store(head + DICT_FRAME_HEADER_SIZE + header->payloadSize, std::memory_order_seq_cst);
+		wakeUp(mHeader->head, mHeader->headWaiterCount);
+
+		return frame;
+	}
+
+	/* on single cpu peer can't make progress while we spin, so go to futex at once */
+	static auto getSpinCount() -> uint32_t {
+		static const uint32_t spinCount = std::thread::hardware_concurrency() > 1 ? SPIN_COUNT : 0;
+		return spinCount;
+	}
+
+	template<typename Ready>
+	auto SharedMemoryRing::waitUntil(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& waiterCount,
+									 Ready&& ready, std::chrono::milliseconds timeout) -> boost::system::result<void> {
+		for (uint32_t i = 0, spinCount = getSpinCount(); i < spinCount; ++i) {
+			if (ready()) {
+				return {};
+			}
+			relax();
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+		while (!ready()) {
+			const auto now = std::chrono::steady_clock::now();
+
+			if (now >= deadline) {
+				return std::make_error_code(std::errc::timed_out);
+			}
+
+			/* peer checks waiter count after it moves counter, so either it wakes us or we see its update */
+			const uint32_t observed = counter.load(std::memory_order_seq_cst);
+			waiterCount.fetch_add(1, std::memory_order_seq_cst);
+
+			if (!ready()) {
+				waitFutex(counter, observed, deadline - now);
+			}
+
+			waiterCount.fetch_sub(1, std::memory_order_seq_cst);
+		}
+
+		return {};
+	}
+
+	void SharedMemoryRing::wakeUp(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& waiterCount) {
+		if (waiterCount.load(std::memory_order_seq_cst) > 0) {
+			wakeFutex(counter);
+		}
+	}
+
+	void SharedMemoryRing::copyIn(uint32_t position, std::span<const std::byte> data) {
+		const uint32_t offset = position & mMask;
+		const std::size_t firstSize = std::min<std::size_t>(data.size(), mCapacity - offset);
+
+		std::memcpy(mData + offset, data.data(), firstSize);
+		std::memcpy(mData, data.data() + firstSize, data.size() - firstSize);
+	}
+
+	void SharedMemoryRing::copyOut(uint32_t position, std::span<std::byte> data) const {
+		const uint32_t offset = position & mMask;
+		const std::size_t firstSize = std::min<std::size_t>(data.size(), mCapacity - offset);
+
+		std::memcpy(data.data(), mData + offset, firstSize);
+		std::memcpy(data.data() + firstSize, mData, data.size() - firstSize);
+	}
+}
@@ -0,0 +1,655 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "net/linux/UringDictServer.hpp"
+#include "net/DictRequestHandler.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <optional>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static constexpr const char* const TAG = "UringDictServer";
+static constexpr uint32_t RING_ENTRY_COUNT = 256;
+static constexpr uint16_t BUFFER_GROUP_ID = 0;
+static constexpr uint16_t BUFFER_COUNT = 256;
+static constexpr uint32_t BUFFER_SIZE = 16 * 1024;
+
+namespace lynx {
+
+	enum class RequestKind : uint8_t {
+		ACCEPT,
+		WAKEUP,
+		RECEIVE,
+		SEND,
+		CANCEL
+	};
+
+	static auto lastError() -> std::error_code {
+		return std::error_code(errno, std::system_category());
+	}
+
+	static auto toError(int result) -> std::error_code {
+		return std::error_code(-result, std::system_category());
+	}
+
+	static auto encodeRequest(RequestKind kind, int fd) -> uint64_t {
+		return (static_cast<uint64_t>(kind) << 32) | static_cast<uint32_t>(fd);
+	}
+
+	struct UringDictServer::Connection final {
+		Connection(int socketFd, SyncDictDao& dictDao, std::mutex& dictDaoMutex)
+			: socketFd(socketFd)
+			, handler(dictDao, dictDaoMutex)
+			, protocol(DictProtocol::TEXT)
+			, sendOffset(0)
+			, receiving(false)
+			, sending(false)
+			, cancelling(false)
+			, closing(false) {
+		}
+
+		~Connection() {
+			::close(socketFd);
+		}
+
+		[[nodiscard]] bool isOutputFull() const {
+			const std::size_t sendingSize = sendBuffer.empty() ? 0 : sendBuffer.size() - sendOffset;
+			return output.size() + sendingSize >= DICT_OUTPUT_HIGH_WATER_MARK;
+		}
+
+		int socketFd;
+		DictRequestHandler handler;
+		DictProtocol protocol;
+
+		std::string input;
+		/* replies gather in output while kernel owns sendBuffer, they are swapped on completion */
+		std::string output;
+		std::string sendBuffer;
+		std::size_t sendOffset;
+		/* stream in progress, frames after it wait in input until it ends */
+		std::optional<DictStreamCursor> stream;
+
+		bool receiving;
+		bool sending;
+		bool cancelling;
+		bool closing;
+	};
+
+	struct UringDictServer::EventLoop final {
+		~EventLoop() {
+			for (int fd : {listenFd, wakeupFd}) {
+				if (fd >= 0) {
+					::close(fd);
+				}
+			}
+		}
+
+		int listenFd = -1;
+		int wakeupFd = -1;
+		uint64_t wakeupValue = 0;
+		std::unordered_map<int, std::unique_ptr<Connection>> connections;
+		/* declared last, so ring is closed before buffers of connections are freed */
+		IoUring ring;
+	};
+
+	UringDictServer::UringDictServer(const std::string& host, uint16_t port, uint32_t threadCount)
+		: mPort(port)
+		, mThreadCount(std::max(threadCount, 1u))
+		, mDictDao(host)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+
+		if (!isSupported()) {
+			log::info(TAG, "Kernel lacks multishot receive or buffer rings, fall back to epoll");
+			mFallbackServer = std::make_unique<EpollDictServer>(host, port, threadCount);
+		}
+	}
+
+	UringDictServer::~UringDictServer() {
+		stop();
+		log::info(TAG, "Destroy server");
+	}
+
+	bool UringDictServer::isStarted() const {
+		return mFallbackServer ? mFallbackServer->isStarted() : mStarted.load();
+	}
+
+	bool UringDictServer::isFallback() const { return mFallbackServer != nullptr; }
+
+	bool UringDictServer::isSupported() {
+		IoUring ring;
+
+		if (ring.open(8).has_error()) {
+			return false;
+		}
+
+		/* multishot receive arrived in 6.0 together with zero copy send, it has no opcode of its own to probe */
+		if (!ring.isSupported(IORING_OP_ACCEPT) || !ring.isSupported(IORING_OP_RECV) || !ring.isSupported(IORING_OP_SEND_ZC)) {
+			return false;
+		}
+
+		return ring.registerBuffers(BUFFER_GROUP_ID, 1, BUFFER_SIZE).has_value();
+	}
+
+	void UringDictServer::start() {
+		if (mFallbackServer) {
+			mFallbackServer->start();
+			return;
+		}
+
+		log::info(TAG, "Start server with %u rings", mThreadCount);
+
+		mDictDao.start();
+
+		{
+			std::lock_guard<std::mutex> lock(mLoopsMutex);
+
+			for (uint32_t i = 0; i < mThreadCount; ++i) {
+				boost::system::result<std::unique_ptr<EventLoop>> loop = openLoop();
+
+				if (loop.has_error()) {
+					log::error(TAG, "Can't open event loop on port %u: %s", mPort, loop.error().message().c_str());
+					mLoops.clear();
+					return;
+				}
+
+				mLoops.push_back(std::move(*loop));
+			}
+
+			mStarted = true;
+		}
+
+		for (uint32_t i = 1; i < mThreadCount; ++i) {
+			mThreads.emplace_back(&UringDictServer::runLoop, this, std::ref(*mLoops[i]));
+		}
+		runLoop(*mLoops[0]);
+
+		for (std::thread& thread : mThreads) {
+			thread.join();
+		}
+
+		std::lock_guard<std::mutex> lock(mLoopsMutex);
+		mThreads.clear();
+		mLoops.clear();
+	}
+
+	void UringDictServer::stop() {
+		if (mFallbackServer) {
+			mFallbackServer->stop();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mLoopsMutex);
+
+			if (!mStarted.exchange(false)) {
+				return;
+			}
+
+			/* completes pending read of every ring, loops see mStarted and return */
+			for (const std::unique_ptr<EventLoop>& loop : mLoops) {
+				const uint64_t value = 1;
+
+				if (::write(loop->wakeupFd, &value, sizeof(value)) < 0) {
+					log::error(TAG, "Can't wake up event loop: %s", lastError().message().c_str());
+				}
+			}
+		}
+
+		mDictDao.stop();
+		log::info(TAG, "Stop server");
+	}
+
+	auto UringDictServer::openLoop() -> boost::system::result<std::unique_ptr<EventLoop>> {
+		auto loop = std::make_unique<EventLoop>();
+		const int enable = 1;
+
+		loop->wakeupFd = ::eventfd(0, EFD_CLOEXEC);
+		loop->listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+		if (loop->wakeupFd < 0 || loop->listenFd < 0) {
+			return lastError();
+		}
+
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(mPort);
+		address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+		if (::setsockopt(loop->listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0
+				|| ::setsockopt(loop->listenFd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0
+				|| ::bind(loop->listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+				|| ::listen(loop->listenFd, SOMAXCONN) < 0) {
+			return lastError();
+		}
+
+		if (boost::system::result<void> result = loop->ring.open(RING_ENTRY_COUNT); result.has_error()) {
+			return result.error();
+		}
+
+		if (boost::system::result<void> result = loop->ring.registerBuffers(BUFFER_GROUP_ID, BUFFER_COUNT, BUFFER_SIZE); result.has_error()) {
+			return result.error();
+		}
+
+		return loop;
+	}
+
+	void UringDictServer::runLoop(EventLoop& loop) {
+		prepareAccept(loop);
+		prepareWakeup(loop);
+
+		while (mStarted) {
+			/* sends prepared while handling previous completions go out in the same syscall */
+			boost::system::result<uint32_t> result = loop.ring.submit(1);
+
+			if (result.has_error()) {
+				if (result.error() == std::errc::interrupted) {
+					continue;
+				}
+
+				log::error(TAG, "Can't submit requests: %s", result.error().message().c_str());
+				break;
+			}
+
+			loop.ring.consume([this, &loop](const io_uring_cqe& cqe) {
+				processCompletion(loop, cqe);
+			});
+		}
+
+		closeLoop(loop);
+	}
+
+	void UringDictServer::closeLoop(EventLoop& loop) {
+		/* kernel may still write into connection buffers, so they are released only after their requests complete */
+		for (auto& [socketFd, connection] : loop.connections) {
+			closeClient(*connection);
+		}
+
+		std::erase_if(loop.connections, [](const auto& connection) {
+			return !connection.second->receiving && !connection.second->sending;
+		});
+
+		while (!loop.connections.empty()) {
+			if (boost::system::result<uint32_t> result = loop.ring.submit(1); result.has_error() && result.error() != std::errc::interrupted) {
+				log::error(TAG, "Can't complete requests: %s", result.error().message().c_str());
+				break;
+			}
+
+			loop.ring.consume([this, &loop](const io_uring_cqe& cqe) {
+				processCompletion(loop, cqe);
+			});
+		}
+	}
+
+	void UringDictServer::processCompletion(EventLoop& loop, const io_uring_cqe& cqe) {
+		switch (static_cast<RequestKind>(cqe.user_data >> 32)) {
+		case RequestKind::ACCEPT:
+			acceptClient(loop, cqe);
+			break;
+		case RequestKind::WAKEUP:
+			if (mStarted) {
+				prepareWakeup(loop);
+			}
+			break;
+		case RequestKind::RECEIVE:
+			receiveData(loop, cqe);
+			break;
+		case RequestKind::SEND:
+			sendData(loop, cqe);
+			break;
+		case RequestKind::CANCEL:
+			/* receive reports its own end, cancel of finished one fails harmlessly */
+			break;
+		}
+	}
+
+	void UringDictServer::acceptClient(EventLoop& loop, const io_uring_cqe& cqe) {
+		const int enable = 1;
+
+		if ((cqe.flags & IORING_CQE_F_MORE) == 0 && mStarted) {
+			prepareAccept(loop);
+		}
+
+		if (cqe.res < 0) {
+			log::error(TAG, "Can't accept client: %s", toError(cqe.res).message().c_str());
+			return;
+		}
+
+		const int socketFd = cqe.res;
+
+		if (!mStarted) {
+			::close(socketFd);
+			return;
+		}
+
+		::setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+		auto connection = std::make_unique<Connection>(socketFd, mDictDao, mDictDaoMutex);
+		prepareReceive(loop, *connection);
+
+		log::debug(TAG, "Accept client %d", socketFd);
+		loop.connections.emplace(socketFd, std::move(connection));
+	}
+
+	void UringDictServer::receiveData(EventLoop& loop, const io_uring_cqe& cqe) {
+		auto found = loop.connections.find(static_cast<int>(cqe.user_data & UINT32_MAX));
+
+		if (found == loop.connections.end()) {
+			return;
+		}
+
+		Connection& connection = *found->second;
+
+		if (cqe.res > 0) {
+			const auto bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+			const std::span<const char> remoteBuffer = loop.ring.getBuffer(bufferId, cqe.res);
+
+			const bool processed = connection.closing || processData(connection, std::string_view(remoteBuffer.data(), remoteBuffer.size()));
+			loop.ring.recycleBuffer(bufferId);
+
+			if (processed) {
+				prepareSend(loop, connection);
+			} else {
+				closeClient(connection);
+			}
+
+			/* client which doesn't read replies isn't read either, rest of its data waits in socket */
+			if (!connection.closing && connection.receiving && !connection.cancelling && connection.isOutputFull()) {
+				prepareCancel(loop, connection);
+			}
+		} else if (cqe.res == 0) {
+			log::debug(TAG, "Client closed connection");
+			closeClient(connection);
+		} else if (cqe.res != -ENOBUFS && cqe.res != -ECANCELED) {
+			/* running out of buffers or cancel only ends multishot receive, it is rearmed below or once output drains */
+			log::error(TAG, "Receive data isn't correct: %s", toError(cqe.res).message().c_str());
+			closeClient(connection);
+		}
+
+		if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+			connection.receiving = false;
+			connection.cancelling = false;
+
+			if (!connection.closing && !connection.isOutputFull()) {
+				prepareReceive(loop, connection);
+			}
+		}
+
+		releaseClient(loop, connection);
+	}
+
+	void UringDictServer::sendData(EventLoop& loop, const io_uring_cqe& cqe) {
+		auto found = loop.connections.find(static_cast<int>(cqe.user_data & UINT32_MAX));
+
+		if (found == loop.connections.end()) {
+			return;
+		}
+
+		Connection& connection = *found->second;
+		connection.sending = false;
+
+		if (cqe.res < 0) {
+			log::error(TAG, "Can't send reply: %s", toError(cqe.res).message().c_str());
+			connection.sendBuffer.clear();
+			connection.output.clear();
+			closeClient(connection);
+		} else {
+			connection.sendOffset += cqe.res;
+
+			if (connection.sendOffset == connection.sendBuffer.size()) {
+				connection.sendBuffer.clear();
+			}
+
+			/* drained output lets parked input and stream go on, receive is rearmed once they leave room */
+			if (!connection.closing && !connection.isOutputFull()) {
+				if (!processData(connection, {})) {
+					closeClient(connection);
+				} else if (!connection.receiving && !connection.isOutputFull()) {
+					prepareReceive(loop, connection);
+				}
+			}
+
+			prepareSend(loop, connection);
+		}
+
+		releaseClient(loop, connection);
+	}
+
+	void UringDictServer::prepareAccept(EventLoop& loop) {
+		io_uring_sqe* sqe = loop.ring.prepare();
+		sqe->opcode = IORING_OP_ACCEPT;
+		sqe->fd = loop.listenFd;
+		sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+		sqe->accept_flags = SOCK_CLOEXEC;
+		sqe->user_data = encodeRequest(RequestKind::ACCEPT, loop.listenFd);
+	}
+
+	void UringDictServer::prepareWakeup(EventLoop& loop) {
+		io_uring_sqe* sqe = loop.ring.prepare();
+		sqe->opcode = IORING_OP_READ;
+		sqe->fd = loop.wakeupFd;
+		sqe->addr = reinterpret_cast<uint64_t>(&loop.wakeupValue);
+		sqe->len = sizeof(loop.wakeupValue);
+		sqe->user_data = encodeRequest(RequestKind::WAKEUP, loop.wakeupFd);
+	}
+
+	void UringDictServer::prepareReceive(EventLoop& loop, Connection& connection) {
+		io_uring_sqe* sqe = loop.ring.prepare();
+		sqe->opcode = IORING_OP_RECV;
+		sqe->fd = connection.socketFd;
+		sqe->ioprio = IORING_RECV_MULTISHOT;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = BUFFER_GROUP_ID;
+		sqe->user_data = encodeRequest(RequestKind::RECEIVE, connection.socketFd);
+
+		connection.receiving = true;
+	}
+
+	void UringDictServer::prepareSend(EventLoop& loop, Connection& connection) {
+		if (connection.sending) {
+			return;
+		}
+
+		if (connection.sendBuffer.empty()) {
+			if (connection.output.empty()) {
+				/* reply to QUIT is flushed, shutdown completes pending receive */
+				if (connection.closing) {
+					::shutdown(connection.socketFd, SHUT_RDWR);
+				}
+				return;
+			}
+
+			std::swap(connection.sendBuffer, connection.output);
+			connection.sendOffset = 0;
+		}
+
+		io_uring_sqe* sqe = loop.ring.prepare();
+		sqe->opcode = IORING_OP_SEND;
+		sqe->fd = connection.socketFd;
+		sqe->addr = reinterpret_cast<uint64_t>(connection.sendBuffer.data() + connection.sendOffset);
+		sqe->len = static_cast<uint32_t>(connection.sendBuffer.size() - connection.sendOffset);
+		sqe->msg_flags = MSG_NOSIGNAL;
+		sqe->user_data = encodeRequest(RequestKind::SEND, connection.socketFd);
+
+		connection.sending = true;
+	}
+
+	void UringDictServer::prepareCancel(EventLoop& loop, Connection& connection) {
+		io_uring_sqe* sqe = loop.ring.prepare();
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = encodeRequest(RequestKind::RECEIVE, connection.socketFd);
+		sqe->user_data = encodeRequest(RequestKind::CANCEL, connection.socketFd);
+
+		connection.cancelling = true;
+	}
+
+	void UringDictServer::closeClient(Connection& connection) {
+		log::debug(TAG, "Close client %d", connection.socketFd);
+
+		connection.closing = true;
+		connection.output.clear();
+		::shutdown(connection.socketFd, SHUT_RDWR);
+	}
+
+	void UringDictServer::releaseClient(EventLoop& loop, Connection& connection) {
+		if (connection.closing && !connection.receiving && !connection.sending) {
+			loop.connections.erase(connection.socketFd);
+		}
+	}
+
+	bool UringDictServer::processData(Connection& connection, std::string_view remoteData) {
+		const auto processInput = [this, &connection](std::string_view data) -> boost::system::result<std::size_t> {
+			std::size_t offset = 0;
+
+			if (connection.protocol == DictProtocol::TEXT) {
+				offset += processMessages(connection, data);
+			}
+
+			if (connection.protocol == DictProtocol::BINARY) {
+				boost::system::result<std::size_t> frameSize = processFrames(connection, data.substr(offset));
+
+				if (frameSize.has_error()) {
+					return frameSize.error();
+				}
+
+				offset += *frameSize;
+			}
+
+			return offset;
+		};
+
+		/* complete requests are processed straight from provided buffer, only remainder is copied */
+		if (connection.input.empty()) {
+			boost::system::result<std::size_t> offset = processInput(remoteData);
+
+			if (offset.has_error()) {
+				log::error(TAG, "Process data error: %s", offset.error().message().c_str());
+				return false;
+			}
+
+			connection.input.append(remoteData.substr(*offset));
+			return true;
+		}
+
+		connection.input.append(remoteData);
+		boost::system::result<std::size_t> offset = processInput(connection.input);
+
+		if (offset.has_error()) {
+			log::error(TAG, "Process data error: %s", offset.error().message().c_str());
+			return false;
+		}
+
+		connection.input.erase(0, *offset);
+		return true;
+	}
+
+	auto UringDictServer::processMessages(Connection& connection, std::string_view remoteData) -> std::size_t {
+		std::size_t offset = 0;
+		std::size_t delimiter = 0;
+
+		while (!connection.closing && !connection.isOutputFull()
+				&& (delimiter = remoteData.find('\n', offset)) != std::string_view::npos) {
+			const std::string_view message = remoteData.substr(offset, delimiter - offset + 1);
+			offset = delimiter + 1;
+
+			if (message.starts_with(PROTOCOL_V2_COMMAND)) {
+				log::debug(TAG, "Switch connection to %s", PROTOCOL_V2_COMMAND);
+				connection.output.append(PROTOCOL_V2_COMMAND).append(" processed success\n");
+				connection.protocol = DictProtocol::BINARY;
+				break;
+			}
+
+			if (!connection.handler.processMessage(message, connection.output)) {
+				log::debug(TAG, "Process %s message", QUIT_COMMAND);
+				connection.closing = true;
+			}
+		}
+
+		return offset;
+	}
+
+	auto UringDictServer::processFrames(Connection& connection, std::string_view remoteData) -> boost::system::result<std::size_t> {
+		std::size_t offset = 0;
+
+		processStream(connection);
+
+		/* frames are parsed only while no stream runs and output is below high water mark */
+		while (!connection.closing && !connection.stream.has_value() && !connection.isOutputFull()
+				&& remoteData.size() - offset >= DICT_FRAME_HEADER_SIZE) {
+			boost::system::result<DictFrameHeader> header = decodeFrameHeader(
+					std::as_bytes(std::span(remoteData.data() + offset, DICT_FRAME_HEADER_SIZE)));
+
+			if (header.has_error()) {
+				return header.error();
+			}
+
+			if (remoteData.size() - offset < DICT_FRAME_HEADER_SIZE + header->payloadSize) {
+				break;
+			}
+
+			const auto payload = std::as_bytes(std::span(remoteData.data() + offset + DICT_FRAME_HEADER_SIZE, header->payloadSize));
+			offset += DICT_FRAME_HEADER_SIZE + header->payloadSize;
+
+			/* loop can't block for backpressure, so chunks of stream are read as sends drain output */
+			if (header->opcode == DictOpcode::GET_ALL_STREAM) {
+				connection.stream = DictStreamCursor{ .header = *header };
+				processStream(connection);
+				continue;
+			}
+
+			std::optional<DictFrame> localFrame = connection.handler.processFrame(*header, payload);
+
+			if (!localFrame.has_value()) {
+				log::debug(TAG, "Process %s frame", QUIT_COMMAND);
+				connection.closing = true;
+				break;
+			}
+
+			appendFrame(connection.output, *localFrame);
+		}
+
+		return offset;
+	}
+
+	void UringDictServer::processStream(Connection& connection) {
+		while (connection.stream.has_value() && !connection.isOutputFull()) {
+			appendFrame(connection.output, connection.handler.processStreamFrame(*connection.stream));
+
+			if (connection.stream->finished) {
+				connection.stream.reset();
+			}
+		}
+	}
+}
@@ -24,6 +24,7 @@
 
 #include "rpc/SyncRpcDictClient.hpp"
 #include "logging/Logging.hpp"
+#include "net/NetworkUtils.hpp"
 
 #include <grpc/grpc.h>
 #include <grpcpp/grpcpp.h>
@@ -45,6 +46,14 @@ namespace lynx {
 		log::info(TAG, "Create client");
 	}
 
+	SyncRpcDictClient::SyncRpcDictClient(const std::string& socketPath)
+		: mPort(0)
+		, mSocketPath(socketPath)
+		, mService(nullptr)
+		, mStarted(false) {
+		log::info(TAG, "Create client");
+	}
+
 	SyncRpcDictClient::~SyncRpcDictClient() {
 		mStarted = false;
 		log::info(TAG, "Destroy client");
@@ -55,7 +64,7 @@ namespace lynx {
 	void SyncRpcDictClient::start() {
 		log::info(TAG, "Start client");
 
-		const std::string clientAddress = mHost + ":" + std::to_string(mPort);
+		const std::string clientAddress = mSocketPath.empty() ? mHost + ":" + std::to_string(mPort) : toLocalAddress(mSocketPath);
 		std::shared_ptr<grpc::Channel> channel = grpc::CreateChannel(clientAddress, grpc::InsecureChannelCredentials());
 
 		mService = rpc::RemoteDictService::NewStub(std::static_pointer_cast<grpc::ChannelInterface>(channel));
@@ -24,6 +24,7 @@
 
 #include "rpc/SyncRpcDictServer.hpp"
 #include "logging/Logging.hpp"
+#include "net/NetworkUtils.hpp"
 #include "common/DictCommand.hpp"
 
 #include <thread>
@@ -45,6 +46,16 @@ namespace lynx {
 		log::info(TAG, "Create server");
 	}
 
+	SyncRpcDictServer::SyncRpcDictServer(const std::string& host, const std::string& socketPath)
+		: mHost(host)
+		, mPort(0)
+		, mSocketPath(socketPath)
+		, mService(nullptr)
+		, mDictDao(host)
+		, mStarted(false) {
+		log::info(TAG, "Create server");
+	}
+
 	SyncRpcDictServer::~SyncRpcDictServer() {
 		mStarted = false;
 		log::info(TAG, "Destroy server");
@@ -57,7 +68,7 @@ namespace lynx {
 	void SyncRpcDictServer::start() {
 		log::info(TAG, "Start server");
 
-		const std::string serverAddress = mHost + ":" + std::to_string(mPort);
+		const std::string serverAddress = mSocketPath.empty() ? mHost + ":" + std::to_string(mPort) : toLocalAddress(mSocketPath);
 
 		grpc::ServerBuilder builder;
 		builder.AddListeningPort(serverAddress, grpc::InsecureServerCredentials());
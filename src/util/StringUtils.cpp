@@ -24,11 +24,38 @@
 
 #include "util/StringUtils.hpp"
 
+#include <cctype>
+
 namespace lynx {
 
 	bool contains(const std::string& input, const std::string& substring) {
         return input.find(substring) != std::string::npos;
     }
+
+	auto trim(std::string_view value) -> std::string_view {
+		while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+			value.remove_prefix(1);
+		}
+		while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+			value.remove_suffix(1);
+		}
+
+		return value;
+	}
+
+	bool equalsIgnoreCase(std::string_view left, std::string_view right) {
+		if (left.size() != right.size()) {
+			return false;
+		}
+
+		for (std::size_t i = 0; i < left.size(); ++i) {
+			if (std::tolower(static_cast<unsigned char>(left[i])) != std::tolower(static_cast<unsigned char>(right[i]))) {
+				return false;
+			}
+		}
+
+		return true;
+	}
 }
 
 
@@ -136,4 +136,66 @@ namespace lynx {
 		EXPECT_EQ(result->image.width, WORD_TEST1.image.width);
 		EXPECT_EQ(result->image.height, WORD_TEST1.image.height);
 	}
+
+    TEST_F(JsonParserTest, serializeWordsToTextTest)
+	{
+		boost::system::result<std::string> result = mParser.serializeWordsToText({ WORD_TEST1, WORD_TEST2 });
+
+		if (result.has_error()) {
+			log::error(TAG, "Serialize error: %s", result.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		boost::system::result<std::vector<Word>> words = mParser.deserializeWordsFromText(*result);
+
+		if (words.has_error()) {
+			log::error(TAG, "Deserialize error: %s", words.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		ASSERT_EQ(words->size(), 2u);
+		EXPECT_EQ(words->at(0), WORD_TEST1);
+		EXPECT_EQ(words->at(1), WORD_TEST2);
+	}
+
+    TEST_F(JsonParserTest, deserializeWordBatchFromTextTest)
+	{
+		boost::system::result<std::string> localData = mParser.serializeToText(WORD_TEST1);
+		ASSERT_TRUE(localData.has_value());
+
+		boost::system::result<std::vector<boost::system::result<Word>>> result =
+			mParser.deserializeWordBatchFromText("[" + *localData + R"(, {"name": 1}])");
+
+		if (result.has_error()) {
+			log::error(TAG, "Deserialize error: %s", result.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		ASSERT_EQ(result->size(), 2u);
+		ASSERT_TRUE(result->at(0).has_value());
+		EXPECT_EQ(*result->at(0), WORD_TEST1);
+		EXPECT_TRUE(result->at(1).has_error());
+		EXPECT_TRUE(mParser.deserializeWordBatchFromText(*localData).has_error());
+	}
+
+    TEST_F(JsonParserTest, serializeStatusesToTextTest)
+	{
+		const std::vector<WordStatus> statuses = { { 1, true, "" }, { 0, false, "Deserialize word error" } };
+		boost::system::result<std::string> result = mParser.serializeStatusesToText(statuses);
+
+		if (result.has_error()) {
+			log::error(TAG, "Serialize error: %s", result.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		boost::system::result<std::vector<WordStatus>> remoteStatuses = mParser.deserializeStatusesFromText(*result);
+		ASSERT_TRUE(remoteStatuses.has_value());
+		ASSERT_EQ(remoteStatuses->size(), statuses.size());
+
+		for (std::size_t i = 0; i < statuses.size(); ++i) {
+			EXPECT_EQ(remoteStatuses->at(i).id, statuses[i].id);
+			EXPECT_EQ(remoteStatuses->at(i).success, statuses[i].success);
+			EXPECT_EQ(remoteStatuses->at(i).message, statuses[i].message);
+		}
+	}
 }
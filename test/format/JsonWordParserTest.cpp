@@ -0,0 +1,155 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "format/JsonWordParser.hpp"
+#include "logging/Logging.hpp"
+#include "common/TestData.hpp"
+
+static constexpr const char* const TAG = "JsonWordParserTest";
+
+namespace lynx {
+
+	class JsonWordParserTest : public testing::Test {
+	public:
+		JsonWordParserTest() = default;
+		~JsonWordParserTest() override = default;
+
+	protected:
+		/* Every byte goes in separate piece, so tokens are split in all possible places */
+		auto parseByBytes(std::string_view input) -> boost::system::error_code {
+			for (char symbol : input) {
+				boost::system::error_code error = mParser.write(std::string_view(&symbol, 1));
+
+				if (error) return error;
+			}
+
+			return mParser.finish();
+		}
+
+	protected:
+		JsonWordParser mParser;
+	};
+
+	static const char* const WORD_JSON_TEST = R"xxx(
+		{
+			"id": 1,
+			"name": "katze",
+			"index": 1,
+			"type": 1,
+			"comment": { "skip": [1, 2, { "id": 5 }] },
+			"image": {
+				"id": 1,
+				"url": "http://example.org/w/api.php?title=katze",
+				"width": 32,
+				"height": 32
+			}
+		}
+	)xxx";
+
+	static const char* const WORDS_JSON_TEST = R"xxx(
+		[
+			{ "id": 1, "name": "katze", "index": 1, "type": 1,
+			  "image": { "id": 1, "url": "http://example.org/w/api.php?title=katze", "width": 32, "height": 32 } },
+			{ "id": 2, "name": "hunt", "index": 2, "type": 2,
+			  "image": { "id": 2, "url": "http://example.org/w/api.php?title=hunt", "width": 48, "height": 48 } },
+			{ "id": 3, "name": 3 },
+			"word"
+		]
+	)xxx";
+
+	TEST_F(JsonWordParserTest, parseWordTest)
+	{
+		boost::system::error_code error = parseByBytes(WORD_JSON_TEST);
+
+		if (error) {
+			log::error(TAG, "Parse error: %s", error.message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		std::vector<boost::system::result<Word>> words = mParser.releaseWords();
+
+		EXPECT_FALSE(mParser.isBatch());
+		ASSERT_EQ(words.size(), 1u);
+		ASSERT_TRUE(words[0].has_value());
+		EXPECT_EQ(words[0]->id, WORD_TEST1.id);
+		EXPECT_EQ(words[0]->name, WORD_TEST1.name);
+		EXPECT_EQ(words[0]->index, WORD_TEST1.index);
+		EXPECT_EQ(words[0]->type, WORD_TEST1.type);
+		EXPECT_EQ(words[0]->image.id, WORD_TEST1.image.id);
+		EXPECT_EQ(words[0]->image.url, WORD_TEST1.image.url);
+		EXPECT_EQ(words[0]->image.width, WORD_TEST1.image.width);
+		EXPECT_EQ(words[0]->image.height, WORD_TEST1.image.height);
+	}
+
+	TEST_F(JsonWordParserTest, parseWordsTest)
+	{
+		boost::system::error_code error = parseByBytes(WORDS_JSON_TEST);
+
+		if (error) {
+			log::error(TAG, "Parse error: %s", error.message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		std::vector<boost::system::result<Word>> words = mParser.releaseWords();
+
+		EXPECT_TRUE(mParser.isBatch());
+		ASSERT_EQ(words.size(), 4u);
+		ASSERT_TRUE(words[0].has_value());
+		ASSERT_TRUE(words[1].has_value());
+		EXPECT_EQ(*words[0], WORD_TEST1);
+		EXPECT_EQ(*words[1], WORD_TEST2);
+		EXPECT_TRUE(words[2].has_error());
+		EXPECT_TRUE(words[3].has_error());
+	}
+
+	TEST_F(JsonWordParserTest, parseInvalidTest)
+	{
+		EXPECT_FALSE(mParser.write(R"({ "id": 1, "name": )"));
+		EXPECT_TRUE(mParser.finish());
+
+		JsonWordParser scalarParser;
+		EXPECT_TRUE(scalarParser.write("42") || scalarParser.finish());
+
+		JsonWordParser rangeParser;
+		EXPECT_FALSE(rangeParser.write(R"({ "id": 1, "name": "katze", "index": 1, "type": 300,
+			"image": { "url": "http://example.org", "width": 32, "height": 32 } })"));
+		EXPECT_FALSE(rangeParser.finish());
+
+		std::vector<boost::system::result<Word>> words = rangeParser.releaseWords();
+		ASSERT_EQ(words.size(), 1u);
+		EXPECT_TRUE(words[0].has_error());
+
+		/* fits underlying type of WordType, yet names no enumerator */
+		JsonWordParser typeParser;
+		EXPECT_FALSE(typeParser.write(R"({ "id": 1, "name": "katze", "index": 1, "type": 200,
+			"image": { "url": "http://example.org", "width": 32, "height": 32 } })"));
+		EXPECT_FALSE(typeParser.finish());
+
+		words = typeParser.releaseWords();
+		ASSERT_EQ(words.size(), 1u);
+		EXPECT_TRUE(words[0].has_error());
+	}
+}
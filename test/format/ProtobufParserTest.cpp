@@ -161,4 +161,49 @@ namespace lynx {
 		EXPECT_EQ(result->image.width, WORD_TEST1.image.width);
 		EXPECT_EQ(result->image.height, WORD_TEST1.image.height);
 	}
+
+	TEST_F(ProtobufParserTest, concatenatedWordsBufferTest)
+	{
+		boost::system::result<std::vector<std::byte>> firstPage = mParser.serializeWordsToBuffer({ WORD_TEST1 });
+		boost::system::result<std::vector<std::byte>> secondPage = mParser.serializeWordsToBuffer({ WORD_TEST2 });
+		ASSERT_TRUE(firstPage.has_value());
+		ASSERT_TRUE(secondPage.has_value());
+
+		/* repeated field of concatenated messages is merged, so streamed pages read as one list */
+		std::vector<std::byte> buffer = *firstPage;
+		buffer.insert(buffer.end(), secondPage->begin(), secondPage->end());
+
+		boost::system::result<std::vector<Word>> result = mParser.deserializeWordsFromBuffer(buffer);
+
+		if (result.has_error()) {
+			log::error(TAG, "Deserialize error: %s", result.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		ASSERT_EQ(result->size(), 2u);
+		EXPECT_EQ(result->at(0).id, WORD_TEST1.id);
+		EXPECT_EQ(result->at(1).id, WORD_TEST2.id);
+		EXPECT_EQ(result->at(1).name, WORD_TEST2.name);
+	}
+
+	TEST_F(ProtobufParserTest, statusesBufferTest)
+	{
+		const std::vector<WordStatus> statuses = { { 1, true, "" }, { 0, false, "Deserialize word error" } };
+		boost::system::result<std::vector<std::byte>> buffer = mParser.serializeStatusesToBuffer(statuses);
+
+		if (buffer.has_error()) {
+			log::error(TAG, "Serialize error: %s", buffer.error().message().c_str());
+			EXPECT_TRUE(false);
+		}
+
+		boost::system::result<std::vector<WordStatus>> result = mParser.deserializeStatusesFromBuffer(*buffer);
+		ASSERT_TRUE(result.has_value());
+		ASSERT_EQ(result->size(), statuses.size());
+
+		for (std::size_t i = 0; i < statuses.size(); ++i) {
+			EXPECT_EQ(result->at(i).id, statuses[i].id);
+			EXPECT_EQ(result->at(i).success, statuses[i].success);
+			EXPECT_EQ(result->at(i).message, statuses[i].message);
+		}
+	}
 }
@@ -0,0 +1,108 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "http/AsyncHttpDictServer.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "AsyncHttpDictServerTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8013;
+static constexpr uint32_t THREAD_COUNT_TEST = 2;
+static constexpr std::size_t CONNECTION_COUNT_TEST = 200;
+
+/* Unknown route is answered without touching db */
+static constexpr const char* const TARGET_TEST = "/unknown";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	static auto getThreadCount() -> std::size_t {
+		const std::filesystem::directory_iterator tasks("/proc/self/task");
+		return std::distance(std::filesystem::begin(tasks), std::filesystem::end(tasks));
+	}
+
+	static auto performRequest(beast::tcp_stream& stream) -> http::status {
+		boost::system::error_code errorCode;
+
+		http::request<http::string_body> request{ http::verb::get, TARGET_TEST, 11 };
+		request.set(http::field::host, HOST_TEST);
+		request.keep_alive(true);
+
+		http::write(stream, request, errorCode);
+		EXPECT_FALSE(errorCode);
+
+		beast::flat_buffer buffer;
+		http::response<http::string_body> response;
+		http::read(stream, buffer, response, errorCode);
+		EXPECT_FALSE(errorCode);
+
+		return response.result();
+	}
+
+	TEST(AsyncHttpDictServerTest, keepAliveConnectionsTest)
+	{
+		AsyncHttpDictServer server(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST });
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+		EXPECT_TRUE(server.isStarted());
+
+		const std::size_t threadCount = getThreadCount();
+
+		net::io_context context;
+		std::vector<beast::tcp_stream> streams;
+		streams.reserve(CONNECTION_COUNT_TEST);
+
+		for (std::size_t i = 0; i < CONNECTION_COUNT_TEST; ++i) {
+			boost::system::error_code errorCode;
+			streams.emplace_back(context);
+			streams.back().connect(net::ip::tcp::endpoint(net::ip::address::from_string(HOST_TEST), PORT_TEST), errorCode);
+			ASSERT_FALSE(errorCode);
+		}
+
+		/* every connection is kept open and reused, while server keeps its thread count */
+		for (std::size_t round = 0; round < 2; ++round) {
+			for (beast::tcp_stream& stream : streams) {
+				EXPECT_EQ(performRequest(stream), http::status::not_found);
+			}
+		}
+
+		log::info(TAG, "Serve %zu keep-alive connections with %zu threads", streams.size(), getThreadCount());
+		EXPECT_EQ(getThreadCount(), threadCount);
+
+		streams.clear();
+		server.stop();
+		serverThread.join();
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "http/HttpCompression.hpp"
+
+namespace lynx {
+
+	static auto makeBody(std::size_t wordCount) -> std::string {
+		std::string body = "[";
+
+		for (std::size_t i = 0; i < wordCount; ++i) {
+			body += (i == 0 ? "" : ",");
+			body += R"({"id":)" + std::to_string(i) + R"(,"name":"katze","index":1,"type":1})";
+		}
+
+		return body + "]";
+	}
+
+	TEST(HttpCompressionTest, negotiatePrefersHigherQualityTest)
+	{
+		EXPECT_EQ(negotiateCoding(""), ContentCoding::IDENTITY);
+		EXPECT_EQ(negotiateCoding("gzip, deflate"), ContentCoding::GZIP);
+		EXPECT_EQ(negotiateCoding("deflate, gzip;q=0.5"), ContentCoding::DEFLATE);
+		EXPECT_EQ(negotiateCoding("GZIP;q=0"), ContentCoding::IDENTITY);
+		EXPECT_EQ(negotiateCoding("br, *;q=0.1"), ContentCoding::GZIP);
+		EXPECT_EQ(negotiateCoding("*, gzip;q=0"), ContentCoding::DEFLATE);
+		EXPECT_EQ(negotiateCoding("identity"), ContentCoding::IDENTITY);
+	}
+
+	TEST(HttpCompressionTest, compressRoundTripTest)
+	{
+		const std::string body = makeBody(1000);
+
+		for (ContentCoding coding : { ContentCoding::GZIP, ContentCoding::DEFLATE }) {
+			boost::system::result<std::string> compressed = compress(body, coding, 6);
+			ASSERT_TRUE(compressed.has_value());
+			EXPECT_LT(compressed->size(), body.size() / 4);
+
+			boost::system::result<std::string> decompressed = decompress(*compressed, coding, body.size());
+			ASSERT_TRUE(decompressed.has_value());
+			EXPECT_EQ(*decompressed, body);
+		}
+	}
+
+	TEST(HttpCompressionTest, streamedPiecesFormOneBodyTest)
+	{
+		const std::string piece = makeBody(100);
+		HttpCompressor compressor(ContentCoding::GZIP, 1);
+		std::string compressed;
+		std::string body;
+
+		for (int i = 0; i < 50; ++i) {
+			compressed += compressor.compress(piece);
+			body += piece;
+		}
+		compressed += compressor.finish();
+
+		boost::system::result<std::string> decompressed = decompress(compressed, ContentCoding::GZIP, body.size());
+		ASSERT_TRUE(decompressed.has_value());
+		EXPECT_EQ(*decompressed, body);
+	}
+
+	TEST(HttpCompressionTest, decompressRejectsCorruptInputTest)
+	{
+		EXPECT_TRUE(decompress("not compressed", ContentCoding::GZIP, 1024).has_error());
+		EXPECT_TRUE(decompress("not compressed", ContentCoding::DEFLATE, 1024).has_error());
+	}
+
+	TEST(HttpCompressionTest, decompressRejectsOversizedOutputTest)
+	{
+		/* repeated bytes shrink by about thousand times, so small body could fill memory of client */
+		const std::string body(1024 * 1024, 'x');
+
+		for (ContentCoding coding : { ContentCoding::GZIP, ContentCoding::DEFLATE, ContentCoding::IDENTITY }) {
+			boost::system::result<std::string> compressed = (coding == ContentCoding::IDENTITY) ? body : compress(body, coding, 9);
+			ASSERT_TRUE(compressed.has_value());
+
+			boost::system::result<std::string> decompressed = decompress(*compressed, coding, body.size() - 1);
+			ASSERT_TRUE(decompressed.has_error());
+			EXPECT_EQ(decompressed.error(), boost::system::errc::message_size);
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "http/HttpContentFormat.hpp"
+
+namespace lynx {
+
+	TEST(HttpContentFormatTest, negotiateKeepsJsonForBrowsersTest)
+	{
+		EXPECT_EQ(negotiateFormat(""), ContentFormat::JSON);
+		EXPECT_EQ(negotiateFormat("text/html,application/xhtml+xml,*/*;q=0.8"), ContentFormat::JSON);
+		EXPECT_EQ(negotiateFormat("application/x-protobuf"), ContentFormat::PROTOBUF);
+		EXPECT_EQ(negotiateFormat("application/json;q=0.5, application/x-protobuf"), ContentFormat::PROTOBUF);
+		EXPECT_EQ(negotiateFormat("application/json, application/x-protobuf;q=0.9"), ContentFormat::JSON);
+		EXPECT_EQ(negotiateFormat("*/*, application/x-protobuf;q=0"), ContentFormat::JSON);
+		EXPECT_STREQ(toMime(ContentFormat::PROTOBUF), "application/x-protobuf");
+	}
+
+	TEST(HttpContentFormatTest, parseFormatTest)
+	{
+		EXPECT_EQ(parseFormat("application/x-protobuf"), ContentFormat::PROTOBUF);
+		EXPECT_EQ(parseFormat("application/json; charset=utf-8"), ContentFormat::JSON);
+		EXPECT_EQ(parseFormat(" Application/JSON "), ContentFormat::JSON);
+		EXPECT_FALSE(parseFormat("text/plain").has_value());
+		EXPECT_FALSE(parseFormat("").has_value());
+	}
+
+	TEST(HttpContentFormatTest, parseQualityTest)
+	{
+		EXPECT_EQ(parseQuality(""), 1000u);
+		EXPECT_EQ(parseQuality("q=0.5"), 500u);
+		EXPECT_EQ(parseQuality(" q=0.125"), 125u);
+		EXPECT_EQ(parseQuality("q=0"), 0u);
+		EXPECT_EQ(parseQuality("q=1.0"), 1000u);
+	}
+}
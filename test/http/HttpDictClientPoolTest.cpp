@@ -0,0 +1,123 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "http/AsyncHttpDictServer.hpp"
+#include "http/HttpDictClientPool.hpp"
+#include "db/SyncDictDao.hpp"
+#include "logging/Logging.hpp"
+#include "common/TestData.hpp"
+
+static constexpr const char* const TAG = "HttpDictClientPoolTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8014;
+static constexpr uint32_t CLIENT_COUNT_TEST = 4;
+static constexpr uint32_t CALLER_COUNT_TEST = 16;
+static constexpr std::size_t REQUEST_COUNT_TEST = 50;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	/* Needs db server, words are inserted once and then read by every caller */
+	class HttpDictClientPoolTest : public testing::Test {
+	public:
+		HttpDictClientPoolTest()
+			: mServer(HOST_TEST, PORT_TEST, { .threadCount = 2 })
+			, mPool(HOST_TEST, PORT_TEST, { .clientCount = CLIENT_COUNT_TEST, .pipelineDepth = 8 }) {
+
+			SyncDictDao dao(HOST_TEST);
+			dao.start();
+			dao.truncateTables();
+			dao.stop();
+
+			mServerThread = std::thread([this]() {
+				mServer.start();
+			});
+
+			log::debug(TAG, "Wait while server is configured");
+			std::this_thread::sleep_for(500ms);
+
+			mPool.start();
+			mPool.performPost(WORD_TEST1);
+			mPool.performPost(WORD_TEST2);
+		}
+
+		~HttpDictClientPoolTest() {
+			mPool.stop();
+			mServer.stop();
+			mServerThread.join();
+		}
+
+	protected:
+		AsyncHttpDictServer mServer;
+		HttpDictClientPool mPool;
+		std::thread mServerThread;
+	};
+
+	TEST_F(HttpDictClientPoolTest, concurrentCallersTest)
+	{
+		std::atomic_size_t successCount = 0;
+		std::vector<std::thread> callerThreads;
+
+		for (uint32_t i = 0; i < CALLER_COUNT_TEST; ++i) {
+			callerThreads.emplace_back([this, &successCount]() {
+				for (std::size_t j = 0; j < REQUEST_COUNT_TEST; ++j) {
+					if (mPool.performGet(WORD_TEST1.id).name == WORD_TEST1.name) {
+						++successCount;
+					}
+				}
+			});
+		}
+
+		for (std::thread& callerThread : callerThreads) {
+			callerThread.join();
+		}
+
+		EXPECT_EQ(successCount, CALLER_COUNT_TEST * REQUEST_COUNT_TEST);
+	}
+
+	TEST_F(HttpDictClientPoolTest, pipelinedRequestsTest)
+	{
+		std::vector<uint64_t> ids;
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			ids.push_back(i % 2 == 0 ? WORD_TEST1.id : WORD_TEST2.id);
+		}
+
+		const std::vector<Word> words = mPool.performGet(ids);
+		ASSERT_EQ(words.size(), ids.size());
+
+		/* responses come back in order of requests */
+		for (std::size_t i = 0; i < words.size(); ++i) {
+			EXPECT_EQ(words[i].name, (i % 2 == 0) ? WORD_TEST1.name : WORD_TEST2.name);
+		}
+
+		EXPECT_TRUE(mPool.acquire()->isStarted());
+	}
+}
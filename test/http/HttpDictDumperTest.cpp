@@ -0,0 +1,207 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <boost/beast/core/buffers_to_string.hpp>
+
+#include "http/HttpDictDumper.hpp"
+#include "http/HttpDictRequestHandler.hpp"
+
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr const char* const DUMP_PATH_TEST = "/tmp/lynx_dump_test.ndjson";
+
+namespace lynx {
+
+	static constexpr uint64_t FILE_SIZE_TEST = 1000;
+
+	/* Handler reads dump file only, so dao is never started and file is written by test instead of dumper */
+	class HttpDictDumperTest : public testing::Test {
+	public:
+		HttpDictDumperTest()
+			: mDictDao(HOST_TEST)
+			, mHandler(mDictDao, mDictDaoMutex, {}, DumpOptions{ .path = DUMP_PATH_TEST }) {
+		}
+
+		~HttpDictDumperTest() override = default;
+
+	protected:
+		void SetUp() override {
+			std::ofstream stream(DUMP_PATH_TEST, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+			stream << std::string(FILE_SIZE_TEST, 'x');
+		}
+
+		void TearDown() override {
+			std::remove(DUMP_PATH_TEST);
+		}
+
+		static auto makeRequest(const std::string& range = "", const std::string& ifRange = "") -> http::request<http::string_body> {
+			http::request<http::string_body> request{http::verb::get, "/dump", 11};
+
+			if (!range.empty()) {
+				request.set(http::field::range, range);
+			}
+			if (!ifRange.empty()) {
+				request.set(http::field::if_range, ifRange);
+			}
+
+			return request;
+		}
+
+		/* Reply which isn't file is serialized whole, so its status and headers are checked as text */
+		static auto toText(http::message_generator& response) -> std::string {
+			beast::error_code errorCode;
+			std::string text;
+
+			while (!response.is_done() && !errorCode) {
+				const http::message_generator::const_buffers_type buffers = response.prepare(errorCode);
+				text += beast::buffers_to_string(buffers);
+				response.consume(beast::buffer_bytes(buffers));
+			}
+
+			return text;
+		}
+
+	protected:
+		SyncDictDao mDictDao;
+		std::mutex mDictDaoMutex;
+		HttpDictRequestHandler mHandler;
+	};
+
+	TEST_F(HttpDictDumperTest, parsesSingleRangeTest)
+	{
+		ByteRange range = parseByteRange("bytes=0-499", FILE_SIZE_TEST);
+		EXPECT_TRUE(range.partial);
+		EXPECT_EQ(range.offset, 0u);
+		EXPECT_EQ(range.size, 500u);
+
+		range = parseByteRange("bytes=500-", FILE_SIZE_TEST);
+		EXPECT_TRUE(range.partial);
+		EXPECT_EQ(range.offset, 500u);
+		EXPECT_EQ(range.size, 500u);
+
+		range = parseByteRange("bytes=-100", FILE_SIZE_TEST);
+		EXPECT_TRUE(range.partial);
+		EXPECT_EQ(range.offset, 900u);
+		EXPECT_EQ(range.size, 100u);
+
+		/* last byte past end of file is cut to file */
+		range = parseByteRange("bytes=900-5000", FILE_SIZE_TEST);
+		EXPECT_EQ(range.offset, 900u);
+		EXPECT_EQ(range.size, 100u);
+
+		range = parseByteRange("bytes=-5000", FILE_SIZE_TEST);
+		EXPECT_EQ(range.offset, 0u);
+		EXPECT_EQ(range.size, FILE_SIZE_TEST);
+	}
+
+	TEST_F(HttpDictDumperTest, ignoresUnsupportedRangeTest)
+	{
+		for (const char* const header : { "", "items=0-1", "bytes=0-1,5-6", "bytes=5-1", "bytes=a-b", "bytes=1" }) {
+			const ByteRange range = parseByteRange(header, FILE_SIZE_TEST);
+			EXPECT_FALSE(range.partial) << header;
+			EXPECT_TRUE(range.satisfiable) << header;
+			EXPECT_EQ(range.offset, 0u) << header;
+			EXPECT_EQ(range.size, FILE_SIZE_TEST) << header;
+		}
+	}
+
+	TEST_F(HttpDictDumperTest, rejectsUnsatisfiableRangeTest)
+	{
+		EXPECT_FALSE(parseByteRange("bytes=1000-", FILE_SIZE_TEST).satisfiable);
+		EXPECT_FALSE(parseByteRange("bytes=-0", FILE_SIZE_TEST).satisfiable);
+		EXPECT_FALSE(parseByteRange("bytes=0-", 0).satisfiable);
+	}
+
+	TEST_F(HttpDictDumperTest, wholeDumpTest)
+	{
+		DumpFile dump;
+		ASSERT_EQ(mHandler.handleDumpRequest(makeRequest(), dump), nullptr);
+
+		EXPECT_EQ(dump.response.result(), http::status::ok);
+		EXPECT_EQ(dump.offset, 0u);
+		EXPECT_EQ(dump.size, FILE_SIZE_TEST);
+		EXPECT_EQ(dump.response[http::field::content_length], std::to_string(FILE_SIZE_TEST));
+		EXPECT_EQ(dump.response[http::field::accept_ranges], "bytes");
+		EXPECT_FALSE(dump.response[http::field::etag].empty());
+		EXPECT_EQ(dump.response.find(http::field::content_range), dump.response.end());
+	}
+
+	TEST_F(HttpDictDumperTest, partialDumpTest)
+	{
+		DumpFile dump;
+		ASSERT_EQ(mHandler.handleDumpRequest(makeRequest("bytes=100-199"), dump), nullptr);
+
+		EXPECT_EQ(dump.response.result(), http::status::partial_content);
+		EXPECT_EQ(dump.offset, 100u);
+		EXPECT_EQ(dump.size, 100u);
+		EXPECT_EQ(dump.response[http::field::content_length], "100");
+		EXPECT_EQ(dump.response[http::field::content_range], "bytes 100-199/1000");
+	}
+
+	TEST_F(HttpDictDumperTest, unsatisfiableDumpRangeTest)
+	{
+		DumpFile dump;
+		std::unique_ptr<http::message_generator> response = mHandler.handleDumpRequest(makeRequest("bytes=1000-"), dump);
+		ASSERT_NE(response, nullptr);
+
+		const std::string text = toText(*response);
+		EXPECT_TRUE(text.starts_with("HTTP/1.1 416")) << text;
+		EXPECT_NE(text.find("Content-Range: bytes */1000"), std::string::npos) << text;
+	}
+
+	TEST_F(HttpDictDumperTest, ifRangeTest)
+	{
+		DumpFile wholeDump;
+		ASSERT_EQ(mHandler.handleDumpRequest(makeRequest(), wholeDump), nullptr);
+		const std::string etag(wholeDump.response[http::field::etag]);
+
+		/* range of same dump continues download */
+		DumpFile partialDump;
+		ASSERT_EQ(mHandler.handleDumpRequest(makeRequest("bytes=500-", etag), partialDump), nullptr);
+		EXPECT_EQ(partialDump.response.result(), http::status::partial_content);
+		EXPECT_EQ(partialDump.offset, 500u);
+		EXPECT_EQ(partialDump.size, 500u);
+
+		/* dump was replaced since tag was taken, so whole new one comes instead of range */
+		DumpFile newDump;
+		ASSERT_EQ(mHandler.handleDumpRequest(makeRequest("bytes=500-", "\"0-0\""), newDump), nullptr);
+		EXPECT_EQ(newDump.response.result(), http::status::ok);
+		EXPECT_EQ(newDump.offset, 0u);
+		EXPECT_EQ(newDump.size, FILE_SIZE_TEST);
+	}
+
+	TEST_F(HttpDictDumperTest, missingDumpTest)
+	{
+		std::remove(DUMP_PATH_TEST);
+
+		DumpFile dump;
+		std::unique_ptr<http::message_generator> response = mHandler.handleDumpRequest(makeRequest(), dump);
+		ASSERT_NE(response, nullptr);
+		EXPECT_TRUE(toText(*response).starts_with("HTTP/1.1 404"));
+	}
+}
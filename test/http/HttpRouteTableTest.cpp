@@ -0,0 +1,78 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "http/HttpRouteTable.hpp"
+
+namespace lynx {
+
+	TEST(HttpRouteTableTest, matchesEveryRouteTest)
+	{
+		EXPECT_EQ(matchRoute(http::verb::post, "/post").route, HttpRoute::POST_WORD);
+		EXPECT_EQ(matchRoute(http::verb::post, "/post?x").route, HttpRoute::POST_WORD);
+		EXPECT_EQ(matchRoute(http::verb::put, "/put").route, HttpRoute::PUT_WORD);
+		EXPECT_EQ(matchRoute(http::verb::post, "/post/batch").route, HttpRoute::POST_WORDS);
+		EXPECT_EQ(matchRoute(http::verb::put, "/put/batch").route, HttpRoute::PUT_WORDS);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get").route, HttpRoute::GET_ALL);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get?after=10&limit=5").route, HttpRoute::GET_PAGE);
+		EXPECT_EQ(matchRoute(http::verb::get, "/dump").route, HttpRoute::GET_DUMP);
+
+		for (const HttpRouteEntry& entry : HTTP_ROUTES) {
+			EXPECT_TRUE(std::count(HTTP_ROUTE_BUCKETS.begin(), HTTP_ROUTE_BUCKETS.end(), &entry - HTTP_ROUTES.data()) == 1);
+		}
+	}
+
+	TEST(HttpRouteTableTest, parsesWordIdTest)
+	{
+		HttpRouteMatch match = matchRoute(http::verb::get, "/get/42");
+		EXPECT_EQ(match.route, HttpRoute::GET_WORD);
+		EXPECT_EQ(match.wordId, 42u);
+
+		match = matchRoute(http::verb::delete_, "/delete/18446744073709551615");
+		EXPECT_EQ(match.route, HttpRoute::DELETE_WORD);
+		EXPECT_EQ(match.wordId, 18446744073709551615u);
+
+		match = matchRoute(http::verb::get, "/get/7?fields=name");
+		EXPECT_EQ(match.route, HttpRoute::GET_WORD);
+		EXPECT_EQ(match.wordId, 7u);
+	}
+
+	TEST(HttpRouteTableTest, rejectsUnknownRouteTest)
+	{
+		EXPECT_EQ(matchRoute(http::verb::get, "/post").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::delete_, "/delete/").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get/").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get/{id}").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::delete_, "/delete/{id}").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get/-1").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::delete_, "/delete/abc").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get/18446744073709551616").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/get/1/2").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "").route, HttpRoute::UNKNOWN);
+		EXPECT_EQ(matchRoute(http::verb::get, "/unknown").route, HttpRoute::UNKNOWN);
+	}
+}
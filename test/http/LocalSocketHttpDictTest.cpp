@@ -0,0 +1,91 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include "http/SyncHttpDictServer.hpp"
+#include "concurrency/ThreadUtils.hpp"
+#include "net/NetworkUtils.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "LocalSocketHttpDictTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr const char* const SOCKET_PATH_TEST = "/tmp/lynx_http_dict_test.sock";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	TEST(LocalSocketHttpDictTest, socketFileTest)
+	{
+		SyncHttpDictServer server(HOST_TEST, std::string(SOCKET_PATH_TEST));
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while http server is configured");
+		std::this_thread::sleep_for(500ms);
+		ASSERT_TRUE(server.isStarted());
+
+		net::io_context context;
+		net::local::stream_protocol::socket socket(context);
+		socket.connect(toLocalEndpoint(SOCKET_PATH_TEST));
+
+		/* neither route touches db, so requests check transport and routing over one keep-alive connection */
+		for (const char* const target : { "/dump", "/unknown" }) {
+			http::request<http::empty_body> request{http::verb::get, target, 11};
+			request.set(http::field::host, "localhost");
+			request.keep_alive(true);
+			http::write(socket, request);
+
+			beast::flat_buffer remoteBuffer;
+			http::response<http::string_body> response;
+			http::read(socket, remoteBuffer, response);
+
+			EXPECT_EQ(response.result(), http::status::not_found) << target;
+			EXPECT_TRUE(response.keep_alive()) << target;
+		}
+
+		socket.close();
+
+		/* session thread is detached, it has to see closed connection before server is destroyed */
+		std::this_thread::sleep_for(100ms);
+
+		/* interrupts blocking accept, server thread then leaves start */
+		boost::system::result<void> result = raiseSignal(serverThread.native_handle(), SIGINT);
+		if (result.has_error()) {
+			log::error(TAG, "Can't send signal to http server thread: %s", result.error().message().c_str());
+		}
+
+		serverThread.join();
+	}
+}
@@ -133,6 +133,14 @@ namespace lynx {
 		EXPECT_EQ(result.image.url, WORD_TEST1.image.url);
 		EXPECT_EQ(result.image.width, WORD_TEST1.image.width);
 		EXPECT_EQ(result.image.height, WORD_TEST1.image.height);
+
+		/* same word in protobuf comes from its own cache entry */
+		mClient.setFormat(ContentFormat::PROTOBUF);
+		Word remoteWord = mClient.performGet(WORD_TEST2.id);
+		mClient.setFormat(ContentFormat::JSON);
+
+		EXPECT_EQ(remoteWord.name, result.name);
+		EXPECT_EQ(remoteWord.image.url, result.image.url);
 	}
 
 
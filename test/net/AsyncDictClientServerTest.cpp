@@ -0,0 +1,92 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "net/AsyncDictServer.hpp"
+#include "net/SyncDictClient.hpp"
+
+#include "logging/Logging.hpp"
+#include "common/TestData.hpp"
+
+static constexpr const char* const TAG = "AsyncDictClientServerTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8003;
+static constexpr uint32_t THREAD_COUNT_TEST = 4;
+static constexpr uint32_t CLIENT_COUNT_TEST = 8;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	TEST(AsyncDictClientServerTest, truncateTableTest)
+	{
+		SyncDictDao dao(HOST_TEST);
+		dao.start();
+		dao.truncateTables();
+		dao.stop();
+	}
+
+	TEST(AsyncDictClientServerTest, remoteMultiClientTest)
+	{
+		AsyncDictServer server(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST });
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(1s);
+		EXPECT_TRUE(server.isStarted());
+
+		std::vector<std::thread> clientThreads;
+
+		for (uint32_t i = 0; i < CLIENT_COUNT_TEST; ++i) {
+			clientThreads.emplace_back([]() {
+				SyncDictClient client(HOST_TEST, PORT_TEST);
+
+				client.start();
+				EXPECT_TRUE(client.isStarted());
+
+				client.performInsert(WORD_TEST1);
+				Word result = client.performGetById(WORD_TEST1.id);
+
+				EXPECT_EQ(result.name, WORD_TEST1.name);
+				EXPECT_EQ(result.index, WORD_TEST1.index);
+				EXPECT_EQ(result.type, WORD_TEST1.type);
+
+				client.performQuit();
+				client.stop();
+			});
+		}
+
+		for (std::thread& clientThread : clientThreads) {
+			clientThread.join();
+		}
+
+		server.stop();
+		serverThread.join();
+	}
+}
@@ -0,0 +1,125 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include "net/AsyncDictClient.hpp"
+#include "net/AsyncDictServer.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "AsyncDictClientTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8011;
+static constexpr uint32_t THREAD_COUNT_TEST = 2;
+static constexpr std::size_t REQUEST_COUNT_TEST = 5000;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	TEST(AsyncDictClientTest, notConnectedTest)
+	{
+		net::io_context context;
+		AsyncDictClient client(context, HOST_TEST, PORT_TEST);
+		boost::system::result<Word> remoteWord;
+
+		net::co_spawn(context, [&client, &remoteWord]() -> net::awaitable<void> {
+			remoteWord = co_await client.getById(1);
+		}, net::detached);
+
+		context.run();
+
+		EXPECT_FALSE(client.isStarted());
+		ASSERT_TRUE(remoteWord.has_error());
+		EXPECT_EQ(remoteWord.error(), std::errc::not_connected);
+	}
+
+	/* Pings are answered without touching db, all of them are in flight on one thread at once */
+	TEST(AsyncDictClientTest, concurrentPingTest)
+	{
+		AsyncDictServer server(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST });
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		net::io_context context;
+		AsyncDictClient client(context, HOST_TEST, PORT_TEST);
+
+		std::size_t awaitableCount = 0;
+		std::size_t callbackCount = 0;
+		std::size_t completionCount = 0;
+
+		const auto complete = [&client, &completionCount]() {
+			if (++completionCount == 2 * REQUEST_COUNT_TEST) {
+				client.quit();
+				client.stop();
+			}
+		};
+
+		net::co_spawn(context, [&]() -> net::awaitable<void> {
+			boost::system::result<void> status = co_await client.start();
+			EXPECT_TRUE(status.has_value());
+
+			if (status.has_error()) {
+				co_return;
+			}
+
+			for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+				net::co_spawn(context, [&]() -> net::awaitable<void> {
+					boost::system::result<void> pingStatus = co_await client.ping();
+					awaitableCount += pingStatus.has_value();
+					complete();
+				}, net::detached);
+
+				client.ping([&](std::exception_ptr, boost::system::result<void> pingStatus) {
+					callbackCount += pingStatus.has_value();
+					complete();
+				});
+			}
+		}, net::detached);
+
+		const auto begin = std::chrono::steady_clock::now();
+		context.run();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+
+		log::info(TAG, "Complete %zu pings on one thread in %ld ms", 2 * REQUEST_COUNT_TEST, elapsed.count());
+
+		EXPECT_EQ(awaitableCount, REQUEST_COUNT_TEST);
+		EXPECT_EQ(callbackCount, REQUEST_COUNT_TEST);
+		EXPECT_FALSE(client.isStarted());
+
+		server.stop();
+		serverThread.join();
+	}
+}
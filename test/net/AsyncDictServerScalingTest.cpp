@@ -0,0 +1,123 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+#include "net/AsyncDictServer.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "AsyncDictServerScalingTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8006;
+static constexpr uint32_t CLIENT_COUNT_PER_SHARD_TEST = 2;
+static constexpr std::size_t REQUEST_COUNT_TEST = 2000;
+
+/* Malformed id is answered by server without touching db, so only transport overhead is measured */
+static constexpr const char* const REQUEST_TEST = "GET_BY_IDx\n";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	static void performRequests(std::atomic_size_t& replyCount) {
+		net::io_context context;
+		net::ip::tcp::socket socket(context);
+		std::string remoteBuffer;
+
+		socket.connect({net::ip::address::from_string(HOST_TEST), PORT_TEST});
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			net::write(socket, net::buffer(std::string_view(REQUEST_TEST)));
+			std::size_t replySize = net::read_until(socket, net::dynamic_buffer(remoteBuffer), "\n");
+			remoteBuffer.erase(0, replySize);
+			++replyCount;
+		}
+
+		net::write(socket, net::buffer(QUIT_COMMAND + std::string("\n")));
+	}
+
+	/* Same clients load every server, so only shard count differs between runs */
+	static auto measureThroughput(uint32_t shardCount, uint32_t clientCount) -> double {
+		AsyncDictServer server(HOST_TEST, PORT_TEST, { .threadCount = shardCount, .mode = ReactorMode::SHARDED });
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+		EXPECT_TRUE(server.isStarted());
+
+		std::atomic_size_t replyCount = 0;
+		std::vector<std::thread> clientThreads;
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < clientCount; ++i) {
+			clientThreads.emplace_back(performRequests, std::ref(replyCount));
+		}
+
+		for (std::thread& clientThread : clientThreads) {
+			clientThread.join();
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+		const double throughput = replyCount * 1e6 / std::max<int64_t>(elapsed.count(), 1);
+
+		log::info(TAG, "%u shards: %zu requests in %ld us, %.0f requests/s", shardCount, replyCount.load(), elapsed.count(), throughput);
+		EXPECT_EQ(replyCount, clientCount * REQUEST_COUNT_TEST);
+
+		server.stop();
+		serverThread.join();
+
+		return throughput;
+	}
+
+	TEST(AsyncDictServerScalingTest, shardedThroughputTest)
+	{
+		/* clients need cores of their own, so half of cores serve and half load */
+		const uint32_t maxShardCount = std::min(std::thread::hardware_concurrency() / 2, 4u);
+
+		if (maxShardCount < 2) {
+			GTEST_SKIP() << "Scaling needs at least 4 cores";
+		}
+
+		const uint32_t clientCount = maxShardCount * CLIENT_COUNT_PER_SHARD_TEST;
+		const double singleThroughput = measureThroughput(1, clientCount);
+		const double shardedThroughput = measureThroughput(maxShardCount, clientCount);
+
+		/* wall clock comparison depends on load of machine, so speedup is reported instead of asserted */
+		log::info(TAG, "%u shards serve %.2f times throughput of one shard", maxShardCount,
+				  shardedThroughput / std::max(singleThroughput, 1.0));
+	}
+}
@@ -0,0 +1,113 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "net/AsyncDictServer.hpp"
+#include "net/DictClientPool.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "DictClientPoolTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8007;
+static constexpr uint32_t CLIENT_COUNT_TEST = 4;
+static constexpr uint32_t CALLER_COUNT_TEST = 16;
+static constexpr std::size_t REQUEST_COUNT_TEST = 100;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	/* Ping is answered without touching db, so server works without it */
+	class DictClientPoolTest : public testing::Test {
+	public:
+		DictClientPoolTest()
+			: mServer(HOST_TEST, PORT_TEST, { .threadCount = 2 }) {
+
+			mServerThread = std::thread([this]() {
+				mServer.start();
+			});
+
+			log::debug(TAG, "Wait while server is configured");
+			std::this_thread::sleep_for(500ms);
+		}
+
+		~DictClientPoolTest() {
+			mServer.stop();
+			mServerThread.join();
+		}
+
+	protected:
+		AsyncDictServer mServer;
+		std::thread mServerThread;
+	};
+
+	TEST_F(DictClientPoolTest, concurrentCallersTest)
+	{
+		DictClientPool pool(HOST_TEST, PORT_TEST, { .clientCount = CLIENT_COUNT_TEST });
+		pool.start();
+		EXPECT_TRUE(pool.isStarted());
+
+		std::atomic_size_t successCount = 0;
+		std::vector<std::thread> callerThreads;
+
+		for (uint32_t i = 0; i < CALLER_COUNT_TEST; ++i) {
+			callerThreads.emplace_back([&pool, &successCount]() {
+				for (std::size_t j = 0; j < REQUEST_COUNT_TEST; ++j) {
+					if (pool.acquire()->performPing()) {
+						++successCount;
+					}
+				}
+			});
+		}
+
+		for (std::thread& callerThread : callerThreads) {
+			callerThread.join();
+		}
+
+		EXPECT_EQ(successCount, CALLER_COUNT_TEST * REQUEST_COUNT_TEST);
+		pool.stop();
+	}
+
+	TEST_F(DictClientPoolTest, reconnectBrokenClientTest)
+	{
+		DictClientPool pool(HOST_TEST, PORT_TEST, { .clientCount = 1, .protocol = DictProtocol::BINARY });
+		pool.start();
+
+		{
+			DictClientPool::Lease lease = pool.acquire();
+			lease->performQuit();
+
+			/* server closed connection after quit */
+			EXPECT_FALSE(lease->performPing());
+			EXPECT_FALSE(lease->isStarted());
+		}
+
+		EXPECT_TRUE(pool.acquire()->performPing());
+		pool.stop();
+	}
+}
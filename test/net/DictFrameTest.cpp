@@ -0,0 +1,97 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "net/DictFrame.hpp"
+
+namespace lynx {
+
+	TEST(DictFrameTest, encodeDecodeHeaderTest)
+	{
+		const DictFrameHeader header = {
+			.opcode = DictOpcode::GET_BY_ID,
+			.status = DictStatus::FAILURE,
+			.flags = 0x0102,
+			.requestId = 0xA1B2C3D4,
+			.payloadSize = 1024
+		};
+
+		const auto buffer = encodeFrameHeader(header);
+
+		EXPECT_EQ(buffer[0], static_cast<std::byte>(DictOpcode::GET_BY_ID));
+		EXPECT_EQ(buffer[4], std::byte{0xA1});
+		EXPECT_EQ(buffer[11], std::byte{0x00});
+
+		boost::system::result<DictFrameHeader> result = decodeFrameHeader(buffer);
+
+		ASSERT_TRUE(result.has_value());
+		EXPECT_EQ(result->opcode, header.opcode);
+		EXPECT_EQ(result->status, header.status);
+		EXPECT_EQ(result->flags, header.flags);
+		EXPECT_EQ(result->requestId, header.requestId);
+		EXPECT_EQ(result->payloadSize, header.payloadSize);
+	}
+
+	TEST(DictFrameTest, decodeInvalidHeaderTest)
+	{
+		DictFrameHeader header = {
+			.opcode = DictOpcode::INSERT,
+			.status = DictStatus::SUCCESS,
+			.flags = 0,
+			.requestId = 1,
+			.payloadSize = DICT_FRAME_MAX_PAYLOAD_SIZE + 1
+		};
+
+		EXPECT_TRUE(decodeFrameHeader(encodeFrameHeader(header)).has_error());
+
+		header.payloadSize = 0;
+		auto buffer = encodeFrameHeader(header);
+		buffer[0] = std::byte{0xFF};
+
+		EXPECT_TRUE(decodeFrameHeader(buffer).has_error());
+		EXPECT_TRUE(decodeFrameHeader(std::span(buffer).first(DICT_FRAME_HEADER_SIZE - 1)).has_error());
+	}
+
+	TEST(DictFrameTest, makeErrorFrameTest)
+	{
+		const std::string message = "Db insert word error";
+		const DictFrame frame = makeErrorFrame(DictOpcode::INSERT, 7, message);
+
+		EXPECT_EQ(frame.header.status, DictStatus::FAILURE);
+		EXPECT_EQ(frame.header.requestId, 7u);
+		EXPECT_EQ(frame.header.payloadSize, message.size());
+		EXPECT_EQ(std::string(reinterpret_cast<const char*>(frame.payload.data()), frame.payload.size()), message);
+	}
+
+	TEST(DictFrameTest, makeOversizedFrameTest)
+	{
+		const DictFrame frame = makeFrame(DictOpcode::GET_ALL, 9, std::vector<std::byte>(DICT_FRAME_MAX_PAYLOAD_SIZE + 1));
+
+		EXPECT_EQ(frame.header.status, DictStatus::FAILURE);
+		EXPECT_EQ(frame.header.requestId, 9u);
+		EXPECT_EQ(frame.header.payloadSize, frame.payload.size());
+		EXPECT_LT(frame.payload.size(), DICT_FRAME_MAX_PAYLOAD_SIZE);
+	}
+}
@@ -0,0 +1,127 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+#include "net/AsyncDictServer.hpp"
+#include "net/SyncDictClient.hpp"
+#include "net/linux/EpollDictServer.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "EpollDictServerTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8008;
+static constexpr uint32_t THREAD_COUNT_TEST = 2;
+static constexpr std::size_t REQUEST_COUNT_TEST = 5000;
+
+/* Malformed id is answered by server without touching db, so only transport overhead is measured */
+static constexpr const char* const REQUEST_TEST = "GET_BY_IDx\n";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	template<typename Server>
+	static auto measureRoundTrip(Server& server) -> std::chrono::microseconds {
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		net::io_context context;
+		net::ip::tcp::socket socket(context);
+		std::string remoteBuffer;
+
+		socket.connect({net::ip::address::from_string(HOST_TEST), PORT_TEST});
+		socket.set_option(net::ip::tcp::no_delay(true));
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			net::write(socket, net::buffer(std::string_view(REQUEST_TEST)));
+			std::size_t replySize = net::read_until(socket, net::dynamic_buffer(remoteBuffer), "\n");
+			remoteBuffer.erase(0, replySize);
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+		net::write(socket, net::buffer(QUIT_COMMAND + std::string("\n")));
+
+		server.stop();
+		serverThread.join();
+
+		return elapsed / REQUEST_COUNT_TEST;
+	}
+
+	TEST(EpollDictServerTest, roundTripLatencyTest)
+	{
+		EpollDictServer epollServer(HOST_TEST, PORT_TEST, THREAD_COUNT_TEST);
+		const auto epollLatency = measureRoundTrip(epollServer);
+
+		AsyncDictServer asyncServer(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST });
+		const auto asyncLatency = measureRoundTrip(asyncServer);
+
+		log::info(TAG, "Round trip: epoll %ld us, asio %ld us", epollLatency.count(), asyncLatency.count());
+
+		EXPECT_GE(epollLatency.count(), 0);
+		EXPECT_GE(asyncLatency.count(), 0);
+	}
+
+	TEST(EpollDictServerTest, pingTest)
+	{
+		EpollDictServer server(HOST_TEST, PORT_TEST, THREAD_COUNT_TEST);
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+		ASSERT_TRUE(server.isStarted());
+
+		for (DictProtocol protocol : { DictProtocol::TEXT, DictProtocol::BINARY }) {
+			SyncDictClient client(HOST_TEST, PORT_TEST, protocol);
+			client.start();
+			ASSERT_TRUE(client.isStarted());
+
+			EXPECT_TRUE(client.performPing());
+			EXPECT_TRUE(client.performPing());
+
+			client.performQuit();
+		}
+
+		server.stop();
+		serverThread.join();
+	}
+}
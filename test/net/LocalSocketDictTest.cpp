@@ -0,0 +1,109 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "net/SyncDictClient.hpp"
+#include "net/SyncDictServer.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "LocalSocketDictTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8010;
+static constexpr const char* const SOCKET_PATH_TEST = "/tmp/lynx_dict_test.sock";
+static constexpr const char* const ABSTRACT_SOCKET_TEST = "@lynx_dict_test";
+static constexpr std::size_t REQUEST_COUNT_TEST = 2000;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	/* Ping is answered without touching db, so round trip shows cost of transport only */
+	static auto measureRoundTrip(const std::function<std::unique_ptr<SyncDictServer>()>& createServer,
+								 const std::function<std::unique_ptr<SyncDictClient>()>& createClient) -> std::chrono::nanoseconds {
+		std::thread serverThread([&createServer]() {
+			std::unique_ptr<SyncDictServer> server = createServer();
+			server->start();
+			server->stop();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		std::unique_ptr<SyncDictClient> client = createClient();
+		client->start();
+		EXPECT_TRUE(client->isStarted());
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			EXPECT_TRUE(client->performPing());
+		}
+
+		const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+		client->performQuit();
+		serverThread.join();
+
+		return elapsed / REQUEST_COUNT_TEST;
+	}
+
+	TEST(LocalSocketDictTest, socketFileTest)
+	{
+		const auto latency = measureRoundTrip(
+			[]() { return std::make_unique<SyncDictServer>(HOST_TEST, std::string(SOCKET_PATH_TEST)); },
+			[]() { return std::make_unique<SyncDictClient>(SOCKET_PATH_TEST, DictProtocol::TEXT); });
+
+		log::info(TAG, "Round trip over socket file: %ld ns", latency.count());
+	}
+
+	TEST(LocalSocketDictTest, abstractSocketTest)
+	{
+		const auto latency = measureRoundTrip(
+			[]() { return std::make_unique<SyncDictServer>(HOST_TEST, std::string(ABSTRACT_SOCKET_TEST)); },
+			[]() { return std::make_unique<SyncDictClient>(ABSTRACT_SOCKET_TEST, DictProtocol::BINARY); });
+
+		log::info(TAG, "Round trip over abstract socket: %ld ns", latency.count());
+	}
+
+	TEST(LocalSocketDictTest, loopbackComparisonTest)
+	{
+		const auto tcpLatency = measureRoundTrip(
+			[]() { return std::make_unique<SyncDictServer>(HOST_TEST, PORT_TEST); },
+			[]() { return std::make_unique<SyncDictClient>(HOST_TEST, PORT_TEST, DictProtocol::BINARY); });
+
+		const auto localLatency = measureRoundTrip(
+			[]() { return std::make_unique<SyncDictServer>(HOST_TEST, std::string(ABSTRACT_SOCKET_TEST)); },
+			[]() { return std::make_unique<SyncDictClient>(ABSTRACT_SOCKET_TEST, DictProtocol::BINARY); });
+
+		log::info(TAG, "Round trip: tcp loopback %ld ns, unix socket %ld ns", tcpLatency.count(), localLatency.count());
+
+		EXPECT_GT(tcpLatency.count(), 0);
+		EXPECT_GT(localLatency.count(), 0);
+	}
+}
@@ -0,0 +1,92 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "net/AsyncDictServer.hpp"
+#include "net/PipelinedDictClient.hpp"
+
+#include "logging/Logging.hpp"
+#include "common/TestData.hpp"
+
+static constexpr const char* const TAG = "PipelinedDictClientServerTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8005;
+static constexpr uint32_t THREAD_COUNT_TEST = 4;
+static constexpr std::size_t PIPELINE_DEPTH_TEST = 64;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	TEST(PipelinedDictClientServerTest, truncateTableTest)
+	{
+		SyncDictDao dao(HOST_TEST);
+		dao.start();
+		dao.truncateTables();
+		dao.stop();
+	}
+
+	TEST(PipelinedDictClientServerTest, remotePipelinedRequestsTest)
+	{
+		AsyncDictServer server(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST });
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(1s);
+
+		PipelinedDictClient client(HOST_TEST, PORT_TEST);
+		client.start();
+		EXPECT_TRUE(client.isStarted());
+
+		EXPECT_TRUE(client.performInsert(WORD_TEST1).get().has_value());
+		EXPECT_TRUE(client.performInsert(WORD_TEST2).get().has_value());
+
+		std::vector<std::future<boost::system::result<Word>>> results;
+
+		for (std::size_t i = 0; i < PIPELINE_DEPTH_TEST; ++i) {
+			results.push_back(client.performGetById(i % 2 == 0 ? WORD_TEST1.id : WORD_TEST2.id));
+		}
+
+		for (std::size_t i = 0; i < PIPELINE_DEPTH_TEST; ++i) {
+			boost::system::result<Word> result = results[i].get();
+			const Word& expected = (i % 2 == 0) ? WORD_TEST1 : WORD_TEST2;
+
+			ASSERT_TRUE(result.has_value());
+			EXPECT_EQ(result->name, expected.name);
+			EXPECT_EQ(result->index, expected.index);
+			EXPECT_EQ(result->type, expected.type);
+		}
+
+		client.performQuit();
+		client.stop();
+
+		server.stop();
+		serverThread.join();
+	}
+}
@@ -0,0 +1,155 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "net/NetworkUtils.hpp"
+#include "common/DictCommand.hpp"
+#include "common/TestData.hpp"
+#include "format/XmlParser.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "ReceivePathBenchmarkTest";
+static constexpr std::size_t REQUEST_COUNT_TEST = 10000;
+
+/* Allocations are counted only inside measured sections, replacement is global, so benchmark has own binary */
+static std::atomic_bool gCountAllocations = false;
+static std::atomic_size_t gAllocationCount = 0;
+static std::atomic_size_t gAllocatedSize = 0;
+
+void* operator new(std::size_t size) {
+	if (gCountAllocations.load(std::memory_order_relaxed)) {
+		gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		gAllocatedSize.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	if (void* pointer = std::malloc(size != 0 ? size : 1)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+namespace lynx {
+
+	struct AllocationStats final {
+		double count;
+		double size;
+	};
+
+	template<typename Function>
+	static auto measureAllocations(Function&& function) -> AllocationStats {
+		gAllocationCount = 0;
+		gAllocatedSize = 0;
+		gCountAllocations = true;
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			function();
+		}
+
+		gCountAllocations = false;
+
+		return AllocationStats {
+			.count = static_cast<double>(gAllocationCount) / REQUEST_COUNT_TEST,
+			.size = static_cast<double>(gAllocatedSize) / REQUEST_COUNT_TEST
+		};
+	}
+
+	class ReceivePathBenchmarkTest : public testing::Test {
+	public:
+		ReceivePathBenchmarkTest() {
+			mMessage = GET_BY_ID_COMMAND + *XmlParser().serializeToText(WORD_TEST1);
+		}
+
+	protected:
+		void receive(boost::asio::streambuf& remoteBuffer) {
+			remoteBuffer.consume(remoteBuffer.size());
+			std::memcpy(remoteBuffer.prepare(mMessage.size()).data(), mMessage.data(), mMessage.size());
+			remoteBuffer.commit(mMessage.size());
+		}
+
+		std::string mMessage;
+	};
+
+	TEST_F(ReceivePathBenchmarkTest, receiveMessageTest)
+	{
+		boost::asio::streambuf remoteBuffer;
+		std::size_t parsedSize = 0;
+
+		receive(remoteBuffer);
+
+		const AllocationStats copyStats = measureAllocations([&]() {
+			receive(remoteBuffer);
+			std::string remoteData = toString(remoteBuffer);
+			std::string rawRemoteData = remoteData.substr(std::strlen(GET_BY_ID_COMMAND));
+			parsedSize += rawRemoteData.size();
+		});
+
+		const AllocationStats viewStats = measureAllocations([&]() {
+			receive(remoteBuffer);
+			const std::string_view remoteData = toStringView(remoteBuffer);
+			const std::string_view rawRemoteData = remoteData.substr(std::strlen(GET_BY_ID_COMMAND));
+			parsedSize += rawRemoteData.size();
+		});
+
+		log::info(TAG, "Copy receive: %.1f allocations, %.0f bytes per request", copyStats.count, copyStats.size);
+		log::info(TAG, "View receive: %.1f allocations, %.0f bytes per request", viewStats.count, viewStats.size);
+
+		EXPECT_EQ(parsedSize, 2 * REQUEST_COUNT_TEST * (mMessage.size() - std::strlen(GET_BY_ID_COMMAND)));
+		EXPECT_EQ(viewStats.count, 0);
+		EXPECT_LT(viewStats.count, copyStats.count);
+	}
+
+	TEST_F(ReceivePathBenchmarkTest, deserializeMessageTest)
+	{
+		XmlParser parser;
+		const std::string_view remoteData = std::string_view(mMessage).substr(std::strlen(GET_BY_ID_COMMAND));
+
+		const AllocationStats copyStats = measureAllocations([&]() {
+			const std::string rawRemoteData(remoteData);
+			EXPECT_TRUE(parser.deserializeFromText(rawRemoteData).has_value());
+		});
+
+		const AllocationStats viewStats = measureAllocations([&]() {
+			EXPECT_TRUE(parser.deserializeFromText(remoteData).has_value());
+		});
+
+		log::info(TAG, "Copy deserialize: %.1f allocations, %.0f bytes per request", copyStats.count, copyStats.size);
+		log::info(TAG, "View deserialize: %.1f allocations, %.0f bytes per request", viewStats.count, viewStats.size);
+
+		EXPECT_LT(viewStats.size, copyStats.size);
+	}
+}
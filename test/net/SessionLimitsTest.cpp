@@ -0,0 +1,106 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include "net/SyncDictServer.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "SessionLimitsTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8012;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	/* Server serves one client, so its start returns as soon as session is closed by limit */
+	static auto measureSession(const SessionLimits& limits, const std::string& localData) -> std::chrono::milliseconds {
+		SyncDictServer server(HOST_TEST, PORT_TEST, limits);
+
+		std::thread serverThread([&server]() {
+			server.start();
+			server.stop();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		net::io_context context;
+		net::ip::tcp::socket socket(context);
+		boost::system::error_code errorCode;
+
+		socket.connect(net::ip::tcp::endpoint(net::ip::address::from_string(HOST_TEST), PORT_TEST), errorCode);
+		EXPECT_FALSE(errorCode);
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		if (!localData.empty()) {
+			net::write(socket, net::buffer(localData), errorCode);
+		}
+
+		/* session ends without reply, so read returns only when server closes connection,
+		 * close with unread data of client in server buffer is seen as reset */
+		std::string remoteData;
+		net::read(socket, net::dynamic_buffer(remoteData), errorCode);
+		EXPECT_TRUE(errorCode == net::error::eof || errorCode == net::error::connection_reset) << errorCode.message();
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+		serverThread.join();
+
+		return elapsed;
+	}
+
+	TEST(SessionLimitsTest, idleTimeoutTest)
+	{
+		const auto elapsed = measureSession({ .idleTimeout = 200ms }, {});
+		log::info(TAG, "Idle session is closed after %ld ms", elapsed.count());
+
+		EXPECT_GE(elapsed, 150ms);
+		EXPECT_LT(elapsed, 5s);
+	}
+
+	TEST(SessionLimitsTest, readTimeoutTest)
+	{
+		/* message is started but never completed */
+		const auto elapsed = measureSession({ .idleTimeout = 10s, .readTimeout = 200ms }, "GET_BY_ID 1");
+		log::info(TAG, "Stuck message is dropped after %ld ms", elapsed.count());
+
+		EXPECT_GE(elapsed, 150ms);
+		EXPECT_LT(elapsed, 5s);
+	}
+
+	TEST(SessionLimitsTest, maxMessageSizeTest)
+	{
+		const auto elapsed = measureSession({ .maxMessageSize = 1024 }, std::string(4096, 'x'));
+		log::info(TAG, "Oversized message closes session after %ld ms", elapsed.count());
+
+		EXPECT_LT(elapsed, 5s);
+	}
+}
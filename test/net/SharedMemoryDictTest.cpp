@@ -0,0 +1,151 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "net/SyncDictClient.hpp"
+#include "net/SyncDictServer.hpp"
+#include "net/linux/SharedMemoryDictClient.hpp"
+#include "net/linux/SharedMemoryDictServer.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "SharedMemoryDictTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr const char* const SHARED_MEMORY_SOCKET_TEST = "@lynx_shm_test";
+static constexpr const char* const LOCAL_SOCKET_TEST = "@lynx_shm_local_test";
+static constexpr std::size_t REQUEST_COUNT_TEST = 20000;
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	template<typename Client>
+	static auto measurePing(Client& client) -> std::chrono::nanoseconds {
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			EXPECT_TRUE(client.performPing());
+		}
+
+		return (std::chrono::steady_clock::now() - begin) / REQUEST_COUNT_TEST;
+	}
+
+	TEST(SharedMemoryDictTest, ringTest)
+	{
+		constexpr uint32_t capacity = 4096;
+
+		std::vector<std::byte> memory(SharedMemoryRing::getRequiredSize(capacity));
+		SharedMemoryRing::initialize(memory.data(), capacity);
+		SharedMemoryRing ring(memory.data(), capacity);
+
+		/* enough frames to wrap around ring several times */
+		for (uint32_t i = 1; i <= 100; ++i) {
+			const DictFrame localFrame = makeFrame(DictOpcode::PING, i, std::vector<std::byte>(i * 7, std::byte(i)));
+			ASSERT_TRUE(ring.write(localFrame, 10ms).has_value());
+
+			boost::system::result<DictFrame> remoteFrame = ring.read(10ms);
+			ASSERT_TRUE(remoteFrame.has_value());
+			EXPECT_EQ(remoteFrame->header.requestId, i);
+			EXPECT_EQ(remoteFrame->payload, localFrame.payload);
+		}
+
+		EXPECT_EQ(ring.read(10ms).error(), std::errc::timed_out);
+		EXPECT_EQ(ring.write(makeFrame(DictOpcode::PING, 0, std::vector<std::byte>(capacity)), 10ms).error(), std::errc::message_size);
+	}
+
+	TEST(SharedMemoryDictTest, corruptedRingTest)
+	{
+		constexpr uint32_t capacity = 4096;
+
+		/* peer claims bigger ring than ours and publishes frame which doesn't fit into it */
+		std::vector<std::byte> memory(SharedMemoryRing::getRequiredSize(2 * capacity));
+		SharedMemoryRing::initialize(memory.data(), 2 * capacity);
+		SharedMemoryRing remoteRing(memory.data(), 2 * capacity);
+		SharedMemoryRing localRing(memory.data(), capacity);
+
+		ASSERT_TRUE(remoteRing.write(makeFrame(DictOpcode::PING, 1, std::vector<std::byte>(capacity + 1)), 10ms).has_value());
+		EXPECT_EQ(localRing.read(10ms).error(), std::errc::protocol_error);
+
+		EXPECT_EQ(SharedMemoryRing::getCapacityFor(memory.size()), 2 * capacity);
+		EXPECT_EQ(SharedMemoryRing::getCapacityFor(memory.size() - 1), 0);
+	}
+
+	TEST(SharedMemoryDictTest, pingTest)
+	{
+		SharedMemoryDictServer server(HOST_TEST, SHARED_MEMORY_SOCKET_TEST);
+		std::thread serverThread([&server]() { server.start(); });
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		SharedMemoryDictClient client(SHARED_MEMORY_SOCKET_TEST);
+		client.start();
+		ASSERT_TRUE(client.isStarted());
+		EXPECT_TRUE(client.performPing());
+
+		client.performQuit();
+		server.stop();
+		serverThread.join();
+	}
+
+	TEST(SharedMemoryDictTest, localSocketComparisonTest)
+	{
+		SyncDictServer localServer(HOST_TEST, std::string(LOCAL_SOCKET_TEST));
+		std::thread localServerThread([&localServer]() {
+			localServer.start();
+			localServer.stop();
+		});
+
+		SharedMemoryDictServer sharedMemoryServer(HOST_TEST, SHARED_MEMORY_SOCKET_TEST);
+		std::thread sharedMemoryServerThread([&sharedMemoryServer]() { sharedMemoryServer.start(); });
+
+		log::debug(TAG, "Wait while servers are configured");
+		std::this_thread::sleep_for(500ms);
+
+		SyncDictClient localClient(LOCAL_SOCKET_TEST, DictProtocol::BINARY);
+		localClient.start();
+		ASSERT_TRUE(localClient.isStarted());
+
+		SharedMemoryDictClient sharedMemoryClient(SHARED_MEMORY_SOCKET_TEST);
+		sharedMemoryClient.start();
+		ASSERT_TRUE(sharedMemoryClient.isStarted());
+
+		const auto localLatency = measurePing(localClient);
+		const auto sharedMemoryLatency = measurePing(sharedMemoryClient);
+
+		log::info(TAG, "Round trip: unix socket %ld ns, shared memory %ld ns", localLatency.count(), sharedMemoryLatency.count());
+
+		localClient.performQuit();
+		sharedMemoryClient.performQuit();
+
+		localServerThread.join();
+		sharedMemoryServer.stop();
+		sharedMemoryServerThread.join();
+
+		EXPECT_GT(localLatency.count(), 0);
+		EXPECT_GT(sharedMemoryLatency.count(), 0);
+	}
+}
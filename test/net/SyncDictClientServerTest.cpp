@@ -173,5 +173,72 @@ namespace lynx {
 		serverThread.join();
 		clientThread.join();
 	}
-}
 
+	TEST(SyncDictClientServerTest, remoteBinaryProtocolTest)
+	{
+		std::thread serverThread([](){
+			SyncDictServer server(HOST_TEST, PORT_TEST);
+			server.start();
+			server.stop();
+		});
+
+		std::thread clientThread([](){
+			SyncDictClient client(HOST_TEST, PORT_TEST, DictProtocol::BINARY);
+
+			client.start();
+			EXPECT_TRUE(client.isStarted());
+
+			client.performInsert(WORD_TEST1);
+			Word result = client.performGetById(WORD_TEST1.id);
+
+			EXPECT_EQ(result.name, WORD_TEST1.name);
+			EXPECT_EQ(result.index, WORD_TEST1.index);
+			EXPECT_EQ(result.type, WORD_TEST1.type);
+			EXPECT_EQ(result.image.url, WORD_TEST1.image.url);
+			EXPECT_EQ(result.image.width, WORD_TEST1.image.width);
+			EXPECT_EQ(result.image.height, WORD_TEST1.image.height);
+
+			std::vector<Word> results = client.performGetAll();
+			EXPECT_FALSE(results.empty());
+
+			client.performQuit();
+			client.stop();
+		});
+
+		serverThread.join();
+		clientThread.join();
+	}
+
+	TEST(SyncDictClientServerTest, remoteStreamGetAllTest)
+	{
+		std::thread serverThread([](){
+			SyncDictServer server(HOST_TEST, PORT_TEST);
+			server.start();
+			server.stop();
+		});
+
+		std::thread clientThread([](){
+			SyncDictClient client(HOST_TEST, PORT_TEST, DictProtocol::BINARY);
+
+			client.start();
+			EXPECT_TRUE(client.isStarted());
+
+			const std::vector<Word> words = client.performGetAll();
+			std::size_t streamedCount = 0;
+
+			boost::system::result<void> status = client.performGetAll([&streamedCount](std::vector<Word>&& chunk) {
+				EXPECT_LE(chunk.size(), DICT_STREAM_CHUNK_SIZE);
+				streamedCount += chunk.size();
+			});
+
+			EXPECT_TRUE(status.has_value());
+			EXPECT_EQ(streamedCount, words.size());
+
+			client.performQuit();
+			client.stop();
+		});
+
+		serverThread.join();
+		clientThread.join();
+	}
+}
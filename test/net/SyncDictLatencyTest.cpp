@@ -0,0 +1,133 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+#include "net/SyncDictServer.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "SyncDictLatencyTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8004;
+static constexpr std::size_t REQUEST_COUNT_TEST = 1000;
+static constexpr std::size_t PIPELINE_DEPTH_TEST = 100;
+
+/* Server used to sleep this long after every command, reply within it shows that loop is driven by readiness */
+static constexpr std::chrono::milliseconds POLL_INTERVAL_TEST(500);
+
+/* Malformed id is answered by server without touching db, so only transport overhead is measured */
+static constexpr const char* const REQUEST_TEST = "GET_BY_IDx\n";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	class SyncDictLatencyTest : public testing::Test {
+	public:
+		SyncDictLatencyTest()
+			: mSocket(mContext) {
+
+			mServerThread = std::make_unique<std::thread>([]() {
+				SyncDictServer server(HOST_TEST, PORT_TEST);
+				server.start();
+				server.stop();
+			});
+
+			log::debug(TAG, "Wait while server is configured");
+			std::this_thread::sleep_for(500ms);
+
+			mSocket.connect({net::ip::address::from_string(HOST_TEST), PORT_TEST});
+		}
+
+		~SyncDictLatencyTest() {
+			net::write(mSocket, net::buffer(QUIT_COMMAND + std::string("\n")));
+			mServerThread->join();
+		}
+
+	protected:
+		net::io_context mContext;
+		net::ip::tcp::socket mSocket;
+		std::string mRemoteBuffer;
+
+		std::unique_ptr<std::thread> mServerThread;
+	};
+
+	TEST_F(SyncDictLatencyTest, requestLatencyTest)
+	{
+		std::vector<std::chrono::nanoseconds> latencies;
+		latencies.reserve(REQUEST_COUNT_TEST);
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; ++i) {
+			const auto begin = std::chrono::steady_clock::now();
+
+			net::write(mSocket, net::buffer(std::string_view(REQUEST_TEST)));
+			std::size_t replySize = net::read_until(mSocket, net::dynamic_buffer(mRemoteBuffer), "\n");
+			mRemoteBuffer.erase(0, replySize);
+
+			latencies.push_back(std::chrono::steady_clock::now() - begin);
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+
+		const auto median = std::chrono::duration_cast<std::chrono::microseconds>(latencies[latencies.size() / 2]);
+		const auto p99 = std::chrono::duration_cast<std::chrono::microseconds>(latencies[latencies.size() * 99 / 100]);
+
+		log::info(TAG, "Request latency: median %ld us, p99 %ld us", median.count(), p99.count());
+
+		EXPECT_LT(median, POLL_INTERVAL_TEST);
+	}
+
+	TEST_F(SyncDictLatencyTest, pipelinedRequestsTest)
+	{
+		std::string requests;
+
+		for (std::size_t i = 0; i < PIPELINE_DEPTH_TEST; ++i) {
+			requests += REQUEST_TEST;
+		}
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		net::write(mSocket, net::buffer(requests));
+
+		for (std::size_t i = 0; i < PIPELINE_DEPTH_TEST; ++i) {
+			std::size_t replySize = net::read_until(mSocket, net::dynamic_buffer(mRemoteBuffer), "\n");
+			mRemoteBuffer.erase(0, replySize);
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+		log::info(TAG, "Pipelined %zu requests in %ld us", PIPELINE_DEPTH_TEST, elapsed.count());
+
+		/* polling server needed one interval per request, so whole pipeline fits in one interval only without polling */
+		EXPECT_LT(elapsed, POLL_INTERVAL_TEST);
+	}
+}
@@ -0,0 +1,160 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+#include "net/AsyncDictServer.hpp"
+#include "net/SyncDictClient.hpp"
+#include "net/linux/EpollDictServer.hpp"
+#include "net/linux/UringDictServer.hpp"
+#include "common/DictCommand.hpp"
+#include "logging/Logging.hpp"
+
+static constexpr const char* const TAG = "UringDictServerTest";
+static constexpr const char* const HOST_TEST = "127.0.0.1";
+static constexpr uint16_t PORT_TEST = 8009;
+static constexpr uint32_t THREAD_COUNT_TEST = 2;
+static constexpr uint32_t CLIENT_COUNT_TEST = 8;
+static constexpr std::size_t REQUEST_COUNT_TEST = 2000;
+static constexpr std::size_t PIPELINE_DEPTH_TEST = 16;
+
+/* Malformed id is answered by server without touching db, so only transport overhead is measured */
+static constexpr const char* const REQUEST_TEST = "GET_BY_IDx\n";
+
+using namespace std::chrono_literals;
+
+namespace lynx {
+
+	/* Every client keeps PIPELINE_DEPTH_TEST requests in flight, so servers see batches as well as single requests */
+	static void performRequests(std::atomic_size_t& replyCount) {
+		net::io_context context;
+		net::ip::tcp::socket socket(context);
+		std::string localBuffer;
+		std::string remoteBuffer;
+
+		socket.connect({net::ip::address::from_string(HOST_TEST), PORT_TEST});
+		socket.set_option(net::ip::tcp::no_delay(true));
+
+		for (std::size_t i = 0; i < PIPELINE_DEPTH_TEST; ++i) {
+			localBuffer.append(REQUEST_TEST);
+		}
+
+		for (std::size_t i = 0; i < REQUEST_COUNT_TEST; i += PIPELINE_DEPTH_TEST) {
+			net::write(socket, net::buffer(localBuffer));
+
+			for (std::size_t j = 0; j < PIPELINE_DEPTH_TEST; ++j) {
+				std::size_t replySize = net::read_until(socket, net::dynamic_buffer(remoteBuffer), "\n");
+				remoteBuffer.erase(0, replySize);
+				++replyCount;
+			}
+		}
+
+		net::write(socket, net::buffer(QUIT_COMMAND + std::string("\n")));
+	}
+
+	template<typename Server>
+	static auto measureThroughput(Server& server) -> double {
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+
+		std::atomic_size_t replyCount = 0;
+		std::vector<std::thread> clientThreads;
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < CLIENT_COUNT_TEST; ++i) {
+			clientThreads.emplace_back(performRequests, std::ref(replyCount));
+		}
+
+		for (std::thread& clientThread : clientThreads) {
+			clientThread.join();
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+		server.stop();
+		serverThread.join();
+
+		EXPECT_EQ(replyCount, CLIENT_COUNT_TEST * ((REQUEST_COUNT_TEST + PIPELINE_DEPTH_TEST - 1) / PIPELINE_DEPTH_TEST) * PIPELINE_DEPTH_TEST);
+		return replyCount * 1e6 / std::max<int64_t>(elapsed.count(), 1);
+	}
+
+	TEST(UringDictServerTest, loopbackBenchmarkTest)
+	{
+		AsyncDictServer asyncServer(HOST_TEST, PORT_TEST, { .threadCount = THREAD_COUNT_TEST, .mode = ReactorMode::SHARDED });
+		const double asyncThroughput = measureThroughput(asyncServer);
+
+		EpollDictServer epollServer(HOST_TEST, PORT_TEST, THREAD_COUNT_TEST);
+		const double epollThroughput = measureThroughput(epollServer);
+
+		UringDictServer uringServer(HOST_TEST, PORT_TEST, THREAD_COUNT_TEST);
+		const double uringThroughput = measureThroughput(uringServer);
+
+		log::info(TAG, "Requests/s: asio %.0f, epoll %.0f, %s %.0f", asyncThroughput, epollThroughput,
+				uringServer.isFallback() ? "io_uring (epoll fallback)" : "io_uring", uringThroughput);
+
+		EXPECT_GT(asyncThroughput, 0);
+		EXPECT_GT(epollThroughput, 0);
+		EXPECT_GT(uringThroughput, 0);
+	}
+
+	TEST(UringDictServerTest, pingTest)
+	{
+		UringDictServer server(HOST_TEST, PORT_TEST, THREAD_COUNT_TEST);
+
+		std::thread serverThread([&server]() {
+			server.start();
+		});
+
+		log::debug(TAG, "Wait while server is configured");
+		std::this_thread::sleep_for(500ms);
+		ASSERT_TRUE(server.isStarted());
+
+		for (DictProtocol protocol : { DictProtocol::TEXT, DictProtocol::BINARY }) {
+			SyncDictClient client(HOST_TEST, PORT_TEST, protocol);
+			client.start();
+			ASSERT_TRUE(client.isStarted());
+
+			EXPECT_TRUE(client.performPing());
+			EXPECT_TRUE(client.performPing());
+
+			client.performQuit();
+		}
+
+		server.stop();
+		serverThread.join();
+	}
+}
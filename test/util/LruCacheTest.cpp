@@ -0,0 +1,96 @@
+/*
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * Copyright (c) 2022-2023 https://github.com/klappdev
+ *
+ * Permission is hereby  granted, free of charge, to any  person obtaining a copy
+ * of this software and associated  documentation files (the "Software"), to deal
+ * in the Software  without restriction, including without  limitation the rights
+ * to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+ * copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+ * IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+ * FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+ * AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "util/LruCache.hpp"
+
+namespace lynx {
+
+	TEST(LruCacheTest, getReturnsStoredValueTest)
+	{
+		LruCache<uint64_t, std::string> cache(2);
+		cache.put(1, "katze");
+
+		EXPECT_EQ(cache.get(1), "katze");
+		EXPECT_EQ(cache.get(2), std::nullopt);
+	}
+
+	TEST(LruCacheTest, putReplacesExistingValueTest)
+	{
+		LruCache<uint64_t, std::string> cache(2);
+		cache.put(1, "katze");
+		cache.put(1, "hund");
+
+		EXPECT_EQ(cache.getSize(), 1u);
+		EXPECT_EQ(cache.get(1), "hund");
+	}
+
+	TEST(LruCacheTest, evictsLeastRecentlyUsedTest)
+	{
+		LruCache<uint64_t, std::string> cache(2);
+		cache.put(1, "katze");
+		cache.put(2, "hund");
+		cache.get(1);
+		cache.put(3, "maus");
+
+		EXPECT_EQ(cache.getSize(), 2u);
+		EXPECT_EQ(cache.get(1), "katze");
+		EXPECT_EQ(cache.get(2), std::nullopt);
+		EXPECT_EQ(cache.get(3), "maus");
+	}
+
+	TEST(LruCacheTest, eraseRemovesValueTest)
+	{
+		LruCache<uint64_t, std::string> cache(2);
+		cache.put(1, "katze");
+		cache.erase(1);
+		cache.erase(2);
+
+		EXPECT_EQ(cache.getSize(), 0u);
+		EXPECT_EQ(cache.get(1), std::nullopt);
+	}
+
+	TEST(LruCacheTest, zeroCapacityStoresNothingTest)
+	{
+		LruCache<uint64_t, std::string> cache(0);
+		cache.put(1, "katze");
+
+		EXPECT_EQ(cache.get(1), std::nullopt);
+	}
+
+	TEST(LruCacheTest, evictedValueOutlivesCacheTest)
+	{
+		LruCache<uint64_t, std::shared_ptr<const std::string>> cache(1);
+		cache.put(1, std::make_shared<const std::string>("katze"));
+		std::shared_ptr<const std::string> value = cache.get(1).value_or(nullptr);
+		cache.put(2, std::make_shared<const std::string>("hund"));
+
+		ASSERT_NE(value, nullptr);
+		EXPECT_EQ(*value, "katze");
+	}
+}